@@ -20,9 +20,18 @@
 #include "hal_i2c.h"
 #include <string.h>
 #include <logging/log.h>
+#include "libutil.h"
 
 LOG_MODULE_REGISTER(dev_eeprom);
 
+/* Callers of eeprom_write() wait for the last write cycle themselves unless the platform opts
+ * in to ACK polling. Pages inside one split write are always polled. */
+#ifdef ENABLE_EEPROM_WRITE_CYCLE_POLL
+#define EEPROM_WRITE_POLL_LAST_CYCLE true
+#else
+#define EEPROM_WRITE_POLL_LAST_CYCLE false
+#endif
+
 bool eeprom_mux_check(EEPROM_ENTRY *entry)
 {
 	if (entry == NULL) {
@@ -55,23 +64,50 @@ static bool eeprom_one_btye_addr_check(uint8_t dev_type)
 	return ret;
 }
 
-bool eeprom_write(EEPROM_ENTRY *entry)
+static uint16_t eeprom_page_size(uint8_t dev_type)
 {
-	if (entry == NULL) {
-		LOG_DBG("entry pointer passed in as NULL");
-		return false;
+	uint16_t page_size = EEPROM_PAGE_SIZE;
+
+	switch (dev_type) {
+	case NV_ATMEL_24C02:
+		page_size = 8;
+		break;
 	}
+
+	// one page is sent in one EEPROM_ENTRY
+	return MIN(page_size, EEPROM_WRITE_SIZE);
+}
+
+/* The device doesn't ACK its address until the internal write cycle is done */
+static bool eeprom_wait_write_cycle(EEPROM_ENTRY *entry)
+{
+	I2C_MSG msg;
+	int64_t deadline = k_uptime_get() + EEPROM_WRITE_CYCLE_TIMEOUT_MS;
+
+	do {
+		memset(&msg, 0, sizeof(msg));
+		msg.bus = entry->config.port;
+		msg.target_addr = entry->config.target_addr;
+		msg.tx_len = 0;
+		msg.rx_len = 1;
+		if (i2c_master_read_without_error_log(&msg, 0) == 0)
+			return true;
+
+		k_usleep(500);
+	} while (k_uptime_get() < deadline);
+
+	LOG_ERR("EEPROM on bus %d addr 0x%x write cycle timeout", entry->config.port,
+		entry->config.target_addr);
+	return false;
+}
+
+static bool eeprom_write_page(EEPROM_ENTRY *entry, uint16_t offset, const uint8_t *data,
+			      uint16_t len)
+{
 	I2C_MSG msg;
 	uint8_t retry = 5;
 	uint8_t i;
 
-	if (entry->config.bus_mutex) {
-		if (k_mutex_lock(entry->config.bus_mutex, K_MSEC(1000))) {
-			LOG_ERR("Failed to lock mutex on bus %d", entry->config.port);
-			return false;
-		}
-	}
-
 	for (i = 0; i < retry; i++) {
 		/* Check if there have a MUX before EEPROM and access it to change channel first */
 		if (eeprom_mux_check(entry) == false)
@@ -80,29 +116,77 @@ bool eeprom_write(EEPROM_ENTRY *entry)
 		msg.bus = entry->config.port;
 		msg.target_addr = entry->config.target_addr;
 		msg.tx_len = eeprom_one_btye_addr_check(entry->config.dev_type) ?
-				     entry->data_len + 1 : // write 1 byte offset to EEPROM
-				     entry->data_len + 2; // write 2 byte offset to EEPROM
+				     len + 1 : // write 1 byte offset to EEPROM
+				     len + 2; // write 2 byte offset to EEPROM
 		if (eeprom_one_btye_addr_check(entry->config.dev_type)) {
-			msg.data[0] = (entry->config.start_offset + entry->offset) & 0xFF;
-			memcpy(&msg.data[1], &entry->data[0], entry->data_len);
+			msg.data[0] = (entry->config.start_offset + offset) & 0xFF;
+			memcpy(&msg.data[1], data, len);
 		} else {
-			msg.data[0] = ((entry->config.start_offset + entry->offset) >> 8) &
-				      0xFF; // offset msb
-			msg.data[1] =
-				(entry->config.start_offset + entry->offset) & 0xFF; // offset lsb
-			memcpy(&msg.data[2], &entry->data[0], entry->data_len);
+			msg.data[0] =
+				((entry->config.start_offset + offset) >> 8) & 0xFF; // offset msb
+			msg.data[1] = (entry->config.start_offset + offset) & 0xFF; // offset lsb
+			memcpy(&msg.data[2], data, len);
 		}
 
 		if (i2c_master_write(&msg, retry) == 0)
 			break;
 	}
 
+	return (i >= retry) ? false : true;
+}
+
+static bool eeprom_write_entry(EEPROM_ENTRY *entry, bool poll_last_cycle)
+{
+	if (entry == NULL) {
+		LOG_DBG("entry pointer passed in as NULL");
+		return false;
+	}
+
+	if (entry->data_len > EEPROM_WRITE_SIZE) {
+		LOG_ERR("EEPROM write length %d over limit %d", entry->data_len,
+			EEPROM_WRITE_SIZE);
+		return false;
+	}
+
+	if (entry->config.bus_mutex) {
+		if (k_mutex_lock(entry->config.bus_mutex, K_MSEC(1000))) {
+			LOG_ERR("Failed to lock mutex on bus %d", entry->config.port);
+			return false;
+		}
+	}
+
+	/* A write crossing a page boundary wraps around inside the page, split it per page */
+	bool ret = true;
+	uint16_t page_size = eeprom_page_size(entry->config.dev_type);
+	uint16_t done = 0;
+	while (done < entry->data_len) {
+		uint32_t addr = entry->config.start_offset + entry->offset + done;
+		uint16_t len = MIN(entry->data_len - done, page_size - (addr % page_size));
+
+		if (!eeprom_write_page(entry, entry->offset + done, &entry->data[done], len)) {
+			ret = false;
+			break;
+		}
+		done += len;
+
+		if (((done < entry->data_len) || poll_last_cycle) &&
+		    !eeprom_wait_write_cycle(entry)) {
+			ret = false;
+			break;
+		}
+	}
+
 	if (entry->config.bus_mutex) {
 		if (k_mutex_unlock(entry->config.bus_mutex))
 			LOG_ERR("Failed to unlock mutex on bus %d", entry->config.port);
 	}
 
-	return ((i >= retry) ? false : true);
+	return ret;
+}
+
+bool eeprom_write(EEPROM_ENTRY *entry)
+{
+	return eeprom_write_entry(entry, EEPROM_WRITE_POLL_LAST_CYCLE);
 }
 
 bool eeprom_read(EEPROM_ENTRY *entry)
@@ -157,3 +241,257 @@ bool eeprom_read(EEPROM_ENTRY *entry)
 
 	return ((i >= retry) ? false : true);
 }
+
+#ifdef ENABLE_EEPROM_JOURNAL
+/* Flushes do blocking I2C with write cycle polling, keep them off the system workqueue */
+static K_THREAD_STACK_DEFINE(eeprom_journal_work_stack, EEPROM_JOURNAL_WORKQ_STACK_SIZE);
+static struct k_work_q eeprom_journal_work_q;
+static atomic_t eeprom_journal_work_q_started;
+
+static uint16_t eeprom_journal_first_page_addr(const EEPROM_JOURNAL *journal)
+{
+	uint32_t start = journal->config.start_offset + journal->offset;
+	return start - (start % journal->page_size);
+}
+
+/* Journal pages covering len bytes at offset of the region, len must not be 0 */
+static void eeprom_journal_page_range(const EEPROM_JOURNAL *journal, uint16_t offset,
+				      uint16_t len, uint16_t *first, uint16_t *last)
+{
+	uint32_t start = journal->config.start_offset + journal->offset + offset;
+	uint16_t first_page_addr = eeprom_journal_first_page_addr(journal);
+
+	*first = (start - first_page_addr) / journal->page_size;
+	*last = (start + len - 1 - first_page_addr) / journal->page_size;
+}
+
+/* Read len bytes at offset of the region into the image, the journal lock is held */
+static bool eeprom_journal_load(EEPROM_JOURNAL *journal, uint16_t offset, uint16_t len)
+{
+	EEPROM_ENTRY entry;
+	memcpy(&entry.config, &journal->config, sizeof(EEPROM_CFG));
+
+	uint16_t chunk = 0;
+	for (uint16_t done = 0; done < len; done += chunk) {
+		chunk = MIN(len - done, EEPROM_WRITE_SIZE);
+		entry.offset = journal->offset + offset + done;
+		entry.data_len = chunk;
+		if (!eeprom_read(&entry))
+			return false;
+		memcpy(&journal->image[offset + done], entry.data, chunk);
+	}
+
+	return true;
+}
+
+/* Retry loading a page that failed at init, the journal lock is held */
+static bool eeprom_journal_reload_page(EEPROM_JOURNAL *journal, uint16_t page)
+{
+	uint32_t region_start = journal->config.start_offset + journal->offset;
+	uint32_t page_addr = eeprom_journal_first_page_addr(journal) + page * journal->page_size;
+	uint32_t page_start = MAX(page_addr, region_start);
+	uint32_t page_end = MIN(page_addr + journal->page_size, region_start + journal->size);
+
+	if (!eeprom_journal_load(journal, page_start - region_start, page_end - page_start))
+		return false;
+
+	journal->unloaded[page / 32] &= ~BIT(page % 32);
+	return true;
+}
+
+static void eeprom_journal_flush_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	EEPROM_JOURNAL *journal = CONTAINER_OF(dwork, EEPROM_JOURNAL, flush_work);
+
+	if (eeprom_journal_flush(journal)) {
+		k_mutex_lock(&journal->lock, K_FOREVER);
+		journal->flush_retry = 0;
+		k_mutex_unlock(&journal->lock);
+		return;
+	}
+
+	// back off instead of hammering a failing device, the next write re-arms the flush
+	k_mutex_lock(&journal->lock, K_FOREVER);
+	uint8_t retry = journal->flush_retry;
+	if (retry < EEPROM_JOURNAL_FLUSH_RETRY_MAX)
+		journal->flush_retry++;
+	k_mutex_unlock(&journal->lock);
+
+	if (retry >= EEPROM_JOURNAL_FLUSH_RETRY_MAX) {
+		LOG_ERR("EEPROM journal flush still failing after %d retries, stop retrying",
+			EEPROM_JOURNAL_FLUSH_RETRY_MAX);
+		return;
+	}
+
+	k_work_schedule_for_queue(&eeprom_journal_work_q, &journal->flush_work,
+				  K_MSEC(EEPROM_JOURNAL_FLUSH_DELAY_MS << (retry + 1)));
+}
+
+bool eeprom_journal_init(EEPROM_JOURNAL *journal, const EEPROM_CFG *config, uint16_t offset,
+			 uint16_t size, uint8_t *image)
+{
+	CHECK_NULL_ARG_WITH_RETURN(journal, false);
+	CHECK_NULL_ARG_WITH_RETURN(config, false);
+	CHECK_NULL_ARG_WITH_RETURN(image, false);
+
+	memset(journal, 0, sizeof(EEPROM_JOURNAL));
+	memcpy(&journal->config, config, sizeof(EEPROM_CFG));
+	journal->offset = offset;
+	journal->size = size;
+	journal->image = image;
+	journal->page_size = eeprom_page_size(config->dev_type);
+
+	uint32_t end = journal->config.start_offset + offset + size;
+	uint32_t pages = DIV_ROUND_UP(end - eeprom_journal_first_page_addr(journal),
+				      journal->page_size);
+	if (size == 0 || pages > EEPROM_JOURNAL_MAX_PAGES) {
+		LOG_ERR("EEPROM journal size %d over %d pages", size, EEPROM_JOURNAL_MAX_PAGES);
+		journal->image = NULL;
+		return false;
+	}
+
+	k_mutex_init(&journal->lock);
+	k_mutex_init(&journal->flush_lock);
+	k_work_init_delayable(&journal->flush_work, eeprom_journal_flush_handler);
+
+	if (atomic_cas(&eeprom_journal_work_q_started, 0, 1)) {
+		k_work_queue_start(&eeprom_journal_work_q, eeprom_journal_work_stack,
+				   K_THREAD_STACK_SIZEOF(eeprom_journal_work_stack),
+				   CONFIG_MAIN_THREAD_PRIORITY, NULL);
+		k_thread_name_set(&eeprom_journal_work_q.thread, "eeprom_journal_workq");
+	}
+
+	/*
+	 * Load the region, EEPROM_ENTRY reads up to EEPROM_WRITE_SIZE at once. A chunk that fails
+	 * to load keeps the caller's initial image content and its pages are marked unloaded, so
+	 * the initial content is never written back over the records in the EEPROM.
+	 */
+	bool ret = true;
+	uint16_t len = 0;
+	for (uint16_t done = 0; done < size; done += len) {
+		len = MIN(size - done, EEPROM_WRITE_SIZE);
+		if (eeprom_journal_load(journal, done, len))
+			continue;
+
+		LOG_ERR("Failed to load EEPROM journal at 0x%x", offset + done);
+		uint16_t first = 0, last = 0;
+		eeprom_journal_page_range(journal, done, len, &first, &last);
+		for (uint16_t page = first; page <= last; page++)
+			journal->unloaded[page / 32] |= BIT(page % 32);
+		ret = false;
+	}
+
+	return ret;
+}
+
+bool eeprom_journal_write(EEPROM_JOURNAL *journal, uint16_t offset, const uint8_t *data,
+			  uint16_t len)
+{
+	CHECK_NULL_ARG_WITH_RETURN(journal, false);
+	CHECK_NULL_ARG_WITH_RETURN(data, false);
+
+	if (!journal->image) {
+		LOG_ERR("EEPROM journal is not initialized");
+		return false;
+	}
+
+	if ((offset + len) > journal->size) {
+		LOG_ERR("EEPROM journal write 0x%x len %d out of range", offset, len);
+		return false;
+	}
+
+	if (len == 0)
+		return true;
+
+	uint16_t first = 0, last = 0;
+	eeprom_journal_page_range(journal, offset, len, &first, &last);
+
+	k_mutex_lock(&journal->lock, K_FOREVER);
+	// a page that never loaded would write its unknown neighbours back, load it first
+	for (uint16_t page = first; page <= last; page++) {
+		if ((journal->unloaded[page / 32] & BIT(page % 32)) &&
+		    !eeprom_journal_reload_page(journal, page)) {
+			k_mutex_unlock(&journal->lock);
+			LOG_ERR("EEPROM journal page %d is not loaded, drop write 0x%x len %d",
+				page, offset, len);
+			return false;
+		}
+	}
+
+	memcpy(&journal->image[offset], data, len);
+	for (uint16_t page = first; page <= last; page++)
+		journal->dirty[page / 32] |= BIT(page % 32);
+	journal->flush_retry = 0;
+	k_mutex_unlock(&journal->lock);
+
+	// the first write of a burst arms the flush, later ones are coalesced into it
+	k_work_schedule_for_queue(&eeprom_journal_work_q, &journal->flush_work,
+				  K_MSEC(EEPROM_JOURNAL_FLUSH_DELAY_MS));
+
+	return true;
+}
+
+bool eeprom_journal_read(EEPROM_JOURNAL *journal, uint16_t offset, uint8_t *data, uint16_t len)
+{
+	CHECK_NULL_ARG_WITH_RETURN(journal, false);
+	CHECK_NULL_ARG_WITH_RETURN(data, false);
+
+	if (!journal->image || (offset + len) > journal->size)
+		return false;
+
+	k_mutex_lock(&journal->lock, K_FOREVER);
+	memcpy(data, &journal->image[offset], len);
+	k_mutex_unlock(&journal->lock);
+
+	return true;
+}
+
+bool eeprom_journal_flush(EEPROM_JOURNAL *journal)
+{
+	CHECK_NULL_ARG_WITH_RETURN(journal, false);
+
+	if (!journal->image)
+		return false;
+
+	bool ret = true;
+	uint32_t region_start = journal->config.start_offset + journal->offset;
+	uint32_t region_end = region_start + journal->size;
+	uint32_t first_page_addr = eeprom_journal_first_page_addr(journal);
+
+	k_mutex_lock(&journal->flush_lock, K_FOREVER);
+	for (uint16_t page = 0; page < EEPROM_JOURNAL_MAX_PAGES; page++) {
+		uint32_t page_addr = first_page_addr + page * journal->page_size;
+		uint32_t page_start = MAX(page_addr, region_start);
+		uint32_t page_end = MIN(page_addr + journal->page_size, region_end);
+		if (page_start >= region_end)
+			break;
+
+		EEPROM_ENTRY entry;
+		memcpy(&entry.config, &journal->config, sizeof(EEPROM_CFG));
+		entry.offset = page_start - journal->config.start_offset;
+		entry.data_len = page_end - page_start;
+
+		k_mutex_lock(&journal->lock, K_FOREVER);
+		if (!(journal->dirty[page / 32] & BIT(page % 32))) {
+			k_mutex_unlock(&journal->lock);
+			continue;
+		}
+		memcpy(entry.data, &journal->image[page_start - region_start], entry.data_len);
+		journal->dirty[page / 32] &= ~BIT(page % 32);
+		k_mutex_unlock(&journal->lock);
+
+		// dirty pages go out back to back, so each write cycle is polled here
+		if (!eeprom_write_entry(&entry, true)) {
+			LOG_ERR("EEPROM journal flush 0x%x failed", entry.offset);
+			k_mutex_lock(&journal->lock, K_FOREVER);
+			journal->dirty[page / 32] |= BIT(page % 32);
+			k_mutex_unlock(&journal->lock);
+			ret = false;
+		}
+	}
+	k_mutex_unlock(&journal->flush_lock);
+
+	return ret;
+}
+#endif
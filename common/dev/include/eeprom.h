@@ -19,12 +19,42 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <kernel.h>
 #include "plat_def.h"
 
 #ifndef EEPROM_WRITE_SIZE
 #define EEPROM_WRITE_SIZE 0x20
 #endif
 
+// write page size, a 32 bytes split is also aligned for the 64/128 bytes page parts
+#ifndef EEPROM_PAGE_SIZE
+#define EEPROM_PAGE_SIZE 0x20
+#endif
+
+// max internal write cycle time (tWR) while polling the device for ACK, see
+// ENABLE_EEPROM_WRITE_CYCLE_POLL
+#ifndef EEPROM_WRITE_CYCLE_TIMEOUT_MS
+#define EEPROM_WRITE_CYCLE_TIMEOUT_MS 20
+#endif
+
+// journal flushes run on their own workqueue, only built with ENABLE_EEPROM_JOURNAL
+#ifndef EEPROM_JOURNAL_WORKQ_STACK_SIZE
+#define EEPROM_JOURNAL_WORKQ_STACK_SIZE 2048
+#endif
+
+#ifndef EEPROM_JOURNAL_MAX_PAGES
+#define EEPROM_JOURNAL_MAX_PAGES 64
+#endif
+
+#ifndef EEPROM_JOURNAL_FLUSH_DELAY_MS
+#define EEPROM_JOURNAL_FLUSH_DELAY_MS 100
+#endif
+
+// failed background flushes retried with a doubling delay, then left for the next write
+#ifndef EEPROM_JOURNAL_FLUSH_RETRY_MAX
+#define EEPROM_JOURNAL_FLUSH_RETRY_MAX 5
+#endif
+
 // define offset, size and order for EEPROM write/read
 #define FRU_START 0x0000 // start at 0x000
 #define FRU_SIZE 0x0400 // size 1KB
@@ -60,7 +90,33 @@ typedef struct _EEPROM_ENTRY_ {
 	uint8_t data[EEPROM_WRITE_SIZE];
 } EEPROM_ENTRY;
 
+/*
+ * RAM write-back copy of an EEPROM region. Writes only update the image and mark the touched
+ * pages dirty, a delayed work then writes each dirty page once, so a burst of small record
+ * updates costs one page write per page instead of one write cycle per record.
+ */
+typedef struct _EEPROM_JOURNAL_ {
+	EEPROM_CFG config;
+	uint16_t offset; // region start, relative to config.start_offset
+	uint16_t size;
+	uint8_t *image;
+	uint16_t page_size;
+	uint32_t dirty[(EEPROM_JOURNAL_MAX_PAGES + 31) / 32];
+	// pages that failed to load, never written back until a reload succeeds
+	uint32_t unloaded[(EEPROM_JOURNAL_MAX_PAGES + 31) / 32];
+	uint8_t flush_retry;
+	struct k_mutex lock; // protects image, dirty, unloaded and flush_retry
+	struct k_mutex flush_lock; // serializes page writes
+	struct k_work_delayable flush_work;
+} EEPROM_JOURNAL;
+
 bool eeprom_write(EEPROM_ENTRY *entry);
 bool eeprom_read(EEPROM_ENTRY *entry);
+bool eeprom_journal_init(EEPROM_JOURNAL *journal, const EEPROM_CFG *config, uint16_t offset,
+			 uint16_t size, uint8_t *image);
+bool eeprom_journal_write(EEPROM_JOURNAL *journal, uint16_t offset, const uint8_t *data,
+			  uint16_t len);
+bool eeprom_journal_read(EEPROM_JOURNAL *journal, uint16_t offset, uint8_t *data, uint16_t len);
+bool eeprom_journal_flush(EEPROM_JOURNAL *journal);
 
 #endif
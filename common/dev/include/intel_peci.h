@@ -19,6 +19,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "energy_meter.h"
 
 #define RDPKG_IDX_PKG_TEMP 0x02
 #define RDPKG_IDX_DIMM_TEMP 0x0E
@@ -28,6 +29,22 @@
 
 #define PECI_CC_SUCCESS 0x40
 
+/* Both DIMMs of a channel come back in one response, the sibling sensor reuses it */
+#ifndef INTEL_PECI_DIMM_TEMP_CACHE_MS
+#define INTEL_PECI_DIMM_TEMP_CACHE_MS 200
+#endif
+
+/* Averaging window of CPU/DIMM power, by default the time since the previous sample */
+#ifndef INTEL_PECI_POWER_WINDOW_MS
+#define INTEL_PECI_POWER_WINDOW_MS ENERGY_METER_LAST_SAMPLE
+#endif
+
+/* Energy meter counters, keyed together with the CPU PECI address */
+enum INTEL_PECI_ENERGY_COUNTER {
+	INTEL_PECI_ENERGY_CPU_PKG,
+	INTEL_PECI_ENERGY_DIMM_TOTAL,
+};
+
 enum {
 	PECI_UNKNOWN = 0x00,
 	PECI_TEMP_CPU_MARGIN,
@@ -60,6 +77,8 @@ typedef struct {
 	uint8_t power_unit;
 } intel_peci_unit;
 
+bool intel_peci_sample_cpu_energy(uint8_t addr);
+bool intel_peci_sample_dimm_energy(uint8_t addr);
 bool check_dimm_present(uint8_t dimm_channel, uint8_t dimm_num, uint8_t *present_result);
 bool pal_get_power_sku_unit(uint8_t addr);
 bool pal_get_cpu_time(uint8_t addr, uint8_t cmd, uint8_t readlen, uint32_t *run_time);
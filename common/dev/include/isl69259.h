@@ -18,6 +18,7 @@
 
 #include "stdint.h"
 #include "sensor.h"
+#include "vr_fwupdate.h"
 
 #define TWO_COMPLEMENT_NEGATIVE_BIT BIT(15)
 #define ADJUST_IOUT_RANGE 2
@@ -27,6 +28,8 @@ struct isl69259_config {
 	uint32_t len;
 };
 
+extern const vr_fw_update_ops isl69259_vr_update_ops;
+
 bool isl69260_get_vout_max(sensor_cfg *cfg, uint8_t rail, uint16_t *millivolt);
 bool isl69260_get_vout_min(sensor_cfg *cfg, uint8_t rail, uint16_t *millivolt);
 bool isl69260_set_vout_max(sensor_cfg *cfg, uint8_t rail, uint16_t *millivolt);
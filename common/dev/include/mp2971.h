@@ -18,6 +18,7 @@
 
 #include "stdint.h"
 #include "sensor.h"
+#include "util_pmbus.h"
 
 bool mp2971_fwupdate(uint8_t bus, uint8_t addr, uint8_t *img_buff, uint32_t img_size);
 bool mp2971_get_vout_max(sensor_cfg *cfg, uint8_t rail, uint16_t *millivolt);
@@ -41,5 +42,8 @@ bool mp2971_set_ovp2_action_mode(sensor_cfg *cfg, uint8_t rail, uint8_t *mode);
 bool mp2971_get_ovp2_action_mode(sensor_cfg *cfg, uint8_t rail, uint8_t *mode);
 bool mp2971_set_thres_div_en(sensor_cfg *cfg, uint8_t rail, const uint16_t *enable);
 bool mp2971_set_uvp_threshold(sensor_cfg *cfg, uint8_t rail, uint16_t *write_uvp_threshold);
+/* Add the configuration registers a read plan needs for the sensors on page, return the count */
+uint8_t mp2971_add_read_plan_items(sensor_cfg *cfg, uint8_t page, pmbus_read_plan_item *items,
+				   uint8_t max_count);
 
 #endif
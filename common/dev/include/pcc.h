@@ -23,12 +23,23 @@
 #define PCC_BUFFER_LEN 1024
 #define PROCESS_POSTCODE_STACK_SIZE 2048
 
+/* Post codes forwarded to the BMC in one message. The BMC must parse the payload length to take
+ * more than one code, so platforms opt in from plat_def.h once their BMC supports it.
+ */
+#ifndef PCC_POSTCODE_BATCH_MAX
+#define PCC_POSTCODE_BATCH_MAX 1
+#endif
+#ifndef PCC_POSTCODE_FLUSH_MS
+#define PCC_POSTCODE_FLUSH_MS 10
+#endif
+
 uint16_t copy_pcc_read_buffer(uint16_t start, uint16_t length, uint8_t *buffer,
 			      uint16_t buffer_len);
 void pcc_init();
 void reset_pcc_buffer();
 bool get_4byte_postcode_ok();
 void reset_4byte_postcode_ok();
+uint32_t get_pcc_dropped_count(void);
 
 void pcc_platform_filter_init(void);
 bool pcc_platform_filter_postcode(uint32_t postcode);
@@ -18,6 +18,9 @@
 
 #include "stdint.h"
 #include "sensor.h"
+#include "vr_fwupdate.h"
+
+extern const vr_fw_update_ops raa229621_vr_update_ops;
 
 bool raa229621_fwupdate(uint8_t bus, uint8_t addr, uint8_t *img_buff, uint32_t img_size);
 bool raa229621_get_crc(uint8_t bus, uint8_t addr, uint32_t *crc);
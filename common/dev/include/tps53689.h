@@ -16,6 +16,8 @@
 #ifndef TPS53689_H
 #define TPS53689_H
 
+#include "vr_fwupdate.h"
+
 enum TPS536XX_UPDATE_INFO {
 	TPS536XX_UPDATE_INFO_LENS = 74,
 	TPS536XX_UPDATE_INFO_BYTES = 32,
@@ -33,4 +35,6 @@ struct tps_config {
 
 bool tps536xx_get_crc(uint8_t bus, uint8_t addr, uint32_t *crc);
 bool tps536xx_fwupdate(uint8_t bus, uint8_t addr, uint8_t *img_buff, uint32_t img_size);
+
+extern const vr_fw_update_ops tps536xx_vr_update_ops;
 #endif
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VR_FWUPDATE_H
+#define VR_FWUPDATE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define VR_FW_UPDATE_LINE_MAX 128
+
+enum VR_FW_UPDATE_PHASE {
+	VR_FW_UPDATE_PHASE_PARSE,
+	VR_FW_UPDATE_PHASE_WRITE,
+	VR_FW_UPDATE_PHASE_POLL,
+	VR_FW_UPDATE_PHASE_VERIFY,
+	VR_FW_UPDATE_PHASE_MAX,
+};
+
+enum VR_FW_UPDATE_POLL_STATUS {
+	VR_FW_UPDATE_POLL_READY,
+	VR_FW_UPDATE_POLL_BUSY,
+	VR_FW_UPDATE_POLL_ERROR,
+};
+
+typedef struct _vr_fw_update_ctx vr_fw_update_ctx;
+
+/* Streaming update hooks of one VR vendor. parse_chunk receives image bytes in order as they
+ * arrive, checks them and decodes the pages into the vendor state without touching the device.
+ * Once the whole image is received and parsed, program hands each page to
+ * vr_fw_update_write_page(), which calls write_page and then polls with poll_ready. After the
+ * last page the engine waits final_wait_ms, polls until ready and runs verify_crc. */
+typedef struct _vr_fw_update_ops {
+	bool (*begin)(vr_fw_update_ctx *ctx);
+	bool (*parse_chunk)(vr_fw_update_ctx *ctx, const uint8_t *data, uint32_t len);
+	bool (*program)(vr_fw_update_ctx *ctx);
+	bool (*write_page)(vr_fw_update_ctx *ctx, uint16_t page, const uint8_t *data, uint16_t len);
+	uint8_t (*poll_ready)(vr_fw_update_ctx *ctx);
+	bool (*verify_crc)(vr_fw_update_ctx *ctx);
+	void (*end)(vr_fw_update_ctx *ctx);
+	uint16_t page_poll_timeout_ms; // 0: no poll between pages
+	uint16_t final_wait_ms; // minimum programming time the device needs after the last page
+	uint16_t final_poll_timeout_ms; // 0: no poll after the last page, else busy means failure
+} vr_fw_update_ops;
+
+typedef struct _vr_fw_update_entry {
+	const char *keyword; // prefix of the PLDM component version string
+	// Whole image update, used when the vendor has no streaming ops
+	bool (*fwupdate)(uint8_t bus, uint8_t addr, uint8_t *img_buff, uint32_t img_size);
+	const vr_fw_update_ops *ops;
+} vr_fw_update_entry;
+
+struct _vr_fw_update_ctx {
+	const vr_fw_update_entry *entry;
+	uint8_t bus;
+	uint8_t addr;
+	uint32_t image_size;
+	uint32_t next_ofs;
+	uint32_t last_ofs; // offset of the last chunk taken, a re-send of it is ignored
+	uint8_t *img_buff; // whole image, only for vendors without streaming ops
+	char line[VR_FW_UPDATE_LINE_MAX];
+	uint16_t line_len;
+	uint16_t page_count;
+	bool skip_write; // set by the vendor when the device already runs this image
+	bool programming; // page writes are only allowed once the whole image is parsed
+	void *priv; // vendor parse state
+	int64_t start_time;
+	uint32_t phase_ms[VR_FW_UPDATE_PHASE_MAX];
+};
+
+const vr_fw_update_entry *vr_fw_update_find(const vr_fw_update_entry *table, size_t count,
+					    const char *comp_version_str);
+bool vr_fw_update_begin(vr_fw_update_ctx *ctx, const vr_fw_update_entry *entry, uint8_t bus,
+			uint8_t addr, uint32_t image_size);
+bool vr_fw_update_put_chunk(vr_fw_update_ctx *ctx, uint32_t offset, const uint8_t *data,
+			    uint32_t len);
+bool vr_fw_update_end(vr_fw_update_ctx *ctx);
+void vr_fw_update_abort(vr_fw_update_ctx *ctx);
+bool vr_fw_update_is_active(const vr_fw_update_ctx *ctx);
+bool vr_fw_update_is_resend(const vr_fw_update_ctx *ctx, uint32_t offset, uint32_t len);
+
+/* Helpers for vendor streaming ops */
+bool vr_fw_update_write_page(vr_fw_update_ctx *ctx, const uint8_t *data, uint16_t len);
+uint8_t vr_fw_update_wait_ready(vr_fw_update_ctx *ctx, uint32_t timeout_ms);
+bool vr_fw_update_feed_lines(vr_fw_update_ctx *ctx, const uint8_t *data, uint32_t len,
+			     bool (*parse_line)(vr_fw_update_ctx *ctx, const char *line,
+						uint16_t len));
+
+#endif
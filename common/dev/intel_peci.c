@@ -25,6 +25,7 @@
 #include "ipmi.h"
 #include "util_sys.h"
 #include "intel_dimm.h"
+#include "energy_meter.h"
 #include <logging/log.h>
 #include "time.h"
 
@@ -275,17 +276,26 @@ __weak void pal_cal_cpu_power(intel_peci_unit unit_info, uint32_t diff_energy, u
 	*reading = ((float)diff_energy / (float)diff_time) * pwr_scale;
 }
 
+/* Feed the CPU package energy meter, may be called more often than the sensor is read */
+bool intel_peci_sample_cpu_energy(uint8_t addr)
+{
+	uint32_t pkg_energy, run_time;
+
+	if (!pal_get_cpu_energy(addr, &pkg_energy, &run_time)) {
+		LOG_ERR("PECI get cpu energy failed!");
+		return false;
+	}
+
+	return energy_meter_update(addr, INTEL_PECI_ENERGY_CPU_PKG, pkg_energy, run_time);
+}
+
 bool read_cpu_power(uint8_t addr, int *reading)
 {
 	CHECK_NULL_ARG_WITH_RETURN(reading, false);
 
-	bool ret = true;
-	uint32_t pkg_energy, run_time, diff_energy, diff_time;
-	static uint32_t last_pkg_energy = 0, last_run_time = 0;
+	uint32_t diff_energy, diff_time;
 
-	ret = pal_get_cpu_energy(addr, &pkg_energy, &run_time);
-	if (!ret) {
-		LOG_ERR("PECI get cpu energy failed!");
+	if (!intel_peci_sample_cpu_energy(addr)) {
 		return false;
 	}
 
@@ -294,28 +304,13 @@ bool read_cpu_power(uint8_t addr, int *reading)
 		return false;
 	}
 
-	if (last_pkg_energy == 0 &&
-	    last_run_time == 0) { // first read, need second data to calculate
-		last_pkg_energy = pkg_energy;
-		last_run_time = run_time;
+	if (!energy_meter_get_delta(addr, INTEL_PECI_ENERGY_CPU_PKG, INTEL_PECI_POWER_WINDOW_MS,
+				    &diff_energy, &diff_time)) {
+		// first read, need second data to calculate
 		LOG_DBG("CPU power first read");
 		return false;
 	}
 
-	if (pkg_energy >= last_pkg_energy) {
-		diff_energy = pkg_energy - last_pkg_energy;
-	} else {
-		diff_energy = pkg_energy + (0xffffffff - last_pkg_energy + 1);
-	}
-	last_pkg_energy = pkg_energy;
-
-	if (run_time >= last_run_time) {
-		diff_time = run_time - last_run_time;
-	} else {
-		diff_time = run_time + (0xffffffff - last_run_time + 1);
-	}
-	last_run_time = run_time;
-
 	if (diff_time == 0) {
 		LOG_DBG("CPU power time elapsed is zero");
 		return false;
@@ -384,41 +379,37 @@ __weak void pal_cal_total_dimm_power(intel_peci_unit unit_info, uint32_t diff_en
 	*reading = ((float)diff_energy / (float)diff_time) * pwr_scale;
 }
 
-bool read_total_dimm_power(uint8_t addr, int *reading)
+/* Feed the total DIMM energy meter, time base is the BIC uptime in ms */
+bool intel_peci_sample_dimm_energy(uint8_t addr)
 {
-	CHECK_NULL_ARG_WITH_RETURN(reading, false);
+	uint32_t pkg_energy;
 
-	bool ret = true;
-	uint32_t pkg_energy, diff_energy, run_time, diff_time;
-	static uint32_t last_pkg_energy = 0, last_run_time = 0;
+	if (!pal_get_dimm_energy(addr, &pkg_energy)) {
+		LOG_ERR("PECI pal get cpu energy failed!");
+		return false;
+	}
 
-	ret = pal_get_dimm_energy(addr, &pkg_energy);
+	return energy_meter_update(addr, INTEL_PECI_ENERGY_DIMM_TOTAL, pkg_energy,
+				   k_uptime_get_32());
+}
 
-	run_time = k_uptime_get_32();
+bool read_total_dimm_power(uint8_t addr, int *reading)
+{
+	CHECK_NULL_ARG_WITH_RETURN(reading, false);
 
-	if (!ret) {
-		LOG_ERR("PECI pal get cpu energy failed!");
+	uint32_t diff_energy, diff_time;
+
+	if (!intel_peci_sample_dimm_energy(addr)) {
 		return false;
 	}
 
-	if (last_pkg_energy == 0 &&
-	    last_run_time == 0) { // first read, need second data to calculate
-		last_pkg_energy = pkg_energy;
-		last_run_time = run_time;
+	if (!energy_meter_get_delta(addr, INTEL_PECI_ENERGY_DIMM_TOTAL, INTEL_PECI_POWER_WINDOW_MS,
+				    &diff_energy, &diff_time)) {
+		// first read, need second data to calculate
 		LOG_DBG("Total DIMM power first read");
 		return false;
 	}
 
-	if (pkg_energy >= last_pkg_energy) {
-		diff_energy = pkg_energy - last_pkg_energy;
-	} else {
-		diff_energy = pkg_energy + (0xffffffff - last_pkg_energy + 1);
-	}
-	last_pkg_energy = pkg_energy;
-
-	diff_time = run_time - last_run_time;
-	last_run_time = run_time;
-
 	if (diff_time == 0) {
 		LOG_DBG("Total DIMM power time elapsed is zero");
 		return false;
@@ -442,7 +433,8 @@ static bool get_cpu_tjmax(uint8_t addr, int *reading)
 	uint8_t rbuf[rlen];
 	memset(rbuf, 0, sizeof(rbuf));
 
-	int ret = peci_read(PECI_CMD_RD_PKG_CFG0, addr, RDPKG_IDX_TJMAX_TEMP, param, rlen, rbuf);
+	int ret = peci_cached_read(PECI_CMD_RD_PKG_CFG0, addr, RDPKG_IDX_TJMAX_TEMP, param, rlen,
+				   rbuf, PECI_CACHE_FOREVER);
 	if (ret != 0) {
 		LOG_DBG("PECI read error");
 		return false;
@@ -626,7 +618,8 @@ static bool get_dimm_temp(uint8_t addr, uint8_t type, int *reading)
 	uint8_t rbuf[rlen];
 	memset(rbuf, 0, sizeof(rbuf));
 
-	if (peci_read(PECI_CMD_RD_PKG_CFG0, addr, RDPKG_IDX_DIMM_TEMP, param, rlen, rbuf) != 0) {
+	if (peci_cached_read(PECI_CMD_RD_PKG_CFG0, addr, RDPKG_IDX_DIMM_TEMP, param, rlen, rbuf,
+			     INTEL_PECI_DIMM_TEMP_CACHE_MS) != 0) {
 		LOG_ERR("PECI read error");
 		return false;
 	}
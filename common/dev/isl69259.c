@@ -23,6 +23,8 @@
 #include "pmbus.h"
 #include "isl69259.h"
 #include "libutil.h"
+#include "util_pmbus.h"
+#include "vr_fwupdate.h"
 
 LOG_MODULE_REGISTER(isl69259);
 
@@ -51,6 +53,9 @@ LOG_MODULE_REGISTER(isl69259);
 #define VR_RAA_REG_GEN2_REMAIN_WR 0xC2
 #define VR_RAA_REG_GEN2_PROG_STATUS 0x07
 
+// 3 status reads 1 s apart in isl69259_fwupdate()
+#define VR_RAA_PROG_STATUS_TIMEOUT_MS 2000
+
 #define ISL69259_READ_VOUT_RESOLUTION 0.001
 
 #define ISL69260_VOUT_MAX_REG 0x24
@@ -647,6 +652,213 @@ exit:
 	return ret;
 }
 
+struct isl69259_stream_state {
+	raa_config_t dev_info;
+	uint8_t img_mode;
+	bool has_hi; // a high nibble character is pending
+	int8_t hi_val;
+	struct isl69259_config cfg;
+	uint32_t buff_size;
+};
+
+static bool isl69259_stream_begin(vr_fw_update_ctx *ctx)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, false);
+
+	struct isl69259_stream_state *state = calloc(1, sizeof(struct isl69259_stream_state));
+	if (state == NULL) {
+		LOG_ERR("Failed to allocate update state");
+		return false;
+	}
+	ctx->priv = state;
+
+	if (check_dev_support(ctx->bus, ctx->addr, &state->dev_info) == false) {
+		return false;
+	}
+
+	// Only the decoded image is kept, the ASCII image isn't buffered
+	state->buff_size = ctx->image_size / 2;
+	state->cfg.buff = (uint8_t *)malloc(state->buff_size);
+	if (!state->cfg.buff) {
+		LOG_ERR("Failed to malloc cfg.buff");
+		return false;
+	}
+
+	return true;
+}
+
+static void isl69259_stream_end(vr_fw_update_ctx *ctx)
+{
+	CHECK_NULL_ARG(ctx);
+
+	struct isl69259_stream_state *state = (struct isl69259_stream_state *)ctx->priv;
+	if (state != NULL) {
+		SAFE_FREE(state->cfg.buff);
+	}
+	SAFE_FREE(ctx->priv);
+}
+
+/* Streaming counterpart of parsing_image(), characters are paired by their image offset */
+static bool isl69259_stream_parse_chunk(vr_fw_update_ctx *ctx, const uint8_t *data, uint32_t len)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, false);
+	CHECK_NULL_ARG_WITH_RETURN(ctx->priv, false);
+	CHECK_NULL_ARG_WITH_RETURN(data, false);
+
+	struct isl69259_stream_state *state = (struct isl69259_stream_state *)ctx->priv;
+
+	for (uint32_t i = 0; i < len; i++) {
+		if (!state->has_hi) {
+			state->hi_val = ascii_to_val(data[i]);
+			state->has_hi = true;
+			continue;
+		}
+
+		int lo_val = ascii_to_val(data[i]);
+		state->has_hi = false;
+		if (state->hi_val == -1 || lo_val == -1) {
+			continue;
+		}
+
+		if (state->cfg.len >= state->buff_size) {
+			LOG_ERR("Decoded image is larger than %d bytes", state->buff_size);
+			return false;
+		}
+		state->cfg.buff[state->cfg.len++] = state->hi_val * 16 + lo_val;
+	}
+
+	return true;
+}
+
+static bool isl69259_stream_program(vr_fw_update_ctx *ctx)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, false);
+	CHECK_NULL_ARG_WITH_RETURN(ctx->priv, false);
+
+	struct isl69259_stream_state *state = (struct isl69259_stream_state *)ctx->priv;
+	uint8_t mode_check_flag = 0;
+	struct raa_data cmd_line;
+	uint8_t *cur_data = state->cfg.buff;
+	uint32_t img_bin_len = state->cfg.len;
+	uint32_t remain_buf_len = img_bin_len;
+
+	while (remain_buf_len != 0) {
+		/* check remain length should over base length + data length */
+		if ((remain_buf_len < 2) || (remain_buf_len < (2 + *(cur_data + 1)))) {
+			LOG_ERR("Data length not follow spec!");
+			return false;
+		}
+		cmd_line.hdr = *cur_data;
+		cmd_line.len = *(cur_data + 1);
+		if ((cmd_line.len < 3) || (cmd_line.len - 3 > sizeof(cmd_line.raw) - 2)) {
+			LOG_ERR("Invalid VR image line length %d", cmd_line.len);
+			return false;
+		}
+		cmd_line.addr = *(cur_data + 2);
+		cmd_line.cmd = *(cur_data + 3);
+		memcpy(&cmd_line.raw[2], cur_data + 4, cmd_line.len - 3);
+
+		if (cmd_line.hdr == VR_IMG_HDR_SYMBOL) {
+			if (cmd_line.cmd == PMBUS_IC_DEVICE_ID) {
+				if (cmd_line.data[3] != (state->dev_info.devid & 0xFF) &&
+				    cmd_line.data[2] != ((state->dev_info.devid >> 8) & 0xFF) &&
+				    cmd_line.data[1] != ((state->dev_info.devid >> 16) & 0xFF) &&
+				    cmd_line.data[0] != ((state->dev_info.devid >> 24) & 0xFF)) {
+					LOG_ERR("Invalid vr device ID received, update abort!");
+					return false;
+				}
+			} else if (cmd_line.cmd == PMBUS_IC_DEVICE_REV) {
+				if ((cmd_line.data[0] & 0xFF) < VR_RAA_GEN3_SW_REV_MIN)
+					state->img_mode = RAA_GEN3_LEGACY;
+				else
+					state->img_mode = RAA_GEN3_PRODUCTION;
+			} else if (cmd_line.cmd == 0x00)
+				state->img_mode = RAA_GEN2;
+		} else if (cmd_line.hdr == VR_IMG_BODY_SYMBOL) {
+			if (!mode_check_flag) {
+				if (state->img_mode != state->dev_info.mode) {
+					LOG_ERR("Invalid vr device MODE(%d) received, update abort!",
+						state->img_mode);
+					return false;
+				}
+				mode_check_flag = 1;
+			}
+
+			// avoid address and pec bytes
+			if (vr_fw_update_write_page(ctx, &cmd_line.cmd, cmd_line.len - 2) == false) {
+				return false;
+			}
+		} else {
+			LOG_ERR("Invalid VR image symbol 0x%x received, update abort!",
+				cmd_line.hdr);
+			return false;
+		}
+
+		cur_data += (2 + cmd_line.len);
+		remain_buf_len -= (2 + cmd_line.len);
+
+		uint8_t percent = ((img_bin_len - remain_buf_len) * 100) / img_bin_len;
+		if (percent % 10 == 0)
+			LOG_INF("updated: %d%% (bytes: %d/%d)", percent,
+				img_bin_len - remain_buf_len, img_bin_len);
+	}
+
+	return true;
+}
+
+static bool isl69259_stream_write_page(vr_fw_update_ctx *ctx, uint16_t page, const uint8_t *data,
+				       uint16_t len)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, false);
+	CHECK_NULL_ARG_WITH_RETURN(data, false);
+
+	I2C_MSG i2c_msg = { 0 };
+	i2c_msg.bus = ctx->bus;
+	i2c_msg.target_addr = ctx->addr;
+	i2c_msg.tx_len = len;
+	memcpy(i2c_msg.data, data, len);
+
+	uint8_t retry = 3;
+	if (i2c_master_write(&i2c_msg, retry)) {
+		LOG_ERR("Failed to write image line %d, update abort!", page);
+		return false;
+	}
+
+	return true;
+}
+
+static uint8_t isl69259_stream_poll_ready(vr_fw_update_ctx *ctx)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, VR_FW_UPDATE_POLL_ERROR);
+	CHECK_NULL_ARG_WITH_RETURN(ctx->priv, VR_FW_UPDATE_POLL_ERROR);
+
+	const struct isl69259_stream_state *state = (struct isl69259_stream_state *)ctx->priv;
+	uint16_t reg_buff = VR_RAA_REG_PROG_STATUS;
+	uint32_t ret_buff;
+
+	if (state->img_mode == RAA_GEN2) {
+		reg_buff = VR_RAA_REG_GEN2_PROG_STATUS | (VR_RAA_REG_GEN2_PROG_STATUS << 8);
+	}
+
+	if (raa_dma_rd(ctx->bus, ctx->addr, reg_buff, &ret_buff) == false) {
+		LOG_ERR("Failed to read polling status");
+		return VR_FW_UPDATE_POLL_ERROR;
+	}
+
+	// bit1 is held to 1, it means the action is successful
+	return ((ret_buff & 0xFF) & 0x01) ? VR_FW_UPDATE_POLL_READY : VR_FW_UPDATE_POLL_BUSY;
+}
+
+const vr_fw_update_ops isl69259_vr_update_ops = {
+	.begin = isl69259_stream_begin,
+	.parse_chunk = isl69259_stream_parse_chunk,
+	.program = isl69259_stream_program,
+	.write_page = isl69259_stream_write_page,
+	.poll_ready = isl69259_stream_poll_ready,
+	.end = isl69259_stream_end,
+	.final_poll_timeout_ms = VR_RAA_PROG_STATUS_TIMEOUT_MS,
+};
+
 bool isl69260_get_vout_command(sensor_cfg *cfg, uint8_t rail, uint16_t *millivolt)
 {
 	CHECK_NULL_ARG_WITH_RETURN(cfg, false);
@@ -869,15 +1081,24 @@ uint8_t isl69259_read(sensor_cfg *cfg, int *reading)
 	;
 	memset(sval, 0, sizeof(sensor_val));
 
-	msg.bus = cfg->port;
-	msg.target_addr = cfg->target_addr;
-	msg.tx_len = 1;
-	msg.rx_len = 2;
-	msg.data[0] = cfg->offset;
-
-	if (i2c_master_read(&msg, retry)) {
-		/* read fail */
-		return SENSOR_FAIL_TO_ACCESS;
+	/* Sensors in a read plan are served from the plan pass of their device */
+	if (pmbus_read_plan_is_sensor_planned(cfg)) {
+		pmbus_read_plan_item *plan_item = pmbus_read_plan_get_sensor_item(cfg);
+		if (plan_item == NULL) {
+			return SENSOR_FAIL_TO_ACCESS;
+		}
+		memcpy(msg.data, plan_item->data, 2);
+	} else {
+		msg.bus = cfg->port;
+		msg.target_addr = cfg->target_addr;
+		msg.tx_len = 1;
+		msg.rx_len = 2;
+		msg.data[0] = cfg->offset;
+
+		if (i2c_master_read(&msg, retry)) {
+			/* read fail */
+			return SENSOR_FAIL_TO_ACCESS;
+		}
 	}
 
 	uint8_t offset = cfg->offset;
@@ -755,16 +755,13 @@ bool get_vout_scale(const sensor_cfg *cfg, float *vout_scale)
 	return true;
 }
 
+static float get_resolution_by_reso_set(sensor_cfg *cfg, uint8_t page, uint16_t mfr_reso_set,
+					pmbus_read_plan *plan);
+
 float get_resolution(sensor_cfg *cfg)
 {
 	CHECK_NULL_ARG_WITH_RETURN(cfg, SENSOR_FAIL_TO_ACCESS);
 
-	bool vout_scale_enable = false;
-	if (cfg->init_args != NULL) {
-		const mp2971_init_arg *init_arg = (mp2971_init_arg *)cfg->init_args;
-		vout_scale_enable = init_arg->vout_scale_enable;
-	}
-
 	uint8_t page = 0;
 	uint16_t mfr_reso_set = 0;
 
@@ -796,6 +793,31 @@ float get_resolution(sensor_cfg *cfg)
 
 	mfr_reso_set = (msg.data[1] << 8) | msg.data[0];
 
+	return get_resolution_by_reso_set(cfg, page, mfr_reso_set, NULL);
+}
+
+/* Take VOUT_SENSE_SET from the read plan, the device page may not be the sensor page */
+static bool get_vout_scale_by_plan(pmbus_read_plan *plan, uint8_t page, float *vout_scale)
+{
+	pmbus_read_plan_item *item = pmbus_read_plan_get_item(plan, page, MP2971_VOUT_SENSE_SET);
+	if (item == NULL) {
+		return false;
+	}
+
+	uint16_t vout_sense_set = (item->data[1] << 8) | item->data[0];
+	*vout_scale = ((float)(1 << 5)) / ((float)(vout_sense_set & MP2971_VOUT_SCALE_MASK));
+	return true;
+}
+
+static float get_resolution_by_reso_set(sensor_cfg *cfg, uint8_t page, uint16_t mfr_reso_set,
+					pmbus_read_plan *plan)
+{
+	bool vout_scale_enable = false;
+	if (cfg->init_args != NULL) {
+		const mp2971_init_arg *init_arg = (mp2971_init_arg *)cfg->init_args;
+		vout_scale_enable = init_arg->vout_scale_enable;
+	}
+
 	uint8_t vout_reso_set;
 	uint8_t iout_reso_set;
 	uint8_t iin_reso_set;
@@ -888,7 +910,10 @@ float get_resolution(sensor_cfg *cfg)
 	switch (offset) {
 	case PMBUS_READ_VOUT:
 		if (vout_scale_enable == true) {
-			if (get_vout_scale(cfg, &vout_scale) == false) {
+			bool is_scale_valid = (plan != NULL) ?
+						      get_vout_scale_by_plan(plan, page, &vout_scale) :
+						      get_vout_scale(cfg, &vout_scale);
+			if (is_scale_valid == false) {
 				LOG_WRN("get vout scale failed");
 			}
 		}
@@ -906,7 +931,10 @@ float get_resolution(sensor_cfg *cfg)
 		break;
 	case PMBUS_READ_POUT:
 		if (vout_scale_enable == true) {
-			if (get_vout_scale(cfg, &vout_scale) == false) {
+			bool is_scale_valid = (plan != NULL) ?
+						      get_vout_scale_by_plan(plan, page, &vout_scale) :
+						      get_vout_scale(cfg, &vout_scale);
+			if (is_scale_valid == false) {
 				LOG_WRN("get vout scale failed");
 			}
 		}
@@ -1884,6 +1912,53 @@ bool mp2971_get_ovp2_action_mode(sensor_cfg *cfg, uint8_t rail, uint8_t *mode)
 	return true;
 }
 
+static float get_plan_resolution(sensor_cfg *cfg, uint8_t page)
+{
+	pmbus_read_plan *plan = pmbus_read_plan_find(cfg->port, cfg->target_addr);
+	pmbus_read_plan_item *item = pmbus_read_plan_get_item(plan, page, MFR_RESO_SET);
+	if (item == NULL) {
+		LOG_WRN("MFR_RESO_SET of page %d is not in the read plan", page);
+		return 0;
+	}
+
+	return get_resolution_by_reso_set(cfg, page, (item->data[1] << 8) | item->data[0], plan);
+}
+
+uint8_t mp2971_add_read_plan_items(sensor_cfg *cfg, uint8_t page, pmbus_read_plan_item *items,
+				   uint8_t max_count)
+{
+	CHECK_NULL_ARG_WITH_RETURN(cfg, 0);
+	CHECK_NULL_ARG_WITH_RETURN(items, 0);
+
+	bool vout_scale_enable = false;
+	if (cfg->init_args != NULL) {
+		const mp2971_init_arg *init_arg = (mp2971_init_arg *)cfg->init_args;
+		vout_scale_enable = init_arg->vout_scale_enable;
+	}
+
+	uint8_t count = 0;
+	uint8_t need_count = vout_scale_enable ? 2 : 1;
+	if (max_count < need_count) {
+		return 0;
+	}
+
+	/* Configuration registers, resolution and vout scale of every reading on the page */
+	items[count++] = (pmbus_read_plan_item){ .sensor_num = SENSOR_NUM_MAX,
+						 .page = page,
+						 .command = MFR_RESO_SET,
+						 .len = 2,
+						 .is_static = true };
+	if (vout_scale_enable) {
+		items[count++] = (pmbus_read_plan_item){ .sensor_num = SENSOR_NUM_MAX,
+							 .page = page,
+							 .command = MP2971_VOUT_SENSE_SET,
+							 .len = 2,
+							 .is_static = true };
+	}
+
+	return count;
+}
+
 uint8_t mp2971_read(sensor_cfg *cfg, int *reading)
 {
 	CHECK_NULL_ARG_WITH_RETURN(cfg, SENSOR_UNSPECIFIED_ERROR);
@@ -1901,19 +1976,30 @@ uint8_t mp2971_read(sensor_cfg *cfg, int *reading)
 	I2C_MSG msg;
 	memset(sval, 0, sizeof(sensor_val));
 
-	msg.bus = cfg->port;
-	msg.target_addr = cfg->target_addr;
-	msg.tx_len = 1;
-	msg.rx_len = 2;
-	msg.data[0] = cfg->offset;
+	/* Sensors in a read plan are served from the plan pass of their device */
+	pmbus_read_plan_item *plan_item = NULL;
+	if (pmbus_read_plan_is_sensor_planned(cfg)) {
+		plan_item = pmbus_read_plan_get_sensor_item(cfg);
+		if (plan_item == NULL) {
+			return SENSOR_FAIL_TO_ACCESS;
+		}
+		val = (plan_item->data[1] << 8) | plan_item->data[0];
+	} else {
+		msg.bus = cfg->port;
+		msg.target_addr = cfg->target_addr;
+		msg.tx_len = 1;
+		msg.rx_len = 2;
+		msg.data[0] = cfg->offset;
 
-	if (i2c_master_read(&msg, i2c_max_retry)) {
-		/* read fail */
-		return SENSOR_FAIL_TO_ACCESS;
+		if (i2c_master_read(&msg, i2c_max_retry)) {
+			/* read fail */
+			return SENSOR_FAIL_TO_ACCESS;
+		}
+
+		val = (msg.data[1] << 8) | msg.data[0];
 	}
 
 	uint8_t offset = cfg->offset;
-	val = (msg.data[1] << 8) | msg.data[0];
 
 	switch (offset) {
 	case PMBUS_READ_VOUT:
@@ -1943,7 +2029,8 @@ uint8_t mp2971_read(sensor_cfg *cfg, int *reading)
 		break;
 	}
 
-	float resolution = get_resolution(cfg);
+	float resolution = (plan_item != NULL) ? get_plan_resolution(cfg, plan_item->page) :
+						 get_resolution(cfg);
 	if (resolution == 0) {
 		return SENSOR_FAIL_TO_ACCESS;
 	}
@@ -56,6 +56,9 @@ static struct k_thread process_postcode_thread_handler;
 const struct device *pcc_dev;
 static uint32_t pcc_read_buffer[PCC_BUFFER_LEN];
 static uint16_t pcc_read_len = 0, pcc_read_index = 0;
+/* post codes stored since boot, pcc_read_index always equals it modulo PCC_BUFFER_LEN */
+static uint32_t pcc_write_count = 0;
+static uint32_t pcc_dropped_count = 0;
 static bool proc_4byte_postcode_ok = false;
 static struct k_sem get_postcode_sem;
 
@@ -272,8 +275,10 @@ void check_ABL_error(uint32_t postcode)
 }
 
 #ifdef ENABLE_PLDM
-bool pldm_send_post_code_to_bmc(uint16_t send_index)
+bool pldm_send_post_code_to_bmc(const uint32_t *postcode, uint8_t count)
 {
+	CHECK_NULL_ARG_WITH_RETURN(postcode, false);
+
 	pldm_msg msg = { 0 };
 	uint8_t bmc_bus = I2C_BUS_BMC, bmc_interface = BMC_INTERFACE_I2C;
 
@@ -294,29 +299,27 @@ bool pldm_send_post_code_to_bmc(uint16_t send_index)
 	msg.hdr.cmd = PLDM_OEM_WRITE_FILE_IO;
 	msg.hdr.rq = 1;
 
-	struct pldm_oem_write_file_io_req *ptr = (struct pldm_oem_write_file_io_req *)malloc(
-		sizeof(struct pldm_oem_write_file_io_req) + (POST_CODE_SIZE * sizeof(uint8_t)));
-
-	if (ptr == NULL) {
-		LOG_ERR("Memory allocation failed.");
-		return false;
-	}
+	uint8_t req_buf[sizeof(struct pldm_oem_write_file_io_req) +
+			(PCC_POSTCODE_BATCH_MAX * POST_CODE_SIZE)];
+	struct pldm_oem_write_file_io_req *ptr = (struct pldm_oem_write_file_io_req *)req_buf;
 
+	count = MIN(count, PCC_POSTCODE_BATCH_MAX);
 	ptr->cmd_code = POST_CODE;
-	ptr->data_length = POST_CODE_SIZE;
-	ptr->messages[0] = pcc_read_buffer[send_index] & 0xFF;
-	ptr->messages[1] = (pcc_read_buffer[send_index] >> 8) & 0xFF;
-	ptr->messages[2] = (pcc_read_buffer[send_index] >> 16) & 0xFF;
-	ptr->messages[3] = (pcc_read_buffer[send_index] >> 24) & 0xFF;
+	ptr->data_length = count * POST_CODE_SIZE;
+	for (uint8_t i = 0; i < count; i++) {
+		ptr->messages[(i * POST_CODE_SIZE)] = postcode[i] & 0xFF;
+		ptr->messages[(i * POST_CODE_SIZE) + 1] = (postcode[i] >> 8) & 0xFF;
+		ptr->messages[(i * POST_CODE_SIZE) + 2] = (postcode[i] >> 16) & 0xFF;
+		ptr->messages[(i * POST_CODE_SIZE) + 3] = (postcode[i] >> 24) & 0xFF;
+	}
 
 	msg.buf = (uint8_t *)ptr;
-	msg.len = sizeof(struct pldm_oem_write_file_io_req) + POST_CODE_SIZE;
+	msg.len = sizeof(struct pldm_oem_write_file_io_req) + ptr->data_length;
 
 	uint8_t resp_len = sizeof(struct pldm_oem_write_file_io_resp);
 	uint8_t rbuf[resp_len];
 
 	if (!mctp_pldm_read(find_mctp_by_bus(bmc_bus), &msg, rbuf, resp_len)) {
-		SAFE_FREE(ptr);
 		LOG_ERR("mctp_pldm_read fail");
 		return false;
 	}
@@ -326,33 +329,37 @@ bool pldm_send_post_code_to_bmc(uint16_t send_index)
 		LOG_ERR("Check reponse completion code fail %x", resp->completion_code);
 	}
 
-	SAFE_FREE(ptr);
 	return true;
 }
 #endif
 
-bool ipmi_send_post_code_to_bmc(uint16_t send_index)
+bool ipmi_send_post_code_to_bmc(const uint32_t *postcode, uint8_t count)
 {
+	CHECK_NULL_ARG_WITH_RETURN(postcode, false);
+
 	ipmi_msg *msg = (ipmi_msg *)malloc(sizeof(ipmi_msg));
 	if (msg == NULL) {
 		LOG_ERR("Memory allocation failed.");
 		return false;
 	}
 
+	count = MIN(count, PCC_POSTCODE_BATCH_MAX);
 	memset(msg, 0, sizeof(ipmi_msg));
 	msg->InF_source = SELF;
 	msg->InF_target = BMC_IPMB;
 	msg->netfn = NETFN_OEM_1S_REQ;
 	msg->cmd = CMD_OEM_1S_SEND_4BYTE_POST_CODE_TO_BMC;
-	msg->data_len = 8;
+	msg->data_len = 4 + (count * POST_CODE_SIZE);
 	msg->data[0] = IANA_ID & 0xFF;
 	msg->data[1] = (IANA_ID >> 8) & 0xFF;
 	msg->data[2] = (IANA_ID >> 16) & 0xFF;
-	msg->data[3] = POST_CODE_SIZE;
-	msg->data[4] = pcc_read_buffer[send_index] & 0xFF;
-	msg->data[5] = (pcc_read_buffer[send_index] >> 8) & 0xFF;
-	msg->data[6] = (pcc_read_buffer[send_index] >> 16) & 0xFF;
-	msg->data[7] = (pcc_read_buffer[send_index] >> 24) & 0xFF;
+	msg->data[3] = count * POST_CODE_SIZE;
+	for (uint8_t i = 0; i < count; i++) {
+		msg->data[4 + (i * POST_CODE_SIZE)] = postcode[i] & 0xFF;
+		msg->data[5 + (i * POST_CODE_SIZE)] = (postcode[i] >> 8) & 0xFF;
+		msg->data[6 + (i * POST_CODE_SIZE)] = (postcode[i] >> 16) & 0xFF;
+		msg->data[7 + (i * POST_CODE_SIZE)] = (postcode[i] >> 24) & 0xFF;
+	}
 	ipmb_error status = ipmb_read(msg, IPMB_inf_index_map[msg->InF_target]);
 	if (status != IPMB_ERROR_SUCCESS) {
 		SAFE_FREE(msg);
@@ -363,38 +370,71 @@ bool ipmi_send_post_code_to_bmc(uint16_t send_index)
 	return true;
 }
 
-bool send_post_code_to_bmc(uint16_t send_index)
+bool send_post_code_to_bmc(const uint32_t *postcode, uint8_t count)
 {
 #ifdef ENABLE_PLDM
-	return pldm_send_post_code_to_bmc(send_index);
+	return pldm_send_post_code_to_bmc(postcode, count);
 #else
-	return ipmi_send_post_code_to_bmc(send_index);
+	return ipmi_send_post_code_to_bmc(postcode, count);
 #endif
 }
 
 static void process_postcode(void *arvg0, void *arvg1, void *arvg2)
 {
-	uint16_t send_index = 0;
+	uint32_t send_count = 0;
+	uint32_t batch[PCC_POSTCODE_BATCH_MAX];
+
 	while (1) {
 		k_sem_take(&get_postcode_sem, K_FOREVER);
-		uint16_t current_read_index = pcc_read_index;
-		for (; send_index != current_read_index;
-		     send_index = (send_index + 1) % PCC_BUFFER_LEN) {
-			if (((pcc_read_buffer[send_index] >> 16) & BIT_MASK(16)) ==
-			    PSB_POSTCODE_PREFIX) {
-				check_PSB_error(pcc_read_buffer[send_index]);
-			} else if (((pcc_read_buffer[send_index] >> 16) & BIT_MASK(16)) ==
-				   ABL_POSTCODE_PREFIX) {
-				check_ABL_error(pcc_read_buffer[send_index]);
+
+		/* Codes come in bursts, wait a little so one message carries more of them */
+		if ((pcc_write_count - send_count) < PCC_POSTCODE_BATCH_MAX) {
+			k_msleep(PCC_POSTCODE_FLUSH_MS);
+		}
+
+		while (send_count != pcc_write_count) {
+			uint32_t pending = pcc_write_count - send_count;
+			if (pending > PCC_BUFFER_LEN) {
+				/* Ring wrapped over unsent codes, skip to the oldest one left */
+				pcc_dropped_count += pending - PCC_BUFFER_LEN;
+				LOG_WRN("Post code ring overrun, %u codes dropped in total",
+					pcc_dropped_count);
+				send_count += pending - PCC_BUFFER_LEN;
+				continue;
+			}
+
+			uint8_t count = MIN(pending, PCC_POSTCODE_BATCH_MAX);
+			for (uint8_t i = 0; i < count; i++) {
+				batch[i] = pcc_read_buffer[(send_count + i) % PCC_BUFFER_LEN];
 			}
 
-			send_post_code_to_bmc(send_index);
+			/* The copy is only valid if the producer did not lap it meanwhile */
+			if ((pcc_write_count - send_count) > PCC_BUFFER_LEN) {
+				continue;
+			}
+
+			for (uint8_t i = 0; i < count; i++) {
+				if (((batch[i] >> 16) & BIT_MASK(16)) == PSB_POSTCODE_PREFIX) {
+					check_PSB_error(batch[i]);
+				} else if (((batch[i] >> 16) & BIT_MASK(16)) ==
+					   ABL_POSTCODE_PREFIX) {
+					check_ABL_error(batch[i]);
+				}
+			}
+
+			send_post_code_to_bmc(batch, count);
+			send_count += count;
 
 			k_yield();
 		}
 	}
 }
 
+uint32_t get_pcc_dropped_count(void)
+{
+	return pcc_dropped_count;
+}
+
 void pcc_rx_callback(const uint8_t *rb, uint32_t rb_sz, uint32_t st_idx, uint32_t ed_idx)
 {
 	/* The sequence of read data from pcc driver is:
@@ -426,6 +466,7 @@ void pcc_rx_callback(const uint8_t *rb, uint32_t rb_sz, uint32_t st_idx, uint32_
 				if (pcc_read_index == PCC_BUFFER_LEN) {
 					pcc_read_index = 0;
 				}
+				pcc_write_count++;
 			} else {
 				four_byte_data = 0;
 			}
@@ -20,6 +20,9 @@
 #include "sensor.h"
 #include "hal_i2c.h"
 #include "pmbus.h"
+#include "libutil.h"
+#include "raa229621.h"
+#include "vr_fwupdate.h"
 
 #include <logging/log.h>
 
@@ -49,6 +52,9 @@ LOG_MODULE_REGISTER(raa229621);
 
 #define VR_WARN_REMAIN_WR 3
 
+// 3 status reads 1 s apart in raa229621_fwupdate()
+#define VR_RAA_PROG_STATUS_TIMEOUT_MS 2000
+
 #ifdef RAA229621_MAX_CMD_LINE
 #define MAX_CMD_LINE RAA229621_MAX_CMD_LINE
 #else
@@ -494,6 +500,248 @@ exit:
 	return ret;
 }
 
+struct raa229621_stream_state {
+	uint8_t dev_mode;
+	uint32_t devid;
+	struct raa229621_config cfg;
+	// decoded body lines, each one is the write length followed by command and data
+	uint8_t *buff;
+	uint32_t buff_size;
+	uint32_t buff_len;
+};
+
+static bool raa229621_stream_begin(vr_fw_update_ctx *ctx)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, false);
+
+	struct raa229621_stream_state *state = calloc(1, sizeof(struct raa229621_stream_state));
+	if (state == NULL) {
+		LOG_ERR("Failed to allocate update state");
+		return false;
+	}
+	ctx->priv = state;
+
+	uint8_t remain = 0;
+	state->dev_mode = 0xff;
+
+	// check mode
+	if (raa229621_get_hex_mode(ctx->bus, ctx->addr, &state->dev_mode)) {
+		return false;
+	}
+
+	// check remaining writes
+	if (raa229621_get_remaining_wr(ctx->bus, ctx->addr, &remain) < 0) {
+		return false;
+	}
+
+	if (!remain) {
+		LOG_ERR("No remaining writes");
+		return false;
+	}
+	if (remain <= VR_WARN_REMAIN_WR) {
+		LOG_WRN("The remaining writes %d is below the threshold value %d!", remain,
+			VR_WARN_REMAIN_WR);
+	}
+
+	if (get_raa_devid(ctx->bus, ctx->addr, &state->devid) < 0) {
+		return false;
+	}
+
+	// A decoded line is never longer than half of its ASCII form
+	state->buff_size = ctx->image_size / 2;
+	state->buff = malloc(state->buff_size);
+	if (state->buff == NULL) {
+		LOG_ERR("Failed to malloc %d bytes image buffer", state->buff_size);
+		return false;
+	}
+
+	return true;
+}
+
+static void raa229621_stream_end(vr_fw_update_ctx *ctx)
+{
+	CHECK_NULL_ARG(ctx);
+
+	struct raa229621_stream_state *state = (struct raa229621_stream_state *)ctx->priv;
+	if (state != NULL) {
+		SAFE_FREE(state->buff);
+	}
+	SAFE_FREE(ctx->priv);
+}
+
+/* Streaming counterpart of parsing_image(), a line is "49" (header) or "00" (data) followed by
+ * the length, address, command, data and PEC bytes */
+static bool raa229621_parse_line(vr_fw_update_ctx *ctx, const char *line, uint16_t len)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, false);
+	CHECK_NULL_ARG_WITH_RETURN(ctx->priv, false);
+	CHECK_NULL_ARG_WITH_RETURN(line, false);
+
+	struct raa229621_stream_state *state = (struct raa229621_stream_state *)ctx->priv;
+	struct raa229621_config *dev_cfg = &state->cfg;
+	uint8_t byte[VR_FW_UPDATE_LINE_MAX / 2];
+	uint16_t byte_cnt = len / 2;
+
+	if ((len < 8) || (strncmp(line, "49", 2) && strncmp(line, "00", 2))) {
+		return true;
+	}
+
+	for (int i = 0; i < byte_cnt; i++) {
+		if ((ascii_to_val(line[2 * i]) == -1) || (ascii_to_val(line[2 * i + 1]) == -1)) {
+			LOG_ERR("Get invalid image data in line %d", dev_cfg->wr_cnt);
+			return false;
+		}
+		byte[i] = ascii_to_byte((uint8_t *)&line[2 * i]);
+	}
+
+	if (!strncmp(line, "49", 2)) {
+		if (!strncmp(&line[6], "AD", 2) && (byte_cnt >= 4 + VR_RAA_DEV_ID_LEN)) {
+			for (int j = 0; j < VR_RAA_DEV_ID_LEN; j++) {
+				((uint8_t *)&dev_cfg->devid_exp)[j] = byte[3 + VR_RAA_DEV_ID_LEN - j];
+			}
+			dev_cfg->addr = byte[2];
+		} else if (!strncmp(&line[6], "AE", 2) && (byte_cnt >= 4 + VR_RAA_DEV_REV_LEN)) {
+			for (int j = 0; j < VR_RAA_DEV_REV_LEN; j++) {
+				((uint8_t *)&dev_cfg->rev_exp)[j] = byte[4 + j];
+			}
+
+			if ((dev_cfg->rev_exp & 0xFF) < VR_RAA_GEN3_SW_REV_MIN) {
+				dev_cfg->mode = RAA_GEN3_LEGACY;
+			} else {
+				dev_cfg->mode = RAA_GEN3_PRODUCTION;
+			}
+		}
+		return true;
+	}
+
+	if ((byte[1] < 3) || (byte_cnt < byte[1] + 1)) {
+		LOG_ERR("Invalid data length in line %d", dev_cfg->wr_cnt);
+		return false;
+	}
+	uint8_t wr_len = byte[1] - 2;
+
+	switch (dev_cfg->wr_cnt) {
+	case VR_RAA_CFG_ID:
+		// set Configuration ID
+		dev_cfg->cfg_id = byte[4] & 0x0F;
+		break;
+	case VR_RAA_GEN3_LEGACY_CRC:
+		if ((dev_cfg->mode == RAA_GEN3_LEGACY) && (byte_cnt >= 4 + VR_RAA_CHECKSUM_LEN)) {
+			memcpy(&dev_cfg->crc_exp, &byte[4], VR_RAA_CHECKSUM_LEN);
+		}
+		break;
+	case VR_RAA_GEN3_PRODUCTION_CRC:
+		if ((dev_cfg->mode == RAA_GEN3_PRODUCTION) &&
+		    (byte_cnt >= 4 + VR_RAA_CHECKSUM_LEN)) {
+			memcpy(&dev_cfg->crc_exp, &byte[4], VR_RAA_CHECKSUM_LEN);
+		}
+		break;
+	}
+
+	// Nothing is programmed until the whole image is parsed, see raa229621_stream_program()
+	if (state->buff_len + 1 + wr_len > state->buff_size) {
+		LOG_ERR("Decoded image is larger than %d bytes", state->buff_size);
+		return false;
+	}
+	state->buff[state->buff_len++] = wr_len;
+	memcpy(&state->buff[state->buff_len], &byte[3], wr_len);
+	state->buff_len += wr_len;
+	dev_cfg->wr_cnt++;
+
+	return true;
+}
+
+static bool raa229621_stream_parse_chunk(vr_fw_update_ctx *ctx, const uint8_t *data, uint32_t len)
+{
+	return vr_fw_update_feed_lines(ctx, data, len, raa229621_parse_line);
+}
+
+static bool raa229621_stream_program(vr_fw_update_ctx *ctx)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, false);
+	CHECK_NULL_ARG_WITH_RETURN(ctx->priv, false);
+
+	struct raa229621_stream_state *state = (struct raa229621_stream_state *)ctx->priv;
+	struct raa229621_config *dev_cfg = &state->cfg;
+
+	LOG_INF("Configuration CRC: %08X", dev_cfg->crc_exp);
+
+	if (state->devid != dev_cfg->devid_exp) {
+		LOG_ERR("device id 0x%08X mismatch, expect 0x%08X", state->devid,
+			dev_cfg->devid_exp);
+		return false;
+	}
+
+	if (state->dev_mode != dev_cfg->mode) {
+		LOG_ERR("HEX mode %u mismatch, expect %u", state->dev_mode, dev_cfg->mode);
+		return false;
+	}
+
+	uint32_t ofs = 0;
+	for (int i = 0; i < dev_cfg->wr_cnt; i++) {
+		uint8_t wr_len = state->buff[ofs];
+		if (vr_fw_update_write_page(ctx, &state->buff[ofs + 1], wr_len) == false) {
+			return false;
+		}
+		ofs += 1 + wr_len;
+
+		uint8_t percent = ((i + 1) * 100) / dev_cfg->wr_cnt;
+		if (percent % 10 == 0) {
+			LOG_INF("updated: %d%%", percent);
+		}
+	}
+
+	return true;
+}
+
+static bool raa229621_stream_write_page(vr_fw_update_ctx *ctx, uint16_t page, const uint8_t *data,
+					uint16_t len)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, false);
+	CHECK_NULL_ARG_WITH_RETURN(data, false);
+
+	I2C_MSG i2c_msg = { 0 };
+	uint8_t retry = 3;
+	i2c_msg.bus = ctx->bus;
+	i2c_msg.target_addr = ctx->addr;
+	i2c_msg.tx_len = len;
+	memcpy(i2c_msg.data, data, len);
+
+	if (i2c_master_write(&i2c_msg, retry)) {
+		LOG_ERR("Failed to write config data %d to dev: 0x%x", page, ctx->addr);
+		return false;
+	}
+
+	return true;
+}
+
+static uint8_t raa229621_stream_poll_ready(vr_fw_update_ctx *ctx)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, VR_FW_UPDATE_POLL_ERROR);
+
+	uint8_t tbuf[2], rbuf[4];
+	tbuf[0] = VR_RAA_REG_PROG_STATUS;
+	tbuf[1] = 0x00;
+
+	if (raa_dma_rd(ctx->bus, ctx->addr, tbuf, rbuf) < 0) {
+		LOG_ERR("Read polling status failed from dev: 0x%x", ctx->addr);
+		return VR_FW_UPDATE_POLL_ERROR;
+	}
+
+	// bit1 is held to 1, it means the action is successful
+	return (rbuf[0] & 0x01) ? VR_FW_UPDATE_POLL_READY : VR_FW_UPDATE_POLL_BUSY;
+}
+
+const vr_fw_update_ops raa229621_vr_update_ops = {
+	.begin = raa229621_stream_begin,
+	.parse_chunk = raa229621_stream_parse_chunk,
+	.program = raa229621_stream_program,
+	.write_page = raa229621_stream_write_page,
+	.poll_ready = raa229621_stream_poll_ready,
+	.end = raa229621_stream_end,
+	.final_poll_timeout_ms = VR_RAA_PROG_STATUS_TIMEOUT_MS,
+};
+
 uint8_t raa229621_init(sensor_cfg *cfg)
 {
 	CHECK_NULL_ARG_WITH_RETURN(cfg, SENSOR_INIT_UNSPECIFIED_ERROR);
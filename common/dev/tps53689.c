@@ -25,11 +25,15 @@
 #include "pmbus.h"
 #include "util_pmbus.h"
 #include "tps53689.h"
+#include "vr_fwupdate.h"
 
 #define TI_REG_NVM_CHECKSUM 0xF4
 #define TI_REG_USER_NVM_INDEX 0xF5
 #define TI_REG_USER_NVM_EXECUTE 0xF6
 
+#define TPS536XX_DATA_LINE_COUNT (TPS536XX_UPDATE_MAX_DATA_SIZE / TPS536XX_UPDATE_INFO_BYTES)
+#define TPS536XX_NVM_PROGRAM_TIME_MS 100
+
 LOG_MODULE_REGISTER(tps53689);
 
 enum LINE_INDEX {
@@ -241,6 +245,238 @@ bool tps536xx_fwupdate(uint8_t bus, uint8_t addr, uint8_t *img_buff, uint32_t im
 	return true;
 }
 
+struct tps536xx_stream_state {
+	int line;
+	uint16_t data_lines;
+	uint8_t addr;
+	uint8_t crc[2];
+	uint8_t devid[6];
+	uint8_t data[TPS536XX_UPDATE_MAX_DATA_SIZE];
+};
+
+static bool tps536xx_stream_begin(vr_fw_update_ctx *ctx)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, false);
+
+	ctx->priv = calloc(1, sizeof(struct tps536xx_stream_state));
+	if (ctx->priv == NULL) {
+		LOG_ERR("Failed to allocate update state");
+		return false;
+	}
+
+	return true;
+}
+
+static void tps536xx_stream_end(vr_fw_update_ctx *ctx)
+{
+	CHECK_NULL_ARG(ctx);
+
+	SAFE_FREE(ctx->priv);
+}
+
+static bool tps536xx_hex_to_byte(const char *hex, uint8_t *byte)
+{
+	char str[3] = { hex[0], hex[1], '\0' };
+	char *end = NULL;
+
+	*byte = (uint8_t)strtoul(str, &end, 16);
+	return (end == &str[2]);
+}
+
+static bool tps536xx_check_dev_id_line(vr_fw_update_ctx *ctx, struct tps536xx_stream_state *state)
+{
+	for (int index = 0; index < sizeof(tps536c5_dev_id); index++) {
+		if (state->devid[index] != tps536c5_dev_id[index] &&
+		    state->devid[index] != tps53685_dev_id[index]) {
+			LOG_ERR("Failed to update firmware, device ID is not matched!");
+			return false;
+		}
+	}
+
+	if (state->addr != ctx->addr) {
+		LOG_ERR("Failed to update firmware, address is not matched!");
+		return false;
+	}
+
+	uint32_t dev_crc = 0;
+	if (tps536xx_get_crc(ctx->bus, ctx->addr, &dev_crc) == true) {
+		uint32_t img_crc = (state->crc[1] << 8) | state->crc[0];
+		if (dev_crc == img_crc) {
+			LOG_WRN("Skipped update firmware becasue CRC is matched! "
+				"(The revision of image and device is the same.)");
+			ctx->skip_write = true;
+		}
+	}
+
+	return true;
+}
+
+/* Streaming counterpart of tps536xx_parse_image(), see the image format above */
+static bool tps536xx_parse_line(vr_fw_update_ctx *ctx, const char *line, uint16_t len)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, false);
+	CHECK_NULL_ARG_WITH_RETURN(ctx->priv, false);
+	CHECK_NULL_ARG_WITH_RETURN(line, false);
+
+	struct tps536xx_stream_state *state = (struct tps536xx_stream_state *)ctx->priv;
+	uint8_t data[TPS536XX_UPDATE_INFO_BYTES];
+
+	state->line++;
+	if ((state->line == FIRST_LINE) || (state->line >= LAST_LINE)) {
+		// The first and last lines are unused. Ignore them.
+		return true;
+	}
+
+	if ((line[0] != ':') || (len < 1 + HEADER_LEN + DATA_LEN * 2)) {
+		LOG_ERR("Invalid image line %d", state->line);
+		return false;
+	}
+
+	for (int index = 0; index < DATA_LEN; index++) {
+		uint8_t byte = 0;
+		if (tps536xx_hex_to_byte(&line[1 + HEADER_LEN + index * 2], &byte) == false) {
+			LOG_ERR("Invalid hex data in image line %d", state->line);
+			return false;
+		}
+
+		// BYTE 0 ~ 8 in Line 2 must be written as 0xFF when programming (TPS536XX spec)
+		if (state->line == DEV_ID_LINE) {
+			if (index < DEV_REV1_OFFSET) { //Device ID
+				state->devid[index] = byte;
+				byte = 0xFF;
+			} else if (index == DEV_REV1_OFFSET || index == DEV_REV2_OFFSET) {
+				byte = 0xFF;
+			} else if (index == ADDR_OFFSET) {
+				state->addr = byte;
+				byte = 0xFF;
+			} else if (index == CRC1_OFFSET || index == CRC2_OFFSET) {
+				state->crc[index - CRC1_OFFSET] = byte;
+			}
+		}
+
+		data[index] = byte;
+	}
+
+	if (state->line == DEV_ID_LINE) {
+		if (tps536xx_check_dev_id_line(ctx, state) == false) {
+			return false;
+		}
+		if (ctx->skip_write) {
+			return true;
+		}
+	}
+
+	if (state->data_lines >= TPS536XX_DATA_LINE_COUNT) {
+		LOG_ERR("Image has more than %d data lines", TPS536XX_DATA_LINE_COUNT);
+		return false;
+	}
+
+	// Nothing is programmed until the whole image is parsed, see tps536xx_stream_program()
+	memcpy(&state->data[state->data_lines * TPS536XX_UPDATE_INFO_BYTES], data, sizeof(data));
+	state->data_lines++;
+
+	return true;
+}
+
+static bool tps536xx_stream_parse_chunk(vr_fw_update_ctx *ctx, const uint8_t *data, uint32_t len)
+{
+	return vr_fw_update_feed_lines(ctx, data, len, tps536xx_parse_line);
+}
+
+static bool tps536xx_stream_program(vr_fw_update_ctx *ctx)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, false);
+	CHECK_NULL_ARG_WITH_RETURN(ctx->priv, false);
+
+	const struct tps536xx_stream_state *state = (struct tps536xx_stream_state *)ctx->priv;
+
+	if (state->data_lines != TPS536XX_DATA_LINE_COUNT) {
+		LOG_ERR("Image has %d data lines, expected %d", state->data_lines,
+			TPS536XX_DATA_LINE_COUNT);
+		return false;
+	}
+
+	// set USER_NVM_INDEX 00h
+	I2C_MSG msg = { 0 };
+	msg.bus = ctx->bus;
+	msg.target_addr = ctx->addr;
+	msg.tx_len = 2;
+	msg.data[0] = TI_REG_USER_NVM_INDEX;
+	msg.data[1] = 0x00;
+
+	if (i2c_master_write(&msg, 5) != 0) {
+		LOG_ERR("Failed to set USER_NVM_INDEX 00h");
+		return false;
+	}
+
+	for (int index = 0; index < state->data_lines; index++) {
+		if (vr_fw_update_write_page(ctx, &state->data[index * TPS536XX_UPDATE_INFO_BYTES],
+					    TPS536XX_UPDATE_INFO_BYTES) == false) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool tps536xx_stream_write_page(vr_fw_update_ctx *ctx, uint16_t page, const uint8_t *data,
+				       uint16_t len)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, false);
+	CHECK_NULL_ARG_WITH_RETURN(data, false);
+
+	if (len != TPS536XX_UPDATE_INFO_BYTES) {
+		LOG_ERR("Invalid page length %d", len);
+		return false;
+	}
+
+	I2C_MSG msg = { 0 };
+	msg.bus = ctx->bus;
+	msg.target_addr = ctx->addr;
+	msg.tx_len = TPS536XX_UPDATE_INFO_BYTES + 2;
+	msg.data[0] = TI_REG_USER_NVM_EXECUTE;
+	msg.data[1] = TPS536XX_UPDATE_INFO_BYTES;
+	memcpy(&msg.data[2], data, len);
+
+	if (i2c_master_write(&msg, 5) != 0) {
+		LOG_ERR("Failed to program the image. Invalid index: %d", page);
+		return false;
+	}
+
+	return true;
+}
+
+static bool tps536xx_stream_verify_crc(vr_fw_update_ctx *ctx)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, false);
+	CHECK_NULL_ARG_WITH_RETURN(ctx->priv, false);
+
+	const struct tps536xx_stream_state *state = (struct tps536xx_stream_state *)ctx->priv;
+	uint32_t img_crc = (state->crc[1] << 8) | state->crc[0];
+	uint32_t dev_crc = 0;
+
+	/* The datasheet only asks for the NVM programming time after the last write, so the
+	 * checksum is informational and doesn't fail an update the device accepted */
+	if (tps536xx_get_crc(ctx->bus, ctx->addr, &dev_crc) == false) {
+		LOG_WRN("Failed to read back the checksum after programming");
+	} else if (dev_crc != img_crc) {
+		LOG_WRN("Checksum 0x%x after programming doesn't match image 0x%x", dev_crc,
+			img_crc);
+	}
+
+	return true;
+}
+
+const vr_fw_update_ops tps536xx_vr_update_ops = {
+	.begin = tps536xx_stream_begin,
+	.parse_chunk = tps536xx_stream_parse_chunk,
+	.program = tps536xx_stream_program,
+	.write_page = tps536xx_stream_write_page,
+	.verify_crc = tps536xx_stream_verify_crc,
+	.end = tps536xx_stream_end,
+	.final_wait_ms = TPS536XX_NVM_PROGRAM_TIME_MS,
+};
+
 uint8_t tps53689_read(sensor_cfg *cfg, int *reading)
 {
 	CHECK_NULL_ARG_WITH_RETURN(cfg, SENSOR_UNSPECIFIED_ERROR);
@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr.h>
+#include <logging/log.h>
+#include "libutil.h"
+#include "plat_def.h"
+#include "vr_fwupdate.h"
+
+LOG_MODULE_REGISTER(vr_fwupdate);
+
+#ifndef VR_FW_UPDATE_POLL_INTERVAL_MIN_MS
+#define VR_FW_UPDATE_POLL_INTERVAL_MIN_MS 1
+#endif
+
+#ifndef VR_FW_UPDATE_POLL_INTERVAL_MAX_MS
+#define VR_FW_UPDATE_POLL_INTERVAL_MAX_MS 32
+#endif
+
+static uint32_t vr_fw_update_elapsed_ms(int64_t start)
+{
+	return (uint32_t)(k_uptime_get() - start);
+}
+
+const vr_fw_update_entry *vr_fw_update_find(const vr_fw_update_entry *table, size_t count,
+					    const char *comp_version_str)
+{
+	CHECK_NULL_ARG_WITH_RETURN(table, NULL);
+	CHECK_NULL_ARG_WITH_RETURN(comp_version_str, NULL);
+
+	for (size_t i = 0; i < count; i++) {
+		if (!strncmp(comp_version_str, table[i].keyword, strlen(table[i].keyword))) {
+			return &table[i];
+		}
+	}
+
+	return NULL;
+}
+
+bool vr_fw_update_is_active(const vr_fw_update_ctx *ctx)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, false);
+
+	return (ctx->entry != NULL);
+}
+
+bool vr_fw_update_is_resend(const vr_fw_update_ctx *ctx, uint32_t offset, uint32_t len)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, false);
+
+	return (ctx->entry != NULL) && (ctx->next_ofs != 0) && (offset == ctx->last_ofs) &&
+	       (offset + len <= ctx->next_ofs);
+}
+
+bool vr_fw_update_begin(vr_fw_update_ctx *ctx, const vr_fw_update_entry *entry, uint8_t bus,
+			uint8_t addr, uint32_t image_size)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, false);
+	CHECK_NULL_ARG_WITH_RETURN(entry, false);
+
+	memset(ctx, 0, sizeof(*ctx));
+	ctx->entry = entry;
+	ctx->bus = bus;
+	ctx->addr = addr;
+	ctx->image_size = image_size;
+	ctx->start_time = k_uptime_get();
+
+	if (entry->ops == NULL) {
+		ctx->img_buff = malloc(image_size);
+		if (ctx->img_buff == NULL) {
+			LOG_ERR("Failed to malloc %u bytes image buffer", image_size);
+			ctx->entry = NULL;
+			return false;
+		}
+		return true;
+	}
+
+	if (entry->ops->begin && (entry->ops->begin(ctx) == false)) {
+		LOG_ERR("Failed to start %s update", entry->keyword);
+		vr_fw_update_abort(ctx);
+		return false;
+	}
+
+	return true;
+}
+
+bool vr_fw_update_put_chunk(vr_fw_update_ctx *ctx, uint32_t offset, const uint8_t *data,
+			    uint32_t len)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, false);
+	CHECK_NULL_ARG_WITH_RETURN(data, false);
+
+	if (ctx->entry == NULL) {
+		LOG_ERR("VR update is not started");
+		return false;
+	}
+
+	/* A retried RequestFirmwareData hands over the last chunk again, it's already consumed */
+	if (vr_fw_update_is_resend(ctx, offset, len)) {
+		LOG_WRN("Image chunk at offset 0x%x is received again, ignored", offset);
+		return true;
+	}
+
+	/* Streaming parsers consume the image in order, so chunks can't be skipped */
+	if ((offset != ctx->next_ofs) || (offset + len > ctx->image_size)) {
+		LOG_ERR("Unexpected image chunk, offset: 0x%x, length: 0x%x, expected offset: 0x%x",
+			offset, len, ctx->next_ofs);
+		return false;
+	}
+	ctx->last_ofs = offset;
+	ctx->next_ofs += len;
+
+	if (ctx->entry->ops == NULL) {
+		memcpy(ctx->img_buff + offset, data, len);
+		return true;
+	}
+
+	if (ctx->skip_write) {
+		return true;
+	}
+
+	int64_t start = k_uptime_get();
+	bool ret = ctx->entry->ops->parse_chunk(ctx, data, len);
+	ctx->phase_ms[VR_FW_UPDATE_PHASE_PARSE] += vr_fw_update_elapsed_ms(start);
+
+	return ret;
+}
+
+static void vr_fw_update_release(vr_fw_update_ctx *ctx)
+{
+	if ((ctx->entry != NULL) && (ctx->entry->ops != NULL) && ctx->entry->ops->end) {
+		ctx->entry->ops->end(ctx);
+	}
+
+	SAFE_FREE(ctx->img_buff);
+	ctx->entry = NULL;
+}
+
+void vr_fw_update_abort(vr_fw_update_ctx *ctx)
+{
+	CHECK_NULL_ARG(ctx);
+
+	vr_fw_update_release(ctx);
+}
+
+bool vr_fw_update_end(vr_fw_update_ctx *ctx)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, false);
+
+	if (ctx->entry == NULL) {
+		LOG_ERR("VR update is not started");
+		return false;
+	}
+
+	const vr_fw_update_entry *entry = ctx->entry;
+	bool ret = false;
+
+	if (ctx->next_ofs != ctx->image_size) {
+		LOG_ERR("Image is incomplete, received: 0x%x, size: 0x%x", ctx->next_ofs,
+			ctx->image_size);
+		goto exit;
+	}
+
+	if (entry->ops == NULL) {
+		int64_t start = k_uptime_get();
+		ret = entry->fwupdate(ctx->bus, ctx->addr, ctx->img_buff, ctx->image_size);
+		ctx->phase_ms[VR_FW_UPDATE_PHASE_WRITE] += vr_fw_update_elapsed_ms(start);
+		goto exit;
+	}
+
+	// Push out whatever the parser still holds, e.g. a last line without newline
+	if (!ctx->skip_write && (ctx->line_len != 0)) {
+		if (entry->ops->parse_chunk(ctx, (const uint8_t *)"\n", 1) == false) {
+			goto exit;
+		}
+	}
+
+	if (ctx->skip_write) {
+		ret = true;
+		goto exit;
+	}
+
+	if (entry->ops->program) {
+		ctx->programming = true;
+		if (entry->ops->program(ctx) == false) {
+			goto exit;
+		}
+	}
+
+	if (ctx->page_count == 0) {
+		LOG_ERR("No data found in %s image", entry->keyword);
+		goto exit;
+	}
+
+	if (entry->ops->final_wait_ms) {
+		int64_t start = k_uptime_get();
+		k_msleep(entry->ops->final_wait_ms);
+		ctx->phase_ms[VR_FW_UPDATE_PHASE_POLL] += vr_fw_update_elapsed_ms(start);
+	}
+
+	if (entry->ops->poll_ready && entry->ops->final_poll_timeout_ms) {
+		if (vr_fw_update_wait_ready(ctx, entry->ops->final_poll_timeout_ms) !=
+		    VR_FW_UPDATE_POLL_READY) {
+			LOG_ERR("%s isn't ready after programming", entry->keyword);
+			goto exit;
+		}
+	}
+
+	if (entry->ops->verify_crc) {
+		int64_t start = k_uptime_get();
+		ret = entry->ops->verify_crc(ctx);
+		ctx->phase_ms[VR_FW_UPDATE_PHASE_VERIFY] += vr_fw_update_elapsed_ms(start);
+		if (ret == false) {
+			LOG_ERR("%s CRC check failed after programming", entry->keyword);
+		}
+	} else {
+		ret = true;
+	}
+
+exit:
+	LOG_INF("VR %s bus %d addr 0x%x update %s: parse %u ms, write %u ms, poll %u ms, "
+		"verify %u ms, total %u ms",
+		entry->keyword, ctx->bus, ctx->addr,
+		ret ? (ctx->skip_write ? "skipped" : "done") : "failed",
+		ctx->phase_ms[VR_FW_UPDATE_PHASE_PARSE], ctx->phase_ms[VR_FW_UPDATE_PHASE_WRITE],
+		ctx->phase_ms[VR_FW_UPDATE_PHASE_POLL], ctx->phase_ms[VR_FW_UPDATE_PHASE_VERIFY],
+		vr_fw_update_elapsed_ms(ctx->start_time));
+
+	vr_fw_update_release(ctx);
+	return ret;
+}
+
+uint8_t vr_fw_update_wait_ready(vr_fw_update_ctx *ctx, uint32_t timeout_ms)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, VR_FW_UPDATE_POLL_ERROR);
+	CHECK_NULL_ARG_WITH_RETURN(ctx->entry, VR_FW_UPDATE_POLL_ERROR);
+	CHECK_NULL_ARG_WITH_RETURN(ctx->entry->ops, VR_FW_UPDATE_POLL_ERROR);
+
+	if (ctx->entry->ops->poll_ready == NULL) {
+		return VR_FW_UPDATE_POLL_READY;
+	}
+
+	/* Start with a short interval so fast parts aren't held up, then back off so slow
+	 * NVM programming doesn't flood the bus */
+	uint32_t interval_ms = VR_FW_UPDATE_POLL_INTERVAL_MIN_MS;
+	int64_t start = k_uptime_get();
+	uint8_t status = VR_FW_UPDATE_POLL_BUSY;
+
+	while (1) {
+		status = ctx->entry->ops->poll_ready(ctx);
+		if ((status != VR_FW_UPDATE_POLL_BUSY) ||
+		    (vr_fw_update_elapsed_ms(start) >= timeout_ms)) {
+			break;
+		}
+
+		k_msleep(interval_ms);
+		interval_ms = MIN(interval_ms * 2, VR_FW_UPDATE_POLL_INTERVAL_MAX_MS);
+	}
+
+	ctx->phase_ms[VR_FW_UPDATE_PHASE_POLL] += vr_fw_update_elapsed_ms(start);
+	return status;
+}
+
+bool vr_fw_update_write_page(vr_fw_update_ctx *ctx, const uint8_t *data, uint16_t len)
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, false);
+	CHECK_NULL_ARG_WITH_RETURN(data, false);
+	CHECK_NULL_ARG_WITH_RETURN(ctx->entry, false);
+	CHECK_NULL_ARG_WITH_RETURN(ctx->entry->ops, false);
+
+	if (!ctx->programming) {
+		LOG_ERR("%s page written before the image is complete", ctx->entry->keyword);
+		return false;
+	}
+
+	const vr_fw_update_ops *ops = ctx->entry->ops;
+	int64_t start = k_uptime_get();
+
+	bool ret = ops->write_page(ctx, ctx->page_count, data, len);
+	ctx->phase_ms[VR_FW_UPDATE_PHASE_WRITE] += vr_fw_update_elapsed_ms(start);
+	if (ret == false) {
+		LOG_ERR("Failed to write %s page %d", ctx->entry->keyword, ctx->page_count);
+		return false;
+	}
+	ctx->page_count++;
+
+	if (ops->poll_ready && ops->page_poll_timeout_ms) {
+		if (vr_fw_update_wait_ready(ctx, ops->page_poll_timeout_ms) !=
+		    VR_FW_UPDATE_POLL_READY) {
+			LOG_ERR("%s isn't ready after page %d", ctx->entry->keyword,
+				ctx->page_count - 1);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool vr_fw_update_feed_lines(vr_fw_update_ctx *ctx, const uint8_t *data, uint32_t len,
+			     bool (*parse_line)(vr_fw_update_ctx *ctx, const char *line,
+						uint16_t len))
+{
+	CHECK_NULL_ARG_WITH_RETURN(ctx, false);
+	CHECK_NULL_ARG_WITH_RETURN(data, false);
+	CHECK_NULL_ARG_WITH_RETURN(parse_line, false);
+
+	for (uint32_t i = 0; i < len; i++) {
+		char c = (char)data[i];
+
+		if (c == '\r') {
+			continue;
+		}
+
+		if (c != '\n') {
+			if (ctx->line_len >= VR_FW_UPDATE_LINE_MAX - 1) {
+				LOG_ERR("Image line is longer than %d bytes",
+					VR_FW_UPDATE_LINE_MAX - 1);
+				return false;
+			}
+			ctx->line[ctx->line_len++] = c;
+			continue;
+		}
+
+		if (ctx->line_len == 0) {
+			continue;
+		}
+
+		ctx->line[ctx->line_len] = '\0';
+		uint16_t line_len = ctx->line_len;
+		ctx->line_len = 0;
+
+		if (parse_line(ctx, ctx->line, line_len) == false) {
+			return false;
+		}
+
+		// The vendor found the image already on the device, drop the rest
+		if (ctx->skip_write) {
+			return true;
+		}
+	}
+
+	return true;
+}
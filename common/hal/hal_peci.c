@@ -30,6 +30,21 @@ const struct device *dev;
 struct k_mutex peci_lock;
 struct k_timer retry_timer;
 
+typedef struct {
+	bool valid;
+	uint8_t cmd;
+	uint8_t addr;
+	uint8_t index;
+	uint16_t param;
+	uint8_t len;
+	uint8_t data[PECI_CACHE_DATA_MAX];
+	int64_t timestamp;
+} peci_cache_entry;
+
+static peci_cache_entry peci_cache[PECI_CACHE_ENTRY_NUM];
+static uint32_t peci_cache_hit, peci_cache_miss;
+K_MUTEX_DEFINE(peci_cache_lock);
+
 int peci_init()
 {
 	dev = device_get_binding("PECI");
@@ -211,3 +226,109 @@ int peci_write(uint8_t cmd, uint8_t address, uint8_t u8ReadLen, uint8_t *readBuf
 
 	return ret;
 }
+
+static peci_cache_entry *peci_cache_find(uint8_t cmd, uint8_t address, uint8_t u8Index,
+					 uint16_t u16Param, uint8_t u8ReadLen)
+{
+	for (int i = 0; i < PECI_CACHE_ENTRY_NUM; i++) {
+		peci_cache_entry *entry = &peci_cache[i];
+		if (entry->valid && (entry->cmd == cmd) && (entry->addr == address) &&
+		    (entry->index == u8Index) && (entry->param == u16Param) &&
+		    (entry->len == u8ReadLen)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static peci_cache_entry *peci_cache_victim(void)
+{
+	peci_cache_entry *oldest = &peci_cache[0];
+	for (int i = 0; i < PECI_CACHE_ENTRY_NUM; i++) {
+		if (!peci_cache[i].valid) {
+			return &peci_cache[i];
+		}
+		if (peci_cache[i].timestamp < oldest->timestamp) {
+			oldest = &peci_cache[i];
+		}
+	}
+
+	return oldest;
+}
+
+/*
+ * Same as peci_read(), but a response younger than max_age_ms is served from the cache
+ * instead of the bus. Only responses with a success completion code are stored, so a
+ * busy or powered off CPU is asked again on the next call. Pass PECI_CACHE_FOREVER for
+ * values that never change while the CPU stays present.
+ */
+int peci_cached_read(uint8_t cmd, uint8_t address, uint8_t u8Index, uint16_t u16Param,
+		     uint8_t u8ReadLen, uint8_t *readBuf, uint32_t max_age_ms)
+{
+	if (readBuf == NULL) {
+		LOG_ERR("PECI read buffer was passed in as null");
+		return -1;
+	}
+
+	if ((u8ReadLen == 0) || (u8ReadLen > PECI_CACHE_DATA_MAX)) {
+		return peci_read(cmd, address, u8Index, u16Param, u8ReadLen, readBuf);
+	}
+
+	k_mutex_lock(&peci_cache_lock, K_FOREVER);
+	peci_cache_entry *entry = peci_cache_find(cmd, address, u8Index, u16Param, u8ReadLen);
+	if ((entry != NULL) && ((max_age_ms == PECI_CACHE_FOREVER) ||
+				((k_uptime_get() - entry->timestamp) < max_age_ms))) {
+		memcpy(readBuf, entry->data, u8ReadLen);
+		peci_cache_hit++;
+		k_mutex_unlock(&peci_cache_lock);
+		return 0;
+	}
+	peci_cache_miss++;
+	k_mutex_unlock(&peci_cache_lock);
+
+	int ret = peci_read(cmd, address, u8Index, u16Param, u8ReadLen, readBuf);
+	if ((ret != 0) || (readBuf[0] != PECI_CC_RSP_SUCCESS)) {
+		return ret;
+	}
+
+	k_mutex_lock(&peci_cache_lock, K_FOREVER);
+	entry = peci_cache_find(cmd, address, u8Index, u16Param, u8ReadLen);
+	if (entry == NULL) {
+		entry = peci_cache_victim();
+	}
+	entry->valid = true;
+	entry->cmd = cmd;
+	entry->addr = address;
+	entry->index = u8Index;
+	entry->param = u16Param;
+	entry->len = u8ReadLen;
+	memcpy(entry->data, readBuf, u8ReadLen);
+	entry->timestamp = k_uptime_get();
+	k_mutex_unlock(&peci_cache_lock);
+
+	return ret;
+}
+
+/* Drop the cached responses of one CPU, or of every CPU if address is 0 */
+void peci_cache_invalidate(uint8_t address)
+{
+	k_mutex_lock(&peci_cache_lock, K_FOREVER);
+	for (int i = 0; i < PECI_CACHE_ENTRY_NUM; i++) {
+		if ((address == 0) || (peci_cache[i].addr == address)) {
+			peci_cache[i].valid = false;
+		}
+	}
+	k_mutex_unlock(&peci_cache_lock);
+}
+
+void peci_cache_get_stat(uint32_t *hit, uint32_t *miss)
+{
+	CHECK_NULL_ARG(hit);
+	CHECK_NULL_ARG(miss);
+
+	k_mutex_lock(&peci_cache_lock, K_FOREVER);
+	*hit = peci_cache_hit;
+	*miss = peci_cache_miss;
+	k_mutex_unlock(&peci_cache_lock);
+}
@@ -29,6 +29,13 @@
 #define PECI_DEV_RETRY_INTERVAL_MAX_MSEC 100
 #define PECI_DEV_RETRY_INTERVAL_MIN_MSEC 1
 
+/* Transaction cache for slowly changing PECI reads, see peci_cached_read() */
+#ifndef PECI_CACHE_ENTRY_NUM
+#define PECI_CACHE_ENTRY_NUM 32
+#endif
+#define PECI_CACHE_DATA_MAX 9
+#define PECI_CACHE_FOREVER UINT32_MAX
+
 enum peci_cmd {
 	PECI_PING_CMD = 0x00,
 	PECI_GET_TEMP0_CMD = 0x01,
@@ -61,6 +68,10 @@ int peci_read(uint8_t cmd, uint8_t address, uint8_t u8Index, uint16_t u16Param,
 	      uint8_t *readBuf);
 int peci_write(uint8_t cmd, uint8_t address, uint8_t u8ReadLen, uint8_t *readBuf,
 	       uint8_t u8WriteLen, uint8_t *writeBuf);
+int peci_cached_read(uint8_t cmd, uint8_t address, uint8_t u8Index, uint16_t u16Param,
+		     uint8_t u8ReadLen, uint8_t *readBuf, uint32_t max_age_ms);
+void peci_cache_invalidate(uint8_t address);
+void peci_cache_get_stat(uint32_t *hit, uint32_t *miss);
 bool peci_retry_read(uint8_t cmd, uint8_t address, uint8_t u8Index, uint16_t u16Param,
 		     uint8_t u8ReadLen, uint8_t *readBuf);
 
@@ -15,13 +15,22 @@
  */
 
 #include <stdint.h>
+#include <string.h>
+#include <zephyr.h>
 #include <logging/log.h>
 #include "sensor.h"
 #include "hal_i2c.h"
 #include "pmbus.h"
+#include "util_pmbus.h"
 
 LOG_MODULE_REGISTER(util_pmbus);
 
+#define PMBUS_READ_PLAN_DEFAULT_MAX_AGE_MS 100
+#define PMBUS_READ_PLAN_PAGE_UNKNOWN 0xFF
+
+static pmbus_read_plan *read_plan_table[PMBUS_READ_PLAN_MAX];
+static uint8_t read_plan_count = 0;
+
 const float slinear11_exponents[32] = { 1.0,
 					2.0,
 					4.0,
@@ -139,3 +148,226 @@ int pmbus_set_page(uint8_t bus, uint8_t addr, uint8_t page)
 	}
 	return ret;
 }
+
+static bool pmbus_read_plan_is_stale(pmbus_read_plan *plan)
+{
+	uint32_t max_age_ms =
+		(plan->max_age_ms != 0) ? plan->max_age_ms : PMBUS_READ_PLAN_DEFAULT_MAX_AGE_MS;
+
+	if (plan->run_count == 0) {
+		return true;
+	}
+
+	return ((k_uptime_get() - plan->update_time_ms) >= max_age_ms);
+}
+
+int pmbus_read_plan_register(pmbus_read_plan *plan)
+{
+	CHECK_NULL_ARG_WITH_RETURN(plan, -1);
+	CHECK_NULL_ARG_WITH_RETURN(plan->items, -1);
+
+	if (plan->item_count == 0) {
+		LOG_ERR("Read plan of bus: 0x%x, addr: 0x%x has no item", plan->bus, plan->addr);
+		return -1;
+	}
+
+	if (pmbus_read_plan_find(plan->bus, plan->addr) != NULL) {
+		LOG_ERR("Read plan of bus: 0x%x, addr: 0x%x already registered", plan->bus,
+			plan->addr);
+		return -1;
+	}
+
+	if (read_plan_count >= PMBUS_READ_PLAN_MAX) {
+		LOG_ERR("Read plan table is full, max: %d", PMBUS_READ_PLAN_MAX);
+		return -1;
+	}
+
+	uint8_t i, j;
+	for (i = 0; i < plan->item_count; i++) {
+		if ((plan->items[i].len == 0) ||
+		    (plan->items[i].len > PMBUS_READ_PLAN_ITEM_DATA_MAX)) {
+			LOG_ERR("Invalid read length: %d, command: 0x%x", plan->items[i].len,
+				plan->items[i].command);
+			return -1;
+		}
+		plan->items[i].is_valid = false;
+	}
+
+	/* Stable sort by page so a run only switches pages when it has to */
+	for (i = 1; i < plan->item_count; i++) {
+		pmbus_read_plan_item item = plan->items[i];
+		for (j = i; (j > 0) && (plan->items[j - 1].page > item.page); j--) {
+			plan->items[j] = plan->items[j - 1];
+		}
+		plan->items[j] = item;
+	}
+
+	plan->update_time_ms = 0;
+	plan->run_count = 0;
+	plan->transaction_count = 0;
+	plan->hit_count = 0;
+
+	read_plan_table[read_plan_count++] = plan;
+	return 0;
+}
+
+pmbus_read_plan *pmbus_read_plan_find(uint8_t bus, uint8_t addr)
+{
+	for (uint8_t i = 0; i < read_plan_count; i++) {
+		if ((read_plan_table[i]->bus == bus) && (read_plan_table[i]->addr == addr)) {
+			return read_plan_table[i];
+		}
+	}
+
+	return NULL;
+}
+
+uint8_t pmbus_read_plan_get_count()
+{
+	return read_plan_count;
+}
+
+pmbus_read_plan *pmbus_read_plan_get(uint8_t index)
+{
+	return (index < read_plan_count) ? read_plan_table[index] : NULL;
+}
+
+int pmbus_read_plan_run(pmbus_read_plan *plan)
+{
+	CHECK_NULL_ARG_WITH_RETURN(plan, -1);
+
+	int ret = 0;
+	uint8_t i;
+	uint8_t origin_page = PMBUS_READ_PLAN_PAGE_UNKNOWN;
+	uint8_t current_page = PMBUS_READ_PLAN_PAGE_UNKNOWN;
+	bool is_static_refresh = ((plan->run_count % PMBUS_READ_PLAN_STATIC_REFRESH_RUNS) == 0);
+
+	if (plan->mutex != NULL) {
+		if (k_mutex_lock(plan->mutex, K_MSEC(PMBUS_READ_PLAN_MUTEX_TIMEOUT_MS))) {
+			LOG_ERR("Read plan of bus: 0x%x, addr: 0x%x mutex lock fail", plan->bus,
+				plan->addr);
+			return -1;
+		}
+	}
+
+	if (plan->restore_page) {
+		plan->transaction_count++;
+		if (pmbus_read_command(plan->bus, plan->addr, PMBUS_PAGE, &origin_page, 1) != 0) {
+			for (i = 0; i < plan->item_count; i++) {
+				plan->items[i].is_valid = false;
+			}
+			ret = -1;
+			goto unlock;
+		}
+		current_page = origin_page;
+	}
+
+	for (i = 0; i < plan->item_count; i++) {
+		pmbus_read_plan_item *item = &plan->items[i];
+
+		if (item->is_static && item->is_valid && !is_static_refresh) {
+			continue;
+		}
+
+		if (item->page != current_page) {
+			plan->transaction_count++;
+			if (pmbus_set_page(plan->bus, plan->addr, item->page) != 0) {
+				item->is_valid = false;
+				current_page = PMBUS_READ_PLAN_PAGE_UNKNOWN;
+				ret = -1;
+				continue;
+			}
+			current_page = item->page;
+		}
+
+		plan->transaction_count++;
+		if (pmbus_read_command(plan->bus, plan->addr, item->command, item->data,
+				       item->len) != 0) {
+			item->is_valid = false;
+			ret = -1;
+			continue;
+		}
+		item->is_valid = true;
+	}
+
+	if (plan->restore_page && (current_page != origin_page)) {
+		plan->transaction_count++;
+		if (pmbus_set_page(plan->bus, plan->addr, origin_page) != 0) {
+			ret = -1;
+		}
+	}
+
+	plan->update_time_ms = k_uptime_get();
+	plan->run_count++;
+
+unlock:
+	if (plan->mutex != NULL) {
+		k_mutex_unlock(plan->mutex);
+	}
+
+	return ret;
+}
+
+static pmbus_read_plan_item *pmbus_read_plan_fetch(pmbus_read_plan *plan,
+						   pmbus_read_plan_item *item)
+{
+	if (item == NULL) {
+		return NULL;
+	}
+
+	if (pmbus_read_plan_is_stale(plan)) {
+		pmbus_read_plan_run(plan);
+	} else {
+		plan->hit_count++;
+	}
+
+	return (item->is_valid ? item : NULL);
+}
+
+pmbus_read_plan_item *pmbus_read_plan_get_item(pmbus_read_plan *plan, uint8_t page,
+					       uint8_t command)
+{
+	CHECK_NULL_ARG_WITH_RETURN(plan, NULL);
+
+	pmbus_read_plan_item *item = NULL;
+	for (uint8_t i = 0; i < plan->item_count; i++) {
+		if ((plan->items[i].page == page) && (plan->items[i].command == command)) {
+			item = &plan->items[i];
+			break;
+		}
+	}
+
+	return pmbus_read_plan_fetch(plan, item);
+}
+
+static pmbus_read_plan_item *pmbus_read_plan_find_sensor_item(pmbus_read_plan *plan,
+							      uint8_t sensor_num)
+{
+	if ((plan == NULL) || (sensor_num == SENSOR_NUM_MAX)) {
+		return NULL;
+	}
+
+	for (uint8_t i = 0; i < plan->item_count; i++) {
+		if (plan->items[i].sensor_num == sensor_num) {
+			return &plan->items[i];
+		}
+	}
+
+	return NULL;
+}
+
+bool pmbus_read_plan_is_sensor_planned(sensor_cfg *cfg)
+{
+	CHECK_NULL_ARG_WITH_RETURN(cfg, false);
+
+	pmbus_read_plan *plan = pmbus_read_plan_find(cfg->port, cfg->target_addr);
+	return (pmbus_read_plan_find_sensor_item(plan, cfg->num) != NULL);
+}
+
+pmbus_read_plan_item *pmbus_read_plan_get_sensor_item(sensor_cfg *cfg)
+{
+	CHECK_NULL_ARG_WITH_RETURN(cfg, NULL);
+
+	pmbus_read_plan *plan = pmbus_read_plan_find(cfg->port, cfg->target_addr);
+	return pmbus_read_plan_fetch(plan, pmbus_read_plan_find_sensor_item(plan, cfg->num));
+}
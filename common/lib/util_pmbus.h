@@ -17,12 +17,63 @@
 #ifndef UTIL_PMBUS_H
 #define UTIL_PMBUS_H
 
+#include <zephyr.h>
 #include "sensor.h"
 
+#ifndef PMBUS_READ_PLAN_MAX
+#define PMBUS_READ_PLAN_MAX 16
+#endif
+
+#define PMBUS_READ_PLAN_ITEM_DATA_MAX 4
+#define PMBUS_READ_PLAN_MUTEX_TIMEOUT_MS 1000
+/* Static items are re-read every this many plan runs */
+#define PMBUS_READ_PLAN_STATIC_REFRESH_RUNS 100
+
+/*
+ * A read plan lists every register a sweep needs from one PMBus device. Running the plan reads
+ * them in one pass ordered by page, so PAGE is written once per page instead of once per sensor,
+ * and every sensor of the device is served from the same pass. Sensors in a plan are read only
+ * through it, the drivers don't fall back to a direct read on the current page.
+ */
+typedef struct _pmbus_read_plan_item {
+	uint8_t sensor_num; /* SENSOR_NUM_MAX when the item is not bound to a sensor */
+	uint8_t page;
+	uint8_t command;
+	uint8_t len;
+	bool is_static; /* configuration register, refreshed every STATIC_REFRESH_RUNS runs */
+	uint8_t data[PMBUS_READ_PLAN_ITEM_DATA_MAX];
+	bool is_valid;
+} pmbus_read_plan_item;
+
+typedef struct _pmbus_read_plan {
+	uint8_t bus;
+	uint8_t addr;
+	struct k_mutex *mutex; /* optional, shared with the other users of the device page */
+	bool restore_page; /* read PAGE first and restore it, if other users rely on it */
+	uint32_t max_age_ms;
+	pmbus_read_plan_item *items;
+	uint8_t item_count;
+
+	/* filled by pmbus_read_plan_run() */
+	int64_t update_time_ms;
+	uint32_t run_count;
+	uint32_t transaction_count;
+	uint32_t hit_count;
+} pmbus_read_plan;
+
 float slinear11_to_float(uint16_t);
 bool get_exponent_from_vout_mode(sensor_cfg *, float *);
 int pmbus_read_command(uint8_t bus, uint8_t addr, uint8_t command, uint8_t *result,
 		       uint8_t read_len);
 int pmbus_set_page(uint8_t bus, uint8_t addr, uint8_t page);
+int pmbus_read_plan_register(pmbus_read_plan *plan);
+pmbus_read_plan *pmbus_read_plan_find(uint8_t bus, uint8_t addr);
+uint8_t pmbus_read_plan_get_count();
+pmbus_read_plan *pmbus_read_plan_get(uint8_t index);
+int pmbus_read_plan_run(pmbus_read_plan *plan);
+pmbus_read_plan_item *pmbus_read_plan_get_item(pmbus_read_plan *plan, uint8_t page,
+					       uint8_t command);
+bool pmbus_read_plan_is_sensor_planned(sensor_cfg *cfg);
+pmbus_read_plan_item *pmbus_read_plan_get_sensor_item(sensor_cfg *cfg);
 
 #endif
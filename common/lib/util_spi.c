@@ -38,6 +38,12 @@ LOG_MODULE_REGISTER(util_spi);
 #define FW_UPDATE_RETRY_MAX_COUNT 0
 #endif
 
+#ifndef FW_UPDATE_SUB_SECTOR_ERASE
+#define FW_UPDATE_SUB_SECTOR_ERASE false
+#endif
+
+#define FW_UPDATE_SUB_SECTOR_MAX (sizeof(uint32_t) * 8)
+
 #define IS25WP256D_ID 0x9D7019
 
 #define BIOS_MAX_SIZE_BYTES   (64 * 1024 * 1024UL)
@@ -45,6 +51,8 @@ LOG_MODULE_REGISTER(util_spi);
 volatile uint8_t bios_erase_progress = 0;
 
 static int default_retry_count = FW_UPDATE_RETRY_MAX_COUNT;
+static bool sub_sector_erase = FW_UPDATE_SUB_SECTOR_ERASE;
+static fw_update_diff_stat diff_stat = { 0 };
 
 static struct {
 	char *name;
@@ -112,6 +120,52 @@ end:
 	return ret;
 }
 
+/* Mark every chunk of the sector where the new data differs from the flash content */
+static uint32_t get_dirty_chunk_map(const uint8_t *flash_buf, const uint8_t *write_buf,
+				    uint32_t start, uint32_t len, uint32_t chunk_sz)
+{
+	uint32_t dirty_map = 0;
+	uint32_t pos = start, end = start + len;
+
+	while (pos < end) {
+		uint32_t chunk_end = MIN((pos / chunk_sz + 1) * chunk_sz, end);
+		if (memcmp(flash_buf + pos, write_buf + (pos - start), chunk_end - pos) != 0) {
+			dirty_map |= BIT(pos / chunk_sz);
+		}
+		pos = chunk_end;
+	}
+
+	return dirty_map;
+}
+
+static int do_diff_erase_write_verify(const struct device *flash_device, uint32_t op_addr,
+				      uint8_t *write_buf, uint8_t *read_back_buf,
+				      uint32_t sector_sz, uint32_t chunk_sz, uint32_t dirty_map)
+{
+	int ret = 0;
+
+	if (dirty_map == 0) {
+		diff_stat.skipped_sector_count++;
+		return 0;
+	}
+
+	for (uint32_t chunk_ofs = 0; chunk_ofs < sector_sz; chunk_ofs += chunk_sz) {
+		if (!(dirty_map & BIT(chunk_ofs / chunk_sz))) {
+			continue;
+		}
+
+		ret = do_erase_write_verify(flash_device, op_addr + chunk_ofs,
+					    write_buf + chunk_ofs, read_back_buf, chunk_sz);
+		if (ret != 0) {
+			return ret;
+		}
+		diff_stat.erased_block_count++;
+	}
+
+	diff_stat.written_sector_count++;
+	return 0;
+}
+
 int ckeck_flash_device_isinit(const struct device *flash_device, uint8_t flash_position)
 {
 	CHECK_NULL_ARG_WITH_RETURN(flash_device, -1);
@@ -140,8 +194,8 @@ int do_update(const struct device *flash_device, off_t offset, uint8_t *buf, siz
 	uint32_t sector_sz = flash_get_write_block_size(flash_device);
 	uint32_t flash_offset = (uint32_t)offset;
 	uint32_t remain, op_addr = 0, end_sector_addr;
+	uint32_t chunk_sz = sector_sz, dirty_map = 0;
 	uint8_t *update_ptr = buf, *op_buf = NULL, *read_back_buf = NULL;
-	bool update_it = false;
 
 	if (flash_sz < flash_offset + len) {
 		LOG_ERR("Update boundary exceeds flash size. (%u, %u, %u)", flash_sz, flash_offset,
@@ -164,6 +218,12 @@ int do_update(const struct device *flash_device, off_t offset, uint8_t *buf, siz
 		goto end;
 	}
 
+	/* Only erase the 4K sub-sectors that changed when the sector is made of several */
+	if (sub_sector_erase && (sector_sz > SECTOR_SZ_4K) && ((sector_sz % SECTOR_SZ_4K) == 0) &&
+	    ((sector_sz / SECTOR_SZ_4K) <= FW_UPDATE_SUB_SECTOR_MAX)) {
+		chunk_sz = SECTOR_SZ_4K;
+	}
+
 	/* initial op_addr */
 	op_addr = (flash_offset / sector_sz) * sector_sz;
 
@@ -174,9 +234,11 @@ int do_update(const struct device *flash_device, off_t offset, uint8_t *buf, siz
 			goto end;
 
 		remain = MIN(sector_sz - (flash_offset % sector_sz), len);
+		dirty_map = get_dirty_chunk_map(op_buf, update_ptr, flash_offset % sector_sz,
+						remain, chunk_sz);
 		memcpy((uint8_t *)op_buf + (flash_offset % sector_sz), update_ptr, remain);
-		ret = do_erase_write_verify(flash_device, op_addr, op_buf, read_back_buf,
-					    sector_sz);
+		ret = do_diff_erase_write_verify(flash_device, op_addr, op_buf, read_back_buf,
+						 sector_sz, chunk_sz, dirty_map);
 		if (ret != 0)
 			goto end;
 
@@ -191,15 +253,11 @@ int do_update(const struct device *flash_device, off_t offset, uint8_t *buf, siz
 		if (ret != 0)
 			goto end;
 
-		if (memcmp(op_buf, update_ptr, sector_sz) != 0)
-			update_it = true;
-
-		if (update_it) {
-			ret = do_erase_write_verify(flash_device, op_addr, update_ptr,
-						    read_back_buf, sector_sz);
-			if (ret != 0)
-				goto end;
-		}
+		dirty_map = get_dirty_chunk_map(op_buf, update_ptr, 0, sector_sz, chunk_sz);
+		ret = do_diff_erase_write_verify(flash_device, op_addr, update_ptr, read_back_buf,
+						 sector_sz, chunk_sz, dirty_map);
+		if (ret != 0)
+			goto end;
 
 		op_addr += sector_sz;
 		update_ptr += sector_sz;
@@ -212,10 +270,11 @@ int do_update(const struct device *flash_device, off_t offset, uint8_t *buf, siz
 			goto end;
 
 		remain = flash_offset + len - end_sector_addr;
+		dirty_map = get_dirty_chunk_map(op_buf, update_ptr, 0, remain, chunk_sz);
 		memcpy((uint8_t *)op_buf, update_ptr, remain);
 
-		ret = do_erase_write_verify(flash_device, op_addr, op_buf, read_back_buf,
-					    sector_sz);
+		ret = do_diff_erase_write_verify(flash_device, op_addr, op_buf, read_back_buf,
+						 sector_sz, chunk_sz, dirty_map);
 		if (ret != 0)
 			goto end;
 
@@ -320,6 +379,196 @@ end:
 }
 #endif
 
+static int fw_update_write_sector(uint32_t start_offset, uint8_t *buf, uint32_t len,
+				  uint8_t flash_position)
+{
+	int ret = 0;
+	const struct device *flash_dev;
+
+	flash_dev = device_get_binding(flash_device_list[flash_position].name);
+	if (flash_dev == NULL) {
+		LOG_ERR("Failed to get device.");
+		return CC_UNSPECIFIED_ERROR;
+	}
+
+	ret = ckeck_flash_device_isinit(flash_dev, flash_position);
+	if (ret != 0) {
+		return ret;
+	}
+
+	if (start_offset == 0) {
+		//IS25WP256D need to set 4byte address mode before update
+		uint8_t jedec_id[3] = { 0 };
+		flash_read_jedec_id(flash_dev, jedec_id);
+		if ((jedec_id[0] << 16 | jedec_id[1] << 8 | jedec_id[2]) == IS25WP256D_ID) {
+			spi_nor_config_4byte_mode(flash_dev, true);
+		}
+	}
+
+	ret = do_update(flash_dev, start_offset, buf, len);
+	if (ret) {
+		LOG_ERR("Failed to update SPI, status %d", ret);
+	} else {
+		LOG_INF("Update success");
+	}
+
+	LOG_DBG("Update from offset 0x%x, length 0x%x", start_offset, len);
+	return ret;
+}
+
+#ifdef ENABLE_FW_UPDATE_PIPELINE
+/*
+ * Pipelined update: a completed sector buffer is handed to a worker thread which erases, writes
+ * and verifies it while the next sector is being received into another buffer from a static
+ * pool. A write failure is reported on the next package, and the last package waits until every
+ * queued sector is written.
+ */
+#ifndef FW_UPDATE_PIPELINE_BUF_NUM
+#define FW_UPDATE_PIPELINE_BUF_NUM 2
+#endif
+
+#ifndef FW_UPDATE_PIPELINE_STACK_SIZE
+#define FW_UPDATE_PIPELINE_STACK_SIZE 2048
+#endif
+
+#define FW_UPDATE_PIPELINE_TIMEOUT_MS 10000
+
+typedef struct _fw_update_job {
+	uint8_t *buf;
+	uint32_t start_offset;
+	uint32_t len;
+	uint8_t flash_position;
+} fw_update_job;
+
+K_MEM_SLAB_DEFINE_STATIC(fw_update_buf_slab, SECTOR_SZ_64K, FW_UPDATE_PIPELINE_BUF_NUM, 4);
+K_MSGQ_DEFINE(fw_update_job_msgq, sizeof(fw_update_job), FW_UPDATE_PIPELINE_BUF_NUM, 4);
+K_SEM_DEFINE(fw_update_job_done_sem, 0, 1);
+K_THREAD_STACK_DEFINE(fw_update_pipeline_stack, FW_UPDATE_PIPELINE_STACK_SIZE);
+static struct k_thread fw_update_pipeline_thread;
+static bool is_pipeline_init = false;
+static atomic_t pending_job_count = ATOMIC_INIT(0);
+static atomic_t pipeline_error = ATOMIC_INIT(0);
+
+static void fw_update_pipeline_handler(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	fw_update_job job;
+
+	while (1) {
+		k_msgq_get(&fw_update_job_msgq, &job, K_FOREVER);
+
+		/* Only this worker switches the BIOS SPI mux for a pipelined update */
+		bool is_bios = (job.flash_position == pal_get_bios_flash_position());
+		int ret = 0;
+		if (is_bios && !pal_switch_bios_spi_mux(1)) {
+			LOG_ERR("Failed to switch BIOS SPI mux to BIC");
+			ret = -EIO;
+		} else {
+			ret = fw_update_write_sector(job.start_offset, job.buf, job.len,
+						     job.flash_position);
+		}
+
+		if (ret != 0) {
+			atomic_cas(&pipeline_error, 0, FWUPDATE_UPDATE_FAIL);
+		}
+
+		k_mem_slab_free(&fw_update_buf_slab, (void **)&job.buf);
+
+		if (is_bios && (k_msgq_num_used_get(&fw_update_job_msgq) == 0)) {
+			pal_switch_bios_spi_mux(0);
+		}
+
+		atomic_dec(&pending_job_count);
+		k_sem_give(&fw_update_job_done_sem);
+	}
+}
+
+static void fw_update_pipeline_init()
+{
+	if (is_pipeline_init) {
+		return;
+	}
+
+	k_thread_create(&fw_update_pipeline_thread, fw_update_pipeline_stack,
+			K_THREAD_STACK_SIZEOF(fw_update_pipeline_stack), fw_update_pipeline_handler,
+			NULL, NULL, NULL, CONFIG_MAIN_THREAD_PRIORITY, 0, K_NO_WAIT);
+	k_thread_name_set(&fw_update_pipeline_thread, "fw_update_pipeline");
+	is_pipeline_init = true;
+}
+
+/* Wait until every queued sector is written and return the first error, if any */
+static uint8_t fw_update_pipeline_drain()
+{
+	while (atomic_get(&pending_job_count) > 0) {
+		if (k_sem_take(&fw_update_job_done_sem, K_MSEC(FW_UPDATE_PIPELINE_TIMEOUT_MS))) {
+			LOG_ERR("Wait for pending sector write timeout, pending: %d",
+				(int)atomic_get(&pending_job_count));
+			return FWUPDATE_UPDATE_FAIL;
+		}
+	}
+
+	return (uint8_t)atomic_set(&pipeline_error, 0);
+}
+
+static uint8_t *fw_update_alloc_txbuf()
+{
+	void *buf = NULL;
+
+	/* Both buffers in flight means the flash is behind, wait for one to be released */
+	if (k_mem_slab_alloc(&fw_update_buf_slab, &buf, K_MSEC(FW_UPDATE_PIPELINE_TIMEOUT_MS))) {
+		return NULL;
+	}
+
+	return (uint8_t *)buf;
+}
+
+static void fw_update_free_txbuf(uint8_t **txbuf)
+{
+	if (*txbuf != NULL) {
+		k_mem_slab_free(&fw_update_buf_slab, (void **)txbuf);
+		*txbuf = NULL;
+	}
+}
+
+static uint8_t fw_update_submit_sector(uint8_t *buf, uint32_t start_offset, uint32_t len,
+				       uint8_t flash_position)
+{
+	fw_update_job job = { .buf = buf,
+			      .start_offset = start_offset,
+			      .len = len,
+			      .flash_position = flash_position };
+
+	atomic_inc(&pending_job_count);
+	if (k_msgq_put(&fw_update_job_msgq, &job, K_MSEC(FW_UPDATE_PIPELINE_TIMEOUT_MS))) {
+		LOG_ERR("Failed to queue sector write, offset 0x%x", start_offset);
+		atomic_dec(&pending_job_count);
+		k_mem_slab_free(&fw_update_buf_slab, (void **)&buf);
+		return FWUPDATE_UPDATE_FAIL;
+	}
+
+	return FWUPDATE_SUCCESS;
+}
+#else
+static uint8_t *fw_update_alloc_txbuf()
+{
+	uint8_t *buf = (uint8_t *)malloc(SECTOR_SZ_64K);
+	if (buf == NULL) { // Retry alloc
+		k_msleep(100);
+		buf = (uint8_t *)malloc(SECTOR_SZ_64K);
+	}
+
+	return buf;
+}
+
+static void fw_update_free_txbuf(uint8_t **txbuf)
+{
+	SAFE_FREE(*txbuf);
+}
+#endif
+
 uint8_t fw_update(uint32_t offset, uint16_t msg_len, uint8_t *msg_buf, uint8_t flag,
 		  uint8_t flash_position)
 {
@@ -328,21 +577,35 @@ uint8_t fw_update(uint32_t offset, uint16_t msg_len, uint8_t *msg_buf, uint8_t f
 	static uint32_t start_offset = 0, buf_offset = 0;
 	static int fw_update_retry = 0;
 	uint32_t ret = 0;
-	const struct device *flash_dev;
+
+#ifdef ENABLE_FW_UPDATE_PIPELINE
+	fw_update_pipeline_init();
+
+	if ((offset == 0) || (flag & FORCE_INIT_FLAG)) {
+		// Previous image is abandoned, finish its queued sectors and drop its result
+		fw_update_pipeline_drain();
+	} else {
+		// Report a sector write failure of this image on the next package
+		ret = atomic_set(&pipeline_error, 0);
+		if (ret != FWUPDATE_SUCCESS) {
+			LOG_ERR("SPI index %d, previous sector write failed", flash_position);
+			fw_update_free_txbuf(&txbuf);
+			is_init = 0;
+			return ret;
+		}
+	}
+#endif
 
 	if ((offset == 0) || (flag & FORCE_INIT_FLAG)) {
 		// Set default fw update retry count at first package
 		fw_update_retry = default_retry_count;
 		is_init = 0;
+		reset_fw_update_diff_stat();
 	}
 
 	if (!is_init) {
-		SAFE_FREE(txbuf);
-		txbuf = (uint8_t *)malloc(SECTOR_SZ_64K);
-		if (txbuf == NULL) { // Retry alloc
-			k_msleep(100);
-			txbuf = (uint8_t *)malloc(SECTOR_SZ_64K);
-		}
+		fw_update_free_txbuf(&txbuf);
+		txbuf = fw_update_alloc_txbuf();
 		if (txbuf == NULL) {
 			LOG_ERR("SPI index %d, failed to allocate txbuf.", flash_position);
 			return FWUPDATE_OUT_OF_HEAP;
@@ -360,8 +623,7 @@ uint8_t fw_update(uint32_t offset, uint16_t msg_len, uint8_t *msg_buf, uint8_t f
 		if (fw_update_retry < 0) {
 			LOG_ERR("SPI index %d, retry reached max: %d", flash_position,
 				fw_update_retry);
-			SAFE_FREE(txbuf);
-			txbuf = NULL;
+			fw_update_free_txbuf(&txbuf);
 			k_msleep(10);
 			is_init = 0;
 			return FWUPDATE_REPEATED_UPDATED;
@@ -383,8 +645,7 @@ uint8_t fw_update(uint32_t offset, uint16_t msg_len, uint8_t *msg_buf, uint8_t f
 	if ((buf_offset + msg_len) > SECTOR_SZ_64K) {
 		LOG_ERR("SPI index %d, recv data over buffer length(64KB), buf_offset 0x%x, msg_len 0x%x",
 			flash_position, buf_offset, msg_len);
-		SAFE_FREE(txbuf);
-		txbuf = NULL;
+		fw_update_free_txbuf(&txbuf);
 		k_msleep(10);
 		is_init = 0;
 		return FWUPDATE_OVER_LENGTH;
@@ -399,40 +660,21 @@ uint8_t fw_update(uint32_t offset, uint16_t msg_len, uint8_t *msg_buf, uint8_t f
 
 	// Update fmc while collect 64k bytes data or BMC signal last image package with target | 0x80
 	if ((buf_offset == SECTOR_SZ_64K) || (flag & SECTOR_END_FLAG)) {
-		flash_dev = device_get_binding(flash_device_list[flash_position].name);
-		if (flash_dev == NULL) {
-			LOG_ERR("Failed to get device.");
-			ret = CC_UNSPECIFIED_ERROR;
-			return ret;
-		}
-
-		ret = ckeck_flash_device_isinit(flash_dev, flash_position);
-		if (ret != 0) {
-			SAFE_FREE(txbuf);
-			is_init = 0;
-			return ret;
-		}
+#ifdef ENABLE_FW_UPDATE_PIPELINE
+		// The worker owns the buffer from here on
+		ret = fw_update_submit_sector(txbuf, start_offset, buf_offset, flash_position);
+		txbuf = NULL;
+		is_init = 0;
 
-		if (start_offset == 0) {
-			//IS25WP256D need to set 4byte address mode before update
-			uint8_t jedec_id[3] = { 0 };
-			flash_read_jedec_id(flash_dev, jedec_id);
-			if ((jedec_id[0] << 16 | jedec_id[1] << 8 | jedec_id[2]) == IS25WP256D_ID) {
-				spi_nor_config_4byte_mode(flash_dev, true);
-			}
+		if ((ret == FWUPDATE_SUCCESS) && (flag & SECTOR_END_FLAG)) {
+			ret = fw_update_pipeline_drain();
 		}
-
-		ret = do_update(flash_dev, start_offset, txbuf, buf_offset);
-		if (ret) {
-			LOG_ERR("Failed to update SPI, status %d", ret);
-		} else {
-			LOG_INF("Update success");
-		}
-		SAFE_FREE(txbuf);
+#else
+		ret = fw_update_write_sector(start_offset, txbuf, buf_offset, flash_position);
+		fw_update_free_txbuf(&txbuf);
 		k_msleep(10);
 		is_init = 0;
-
-		LOG_DBG("Update from offset 0x%x, length 0x%x", start_offset, buf_offset);
+#endif
 
 		if ((flag & SECTOR_END_FLAG) && (flash_position == DEVSPI_FMC_CS0)) {
 			if (flag & NO_RESET_FLAG) {
@@ -480,6 +722,23 @@ void set_default_retry_count(int count)
 	default_retry_count = count;
 }
 
+void set_fw_update_sub_sector_erase(bool enable)
+{
+	sub_sector_erase = enable;
+}
+
+void get_fw_update_diff_stat(fw_update_diff_stat *stat)
+{
+	CHECK_NULL_ARG(stat);
+
+	memcpy(stat, &diff_stat, sizeof(fw_update_diff_stat));
+}
+
+void reset_fw_update_diff_stat()
+{
+	memset(&diff_stat, 0, sizeof(fw_update_diff_stat));
+}
+
 __weak uint8_t fw_update_cxl(uint32_t offset, uint16_t msg_len, uint8_t *msg_buf, bool sector_end)
 {
 	return FWUPDATE_NOT_SUPPORT;
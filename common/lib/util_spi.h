@@ -36,6 +36,13 @@
 #define FORCE_INIT_FLAG BIT(1)
 #define NO_RESET_FLAG BIT(0)
 
+/* Counters of the differential update since the first package of the current image */
+typedef struct _fw_update_diff_stat {
+	uint32_t skipped_sector_count;
+	uint32_t written_sector_count;
+	uint32_t erased_block_count;
+} fw_update_diff_stat;
+
 enum DEVICE_POSITIONS {
 	DEVSPI_FMC_CS0,
 	DEVSPI_FMC_CS1,
@@ -60,6 +67,9 @@ bool pal_switch_pcie_switch_spi_mux(int gpio_status);
 int pal_get_cxl_flash_position();
 int do_update(const struct device *flash_device, off_t offset, uint8_t *buf, size_t len);
 void set_default_retry_count(int count);
+void set_fw_update_sub_sector_erase(bool enable);
+void get_fw_update_diff_stat(fw_update_diff_stat *stat);
+void reset_fw_update_diff_stat();
 int ckeck_flash_device_isinit(const struct device *flash_device, uint8_t flash_position);
 char *get_flash_device_string_by_index(uint8_t flash_index);
 
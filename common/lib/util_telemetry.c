@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zephyr.h>
+#include <stdlib.h>
+#include <string.h>
+#include "libutil.h"
+#include "util_telemetry.h"
+
+#include <logging/log.h>
+
+LOG_MODULE_REGISTER(util_telemetry);
+
+/* a reader only retries when a publish lands in the middle of its copy (SMP or thread reader) */
+#define TELEMETRY_READ_RETRY_MAX 3
+
+bool telemetry_table_init(telemetry_table *table, uint16_t size)
+{
+	CHECK_NULL_ARG_WITH_RETURN(table, false);
+
+	if (size == 0) {
+		LOG_ERR("Invalid telemetry table size");
+		return false;
+	}
+
+	/* a re-init keeps the old buffers, readers may still be copying from them */
+	if (table->shadow && table->size == size) {
+		k_mutex_lock(&table->lock, K_FOREVER);
+		memset(table->shadow, 0, size);
+		table->dirty = true;
+		k_mutex_unlock(&table->lock);
+		return true;
+	}
+
+	if (table->shadow) {
+		LOG_ERR("Telemetry table size can't change from %d to %d", table->size, size);
+		return false;
+	}
+
+	uint8_t *mem = malloc(size * 3);
+	if (!mem) {
+		LOG_ERR("Failed to allocate telemetry table, size %d", size);
+		return false;
+	}
+	memset(mem, 0, size * 3);
+
+	k_mutex_init(&table->lock);
+	table->buf[0] = mem;
+	table->buf[1] = mem + size;
+	table->dirty = false;
+	atomic_set(&table->generation, 0);
+	table->size = size;
+	/* shadow is set last, telemetry_table_read() treats a NULL shadow as not ready */
+	table->shadow = mem + (size * 2);
+
+	return true;
+}
+
+uint8_t *telemetry_table_write_begin(telemetry_table *table)
+{
+	CHECK_NULL_ARG_WITH_RETURN(table, NULL);
+
+	if (!table->shadow) {
+		return NULL;
+	}
+
+	k_mutex_lock(&table->lock, K_FOREVER);
+	return table->shadow;
+}
+
+void telemetry_table_write_end(telemetry_table *table)
+{
+	CHECK_NULL_ARG(table);
+
+	if (!table->shadow) {
+		return;
+	}
+
+	table->dirty = true;
+	k_mutex_unlock(&table->lock);
+}
+
+bool telemetry_table_publish(telemetry_table *table)
+{
+	CHECK_NULL_ARG_WITH_RETURN(table, false);
+
+	if (!table->shadow) {
+		return false;
+	}
+
+	k_mutex_lock(&table->lock, K_FOREVER);
+	if (!table->dirty) {
+		k_mutex_unlock(&table->lock);
+		return false;
+	}
+
+	uint32_t next = (uint32_t)atomic_get(&table->generation) + 1;
+	memcpy(table->buf[next & 1], table->shadow, table->size);
+	table->dirty = false;
+	/* the idle buffer is complete, make it live */
+	atomic_set(&table->generation, next);
+	k_mutex_unlock(&table->lock);
+
+	return true;
+}
+
+uint16_t telemetry_table_read(telemetry_table *table, uint16_t offset, uint8_t *dst, uint16_t len,
+			      uint32_t *generation)
+{
+	CHECK_NULL_ARG_WITH_RETURN(table, 0);
+	CHECK_NULL_ARG_WITH_RETURN(dst, 0);
+
+	if (!table->shadow || offset >= table->size) {
+		return 0;
+	}
+
+	len = MIN(len, table->size - offset);
+
+	for (uint8_t retry = 0; retry < TELEMETRY_READ_RETRY_MAX; retry++) {
+		uint32_t gen = (uint32_t)atomic_get(&table->generation);
+		memcpy(dst, table->buf[gen & 1] + offset, len);
+		if ((uint32_t)atomic_get(&table->generation) == gen) {
+			if (generation) {
+				*generation = gen;
+			}
+			return len;
+		}
+	}
+
+	/* publishes kept landing mid-copy, dst may be torn so don't hand it out */
+	return 0;
+}
+
+uint32_t telemetry_table_get_generation(telemetry_table *table)
+{
+	CHECK_NULL_ARG_WITH_RETURN(table, 0);
+
+	return (uint32_t)atomic_get(&table->generation);
+}
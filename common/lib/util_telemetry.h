@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTIL_TELEMETRY_H
+#define UTIL_TELEMETRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <zephyr.h>
+
+/*
+ * Double-buffered telemetry table.
+ *
+ * Writers update a private shadow copy between telemetry_table_write_begin() and
+ * telemetry_table_write_end(), then telemetry_table_publish() copies the shadow into the idle
+ * buffer and flips the generation counter. Readers always copy from buf[generation & 1], which is
+ * never written while it is live, so telemetry_table_read() needs no lock and is safe to call
+ * from an I2C target/ISR callback. It returns 0 instead of a torn copy if publishes keep landing
+ * in the middle of the copy.
+ */
+typedef struct {
+	uint8_t *shadow;
+	uint8_t *buf[2];
+	uint16_t size;
+	bool dirty;
+	atomic_t generation;
+	struct k_mutex lock;
+} telemetry_table;
+
+bool telemetry_table_init(telemetry_table *table, uint16_t size);
+uint8_t *telemetry_table_write_begin(telemetry_table *table);
+void telemetry_table_write_end(telemetry_table *table);
+bool telemetry_table_publish(telemetry_table *table);
+uint16_t telemetry_table_read(telemetry_table *table, uint16_t offset, uint8_t *dst, uint16_t len,
+			      uint32_t *generation);
+uint32_t telemetry_table_get_generation(telemetry_table *table);
+
+#endif
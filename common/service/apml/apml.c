@@ -16,6 +16,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <sys/byteorder.h>
 #include "hal_i2c.h"
 #include "apml.h"
 #include "power_status.h"
@@ -28,16 +29,28 @@
 
 LOG_MODULE_REGISTER(apml);
 
-#define RETRY_MAX 3
-#define CPUID_MCA_WAIT_MAX 10
-#define MAILBOX_COMPLETE_RETRY_MAX 200
 #define APML_RESP_BUFFER_SIZE 10
 #define APML_HANDLER_STACK_SIZE 2048
 #define APML_MSGQ_LEN 32
-#define WAIT_TIME_MS 10
-#define WAIT_CPUID_MCA_RESP_TIME_MS 50
 #define RECOVERY_SBRMI_RETRY_MAX 5
 
+/* Time budgets of the completion polls, equal to the former fixed retry loops */
+#define MAILBOX_PREV_CMD_TIMEOUT_MS 30
+#define MAILBOX_COMPLETE_TIMEOUT_MS 2000
+#define CPUID_MCA_TIMEOUT_MS 100
+
+/* Completion poll interval, doubled on every miss between these bounds */
+#ifndef APML_POLL_INTERVAL_MIN_US
+#define APML_POLL_INTERVAL_MIN_US 250
+#endif
+#ifndef APML_POLL_INTERVAL_MAX_US
+#define APML_POLL_INTERVAL_MAX_US 10000
+#endif
+/* Wait for CPU to fill out the response registers after HwAlert, platforms may lower it */
+#ifndef APML_CPUID_MCA_RESP_DELAY_MS
+#define APML_CPUID_MCA_RESP_DELAY_MS 50
+#endif
+
 struct k_msgq apml_msgq;
 struct k_thread apml_thread;
 char __aligned(4) apml_msgq_buffer[APML_MSGQ_LEN * sizeof(apml_msg)];
@@ -46,6 +59,10 @@ apml_buffer apml_resp_buffer[APML_RESP_BUFFER_SIZE];
 static bool is_fatal_error_happened;
 static int command_code_len = SBRMI_CMD_CODE_LEN_DEFAULT;
 static int apml_bus = APML_BUS_UNKNOWN;
+/* Serializes SB-RMI transactions of the handler thread and the synchronous batch APIs */
+K_MUTEX_DEFINE(apml_access_mutex);
+K_MUTEX_DEFINE(apml_submit_mutex);
+K_SEM_DEFINE(apml_alert_sem, 0, 1);
 
 uint8_t apml_read_byte(uint8_t bus, uint8_t addr, uint8_t offset, uint8_t *read_data)
 {
@@ -99,19 +116,47 @@ uint8_t apml_write_byte(uint8_t bus, uint8_t addr, uint8_t offset, uint8_t write
 	return APML_SUCCESS;
 }
 
-static bool wait_HwAlert_set(apml_msg *msg, uint8_t retry)
+/* Wakes up a completion poll early, safe to call from the APML alert ISR */
+void apml_alert_notify()
+{
+	k_sem_give(&apml_alert_sem);
+}
+
+/*
+ * Wait before the next completion poll. Most commands finish well within a millisecond,
+ * so start polling fast and double the interval up to APML_POLL_INTERVAL_MAX_US, unless
+ * the alert pin reports the completion first.
+ */
+static void apml_poll_backoff(uint32_t *interval_us)
+{
+	k_sem_take(&apml_alert_sem, K_USEC(*interval_us));
+	*interval_us = MIN(*interval_us * 2, APML_POLL_INTERVAL_MAX_US);
+}
+
+static bool apml_poll_reg(apml_msg *msg, uint8_t offset, uint8_t mask, uint8_t expect,
+			  uint32_t timeout_ms)
 {
 	CHECK_NULL_ARG_WITH_RETURN(msg, false);
 	uint8_t read_data = 0;
-	for (uint8_t i = 0; i < retry; i++) {
-		if (!apml_read_byte(msg->bus, msg->target_addr, SBRMI_STATUS, &read_data)) {
-			if (read_data & 0x80) {
+	uint32_t interval_us = APML_POLL_INTERVAL_MIN_US;
+	int64_t deadline = k_uptime_get() + timeout_ms;
+
+	while (1) {
+		if (!apml_read_byte(msg->bus, msg->target_addr, offset, &read_data)) {
+			if ((read_data & mask) == expect) {
 				return true;
 			}
 		}
-		k_msleep(WAIT_TIME_MS);
+		if (k_uptime_get() >= deadline) {
+			return false;
+		}
+		apml_poll_backoff(&interval_us);
 	}
-	return false;
+}
+
+static bool wait_HwAlert_set(apml_msg *msg, uint32_t timeout_ms)
+{
+	return apml_poll_reg(msg, SBRMI_STATUS, 0x80, 0x80, timeout_ms);
 }
 /****************** MCA *********************/
 
@@ -178,18 +223,21 @@ static uint8_t read_MCA_response(apml_msg *msg)
 static uint8_t access_MCA(apml_msg *msg)
 {
 	CHECK_NULL_ARG_WITH_RETURN(msg, APML_ERROR);
+	k_sem_reset(&apml_alert_sem);
 	if (write_MCA_request(msg)) {
 		LOG_ERR("Write MCA request failed.");
 		return APML_ERROR;
 	}
 
-	if (!wait_HwAlert_set(msg, CPUID_MCA_WAIT_MAX)) {
-		LOG_ERR("HwAlert not be set, retry %d times.", CPUID_MCA_WAIT_MAX);
+	if (!wait_HwAlert_set(msg, CPUID_MCA_TIMEOUT_MS)) {
+		LOG_ERR("HwAlert not be set in %d ms.", CPUID_MCA_TIMEOUT_MS);
 		return APML_ERROR;
 	}
 
 	/* wait for CPU to fill out registers */
-	k_msleep(WAIT_CPUID_MCA_RESP_TIME_MS);
+	if (APML_CPUID_MCA_RESP_DELAY_MS) {
+		k_msleep(APML_CPUID_MCA_RESP_DELAY_MS);
+	}
 	if (read_MCA_response(msg)) {
 		LOG_ERR("Read response failed.");
 		return APML_ERROR;
@@ -266,18 +314,21 @@ static uint8_t read_CPUID_response(apml_msg *msg)
 static uint8_t access_CPUID(apml_msg *msg)
 {
 	CHECK_NULL_ARG_WITH_RETURN(msg, APML_ERROR);
+	k_sem_reset(&apml_alert_sem);
 	if (write_CPUID_request(msg)) {
 		LOG_ERR("Write CPUID request failed.");
 		return APML_ERROR;
 	}
 
-	if (!wait_HwAlert_set(msg, CPUID_MCA_WAIT_MAX)) {
-		LOG_ERR("HwAlert not be set, retry %d times.", CPUID_MCA_WAIT_MAX);
+	if (!wait_HwAlert_set(msg, CPUID_MCA_TIMEOUT_MS)) {
+		LOG_ERR("HwAlert not be set in %d ms.", CPUID_MCA_TIMEOUT_MS);
 		return APML_ERROR;
 	}
 
 	/* wait for CPU to fill out registers */
-	k_msleep(WAIT_CPUID_MCA_RESP_TIME_MS);
+	if (APML_CPUID_MCA_RESP_DELAY_MS) {
+		k_msleep(APML_CPUID_MCA_RESP_DELAY_MS);
+	}
 	if (read_CPUID_response(msg)) {
 		LOG_ERR("Read CPUID response failed.");
 		return APML_ERROR;
@@ -292,20 +343,9 @@ static uint8_t access_CPUID(apml_msg *msg)
 
 /****************** RMI Mailbox**************/
 
-static bool check_mailbox_command_complete(apml_msg *msg, uint8_t retry)
+static bool check_mailbox_command_complete(apml_msg *msg, uint32_t timeout_ms)
 {
-	CHECK_NULL_ARG_WITH_RETURN(msg, false);
-	uint8_t read_data = 0;
-	for (uint8_t i = 0; i < retry; i++) {
-		if (!apml_read_byte(msg->bus, msg->target_addr, SBRMI_SOFTWARE_INTERRUPT,
-				    &read_data)) {
-			if (!(read_data & 0x01)) {
-				return true;
-			}
-		}
-		k_msleep(WAIT_TIME_MS);
-	}
-	return false;
+	return apml_poll_reg(msg, SBRMI_SOFTWARE_INTERRUPT, 0x01, 0x00, timeout_ms);
 }
 
 static uint8_t write_mailbox_request(apml_msg *msg)
@@ -365,13 +405,14 @@ static uint8_t read_mailbox_response(apml_msg *msg)
 static uint8_t access_RMI_mailbox(apml_msg *msg)
 {
 	CHECK_NULL_ARG_WITH_RETURN(msg, APML_ERROR);
-	int i = 0;
+	bool is_complete = false;
 
-	if (!check_mailbox_command_complete(msg, RETRY_MAX)) {
+	if (!check_mailbox_command_complete(msg, MAILBOX_PREV_CMD_TIMEOUT_MS)) {
 		LOG_ERR("Previous command not complete.");
 		return APML_ERROR;
 	}
 
+	k_sem_reset(&apml_alert_sem);
 	if (write_mailbox_request(msg)) {
 		LOG_ERR("Write request failed.");
 		return APML_ERROR;
@@ -381,7 +422,9 @@ static uint8_t access_RMI_mailbox(apml_msg *msg)
 
 	/* wait for SwAlertSts to be set */
 	uint8_t status;
-	for (i = 0; i < MAILBOX_COMPLETE_RETRY_MAX; i++) {
+	uint32_t interval_us = APML_POLL_INTERVAL_MIN_US;
+	int64_t deadline = k_uptime_get() + MAILBOX_COMPLETE_TIMEOUT_MS;
+	while (1) {
 		/* For TURIN, wait for SoftwareInterrupt */
 		if (command_code_len == SBRMI_CMD_CODE_LEN_TWO_BYTE) {
 			if (apml_read_byte(msg->bus, msg->target_addr, SBRMI_SOFTWARE_INTERRUPT,
@@ -390,6 +433,7 @@ static uint8_t access_RMI_mailbox(apml_msg *msg)
 				return APML_ERROR;
 			}
 			if ((status & 0x01) == 0) {
+				is_complete = true;
 				break;
 			}
 		} else {
@@ -398,22 +442,25 @@ static uint8_t access_RMI_mailbox(apml_msg *msg)
 				return APML_ERROR;
 			}
 			if (status & 0x02) {
+				is_complete = true;
 				break;
 			}
 		}
 
-		k_msleep(WAIT_TIME_MS);
+		if (k_uptime_get() >= deadline) {
+			break;
+		}
+		apml_poll_backoff(&interval_us);
 		if (!get_post_status()) {
 			return APML_ERROR;
 		}
 	}
-	if (i == MAILBOX_COMPLETE_RETRY_MAX) {
+	if (!is_complete) {
 		if (command_code_len == SBRMI_CMD_CODE_LEN_TWO_BYTE) {
-			LOG_ERR("SoftwareInterrupt not be set, retry %d times.",
-				MAILBOX_COMPLETE_RETRY_MAX);
+			LOG_ERR("SoftwareInterrupt not be set in %d ms.",
+				MAILBOX_COMPLETE_TIMEOUT_MS);
 		} else {
-			LOG_ERR("SwAlertSts not be set, retry %d times.",
-				MAILBOX_COMPLETE_RETRY_MAX);
+			LOG_ERR("SwAlertSts not be set in %d ms.", MAILBOX_COMPLETE_TIMEOUT_MS);
 		}
 		return APML_ERROR;
 	}
@@ -464,13 +511,97 @@ uint8_t get_apml_response_by_index(apml_msg *msg, uint8_t index)
 uint8_t apml_read(apml_msg *msg)
 {
 	CHECK_NULL_ARG_WITH_RETURN(msg, APML_ERROR);
-	if (k_msgq_put(&apml_msgq, msg, K_NO_WAIT)) {
+	k_mutex_lock(&apml_submit_mutex, K_FOREVER);
+	int ret = k_msgq_put(&apml_msgq, msg, K_NO_WAIT);
+	k_mutex_unlock(&apml_submit_mutex);
+	if (ret) {
 		LOG_ERR("Put msg to apml_msgq failed.");
 		return APML_ERROR;
 	}
 	return APML_SUCCESS;
 }
 
+/*
+ * Queue all messages back to back, or none of them if the queue lacks room. apml_msg is packed
+ * but 4-byte aligned, so it can't form an array and the messages are passed by pointer.
+ */
+uint8_t apml_read_batch(apml_msg *const *msgs, uint8_t count)
+{
+	CHECK_NULL_ARG_WITH_RETURN(msgs, APML_ERROR);
+	uint8_t ret = APML_SUCCESS;
+
+	for (uint8_t i = 0; i < count; i++) {
+		CHECK_NULL_ARG_WITH_RETURN(msgs[i], APML_ERROR);
+	}
+
+	k_mutex_lock(&apml_submit_mutex, K_FOREVER);
+	if (k_msgq_num_free_get(&apml_msgq) < count) {
+		LOG_ERR("No room for %d msgs in apml_msgq.", count);
+		ret = APML_ERROR;
+		goto unlock;
+	}
+	for (uint8_t i = 0; i < count; i++) {
+		if (k_msgq_put(&apml_msgq, msgs[i], K_NO_WAIT)) {
+			LOG_ERR("Put msg %d to apml_msgq failed.", i);
+			ret = APML_ERROR;
+			break;
+		}
+	}
+
+unlock:
+	k_mutex_unlock(&apml_submit_mutex);
+	return ret;
+}
+
+/*
+ * Read a list of MCA registers of one thread synchronously from the caller thread, e.g. for
+ * a crashdump. The bus is held for the whole list, so the registers are not interleaved with
+ * queued requests and no callback or response buffer is involved. Returns the number of
+ * registers read; it stops at the first failure.
+ */
+uint8_t apml_read_mca_batch(uint8_t bus, uint8_t target_addr, uint16_t thread,
+			    const uint32_t *register_addr, uint8_t count, mca_RdData *resp)
+{
+	CHECK_NULL_ARG_WITH_RETURN(register_addr, 0);
+	CHECK_NULL_ARG_WITH_RETURN(resp, 0);
+
+	apml_msg msg = { 0 };
+	uint8_t i = 0;
+
+	msg.msg_type = APML_MSG_TYPE_MCA;
+	msg.bus = bus;
+	msg.target_addr = target_addr;
+
+	k_mutex_lock(&apml_access_mutex, K_FOREVER);
+	for (; i < count; i++) {
+		if (get_post_status() == false) {
+			break;
+		}
+
+		if ((command_code_len == SBRMI_CMD_CODE_LEN_TWO_BYTE) &&
+		    (target_addr == SB_RMI_ADDR)) {
+			mca_WrData_TwoPOne *wr_data = (mca_WrData_TwoPOne *)msg.WrData;
+			wr_data->thread[0] = thread & 0xFF;
+			wr_data->thread[1] = (thread >> 8) & 0xFF;
+			sys_put_le32(register_addr[i], wr_data->register_addr);
+		} else {
+			mca_WrData *wr_data = (mca_WrData *)msg.WrData;
+			wr_data->thread = thread & 0xFF;
+			sys_put_le32(register_addr[i], wr_data->register_addr);
+		}
+
+		if (access_MCA(&msg)) {
+			LOG_ERR("Read MCA register 0x%x failed.", register_addr[i]);
+			apml_recovery();
+			break;
+		}
+		memcpy(&resp[i], msg.RdData, sizeof(mca_RdData));
+	}
+	k_mutex_unlock(&apml_access_mutex);
+
+	return i;
+}
+
 __weak int pal_check_sbrmi_command_code_length()
 {
 	command_code_len = SBRMI_CMD_CODE_LEN_DEFAULT;
@@ -501,10 +632,10 @@ static void apml_handler(void *arvg0, void *arvg1, void *arvg2)
 			if (msg_data.error_cb_fn) {
 				msg_data.error_cb_fn(&msg_data);
 			}
-			k_msleep(10);
 			continue;
 		}
 
+		k_mutex_lock(&apml_access_mutex, K_FOREVER);
 		switch (msg_data.msg_type) {
 		case APML_MSG_TYPE_MAILBOX:
 			ret = access_RMI_mailbox(&msg_data);
@@ -518,19 +649,21 @@ static void apml_handler(void *arvg0, void *arvg1, void *arvg2)
 		default:
 			break;
 		}
+		if (ret) {
+			apml_recovery();
+		}
+		k_mutex_unlock(&apml_access_mutex);
 
 		if (ret) {
 			LOG_ERR("APML access failed, msg type %d.", msg_data.msg_type);
 			if (msg_data.error_cb_fn) {
 				msg_data.error_cb_fn(&msg_data);
 			}
-			apml_recovery();
 		} else {
 			if (msg_data.cb_fn) {
 				msg_data.cb_fn(&msg_data);
 			}
 		}
-		k_msleep(10);
 	}
 }
 
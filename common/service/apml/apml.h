@@ -154,6 +154,10 @@ uint8_t apml_write_byte(uint8_t bus, uint8_t addr, uint8_t offset, uint8_t write
 void apml_request_callback(const apml_msg *msg);
 uint8_t get_apml_response_by_index(apml_msg *msg, uint8_t index);
 uint8_t apml_read(apml_msg *msg);
+uint8_t apml_read_batch(apml_msg *const *msgs, uint8_t count);
+uint8_t apml_read_mca_batch(uint8_t bus, uint8_t target_addr, uint16_t thread,
+			    const uint32_t *register_addr, uint8_t count, mca_RdData *resp);
+void apml_alert_notify();
 void apml_init();
 void fatal_error_happened();
 void apml_recovery();
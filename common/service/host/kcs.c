@@ -42,6 +42,70 @@ LOG_MODULE_REGISTER(kcs);
 kcs_dev *kcs;
 static bool proc_kcs_ok = false;
 
+static bool is_latency_mode = false;
+static kcs_latency_stat latency_stat[KCS_LATENCY_CMD_NUM];
+static uint8_t latency_stat_num;
+K_MUTEX_DEFINE(kcs_latency_mutex);
+
+static void kcs_record_latency(uint8_t netfn, uint8_t cmd, uint32_t elapsed_us)
+{
+	k_mutex_lock(&kcs_latency_mutex, K_FOREVER);
+
+	kcs_latency_stat *stat = NULL;
+	for (uint8_t i = 0; i < latency_stat_num; i++) {
+		if ((latency_stat[i].netfn == netfn) && (latency_stat[i].cmd == cmd)) {
+			stat = &latency_stat[i];
+			break;
+		}
+	}
+
+	if ((stat == NULL) && (latency_stat_num < KCS_LATENCY_CMD_NUM)) {
+		stat = &latency_stat[latency_stat_num++];
+		memset(stat, 0, sizeof(kcs_latency_stat));
+		stat->netfn = netfn;
+		stat->cmd = cmd;
+		stat->min_us = UINT32_MAX;
+	}
+
+	if (stat) {
+		stat->count++;
+		stat->min_us = MIN(stat->min_us, elapsed_us);
+		stat->max_us = MAX(stat->max_us, elapsed_us);
+		stat->total_us += elapsed_us;
+	}
+
+	k_mutex_unlock(&kcs_latency_mutex);
+}
+
+void kcs_set_latency_mode(bool enable)
+{
+	is_latency_mode = enable;
+}
+
+bool kcs_get_latency_mode(void)
+{
+	return is_latency_mode;
+}
+
+uint8_t kcs_get_latency_stat(kcs_latency_stat *stat, uint8_t max_num)
+{
+	CHECK_NULL_ARG_WITH_RETURN(stat, 0);
+
+	k_mutex_lock(&kcs_latency_mutex, K_FOREVER);
+	uint8_t num = MIN(max_num, latency_stat_num);
+	memcpy(stat, latency_stat, num * sizeof(kcs_latency_stat));
+	k_mutex_unlock(&kcs_latency_mutex);
+
+	return num;
+}
+
+void kcs_reset_latency_stat(void)
+{
+	k_mutex_lock(&kcs_latency_mutex, K_FOREVER);
+	latency_stat_num = 0;
+	k_mutex_unlock(&kcs_latency_mutex);
+}
+
 int kcs_write(uint8_t index, uint8_t *buf, uint32_t buf_sz)
 {
 	int rc;
@@ -52,6 +116,14 @@ int kcs_write(uint8_t index, uint8_t *buf, uint32_t buf_sz)
 		return rc;
 	}
 
+	/* request-to-response time as the host sees it, except the wait for the poll */
+	if (is_latency_mode && kcs[index].is_req_pending && (buf_sz >= 2) &&
+	    ((buf[0] >> 2) == (kcs[index].req_netfn | BIT(0))) && (buf[1] == kcs[index].req_cmd)) {
+		kcs[index].is_req_pending = false;
+		kcs_record_latency(kcs[index].req_netfn, kcs[index].req_cmd,
+				   k_cyc_to_us_floor32(k_cycle_get_32() - kcs[index].req_cycle));
+	}
+
 	return 0;
 }
 
@@ -440,8 +512,16 @@ static void kcs_read_task(void *arvg0, void *arvg1, void *arvg2)
 		return;
 	}
 
+	kcs_inst->last_rx_ms = k_uptime_get() - KCS_ACTIVE_WINDOW_MS;
+	rc = -ENODATA;
+
 	while (1) {
-		k_msleep(KCS_POLLING_INTERVAL);
+		/* Read again right away after a request, poll fast while the host is active */
+		if (rc <= 0) {
+			bool is_active =
+				((k_uptime_get() - kcs_inst->last_rx_ms) < KCS_ACTIVE_WINDOW_MS);
+			k_msleep(is_active ? KCS_ACTIVE_POLLING_INTERVAL : KCS_POLLING_INTERVAL);
+		}
 
 		rc = kcs_aspeed_read(kcs_inst->dev, ibuf, sizeof(ibuf));
 		if (rc < 0) {
@@ -452,6 +532,14 @@ static void kcs_read_task(void *arvg0, void *arvg1, void *arvg2)
 
 		LOG_HEXDUMP_DBG(&ibuf[0], rc, "host KCS read dump data:");
 
+		kcs_inst->last_rx_ms = k_uptime_get();
+		if (is_latency_mode && (rc >= 2)) {
+			kcs_inst->req_netfn = ibuf[0] >> 2;
+			kcs_inst->req_cmd = ibuf[1];
+			kcs_inst->req_cycle = k_cycle_get_32();
+			kcs_inst->is_req_pending = true;
+		}
+
 		proc_kcs_ok = true;
 		const struct kcs_request *req = (struct kcs_request *)ibuf;
 		const uint8_t netfn_no_lun = req->netfn >> 2;
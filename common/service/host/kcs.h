@@ -26,6 +26,13 @@
 
 #define KCS_POLL_STACK_SIZE 4096
 #define KCS_POLLING_INTERVAL 100
+/* Poll faster for a while after a request, the host usually sends the next one right away */
+#ifndef KCS_ACTIVE_POLLING_INTERVAL
+#define KCS_ACTIVE_POLLING_INTERVAL 1
+#endif
+#ifndef KCS_ACTIVE_WINDOW_MS
+#define KCS_ACTIVE_WINDOW_MS 2000
+#endif
 #define KCS_BUFF_SIZE 256
 #define KCS_MAX_CHANNEL_NUM 0x0F
 
@@ -36,6 +43,7 @@
 #define MAX_KCS_WORK_COUNT 5
 #define KCS_WORKER_STACK_SIZE 2048
 #define ADD_SEL_EVENT_DATA_MAX_LEN 18
+#define KCS_LATENCY_CMD_NUM 16
 
 typedef struct _kcs_dev {
 	const struct device *dev;
@@ -44,8 +52,23 @@ typedef struct _kcs_dev {
 	K_KERNEL_STACK_MEMBER(task_stack, KCS_POLL_STACK_SIZE);
 	uint8_t task_name[KCS_TASK_NAME_LEN];
 	struct k_thread task_thread;
+	int64_t last_rx_ms;
+	/* request waiting for its response, for latency mode */
+	bool is_req_pending;
+	uint8_t req_netfn;
+	uint8_t req_cmd;
+	uint32_t req_cycle;
 } kcs_dev;
 
+typedef struct _kcs_latency_stat {
+	uint8_t netfn;
+	uint8_t cmd;
+	uint32_t count;
+	uint32_t min_us;
+	uint32_t max_us;
+	uint64_t total_us;
+} kcs_latency_stat;
+
 struct kcs_request {
 	uint8_t netfn;
 	uint8_t cmd;
@@ -80,6 +103,10 @@ void kcs_device_init(char **config, uint8_t size);
 int kcs_write(uint8_t index, uint8_t *buf, uint32_t buf_sz);
 bool get_kcs_ok();
 void reset_kcs_ok();
+void kcs_set_latency_mode(bool enable);
+bool kcs_get_latency_mode(void);
+uint8_t kcs_get_latency_stat(kcs_latency_stat *stat, uint8_t max_num);
+void kcs_reset_latency_stat(void);
 
 #endif
 
@@ -49,7 +49,7 @@ LOG_MODULE_REGISTER(ipmb);
  */
 #if MAX_IPMB_IDX
 
-static struct k_mutex mutex_id[MAX_IPMB_IDX]; // mutex for sequence linked list insert/find
+static struct k_mutex mutex_id[MAX_IPMB_IDX]; // mutex for request record insert/find
 static struct k_mutex mutex_send_req[MAX_IPMB_IDX], mutex_send_res, mutex_read;
 static const struct device *dev_ipmb[I2C_BUS_MAX_NUM];
 
@@ -72,15 +72,26 @@ static k_tid_t IPMB_TX_ID[MAX_IPMB_IDX];
 static bool ipmb_tx_disable[MAX_IPMB_IDX];
 
 IPMB_config *IPMB_config_table;
-ipmi_msg_cfg *P_start[MAX_IPMB_IDX],
-	*P_temp; // pointer for sequence queue(link list)
-static unsigned int seq_current_count[MAX_IPMB_IDX] = { 0 };
-static uint32_t tick_fix;
-static uint32_t sys_tick_freq;
+
+/* Outstanding request, indexed by the 6-bit target sequence number */
+typedef struct _ipmb_req_record {
+	bool in_use;
+	uint8_t netfn;
+	uint8_t cmd;
+	uint8_t seq_source;
+	uint8_t pldm_inst_id;
+	uint8_t InF_source;
+	uint8_t InF_target;
+	uint8_t wheel_slot;
+} ipmb_req_record;
+
+static ipmb_req_record req_record[MAX_IPMB_IDX][SEQ_NUM];
+/* Timer wheel, each slot holds a bitmap of the sequence numbers expiring at that tick */
+static uint64_t req_wheel[MAX_IPMB_IDX][IPMB_REQ_WHEEL_SIZE];
+static uint8_t req_wheel_tick = 0;
 
 static uint8_t current_seq[MAX_IPMB_IDX]; // Sequence in BIC for sending
 	// sequence to other IPMB devices
-static bool seq_table[MAX_IPMB_IDX][SEQ_NUM]; // Sequence table in BIC for register record
 
 ipmb_error validate_checksum(uint8_t *buffer, uint8_t buffer_len);
 ipmb_error ipmb_encode(uint8_t *buffer, ipmi_msg *msg);
@@ -139,14 +150,12 @@ ipmb_error validate_checksum(uint8_t *buffer, uint8_t buffer_len)
 	return IPMB_ERROR_MSG_CHECKSUM;
 }
 
-void unregister_seq(uint8_t index, uint8_t seq_num)
+static void remove_req_record(uint8_t index, uint8_t seq_num)
 {
-	seq_table[index][seq_num] = 0;
-}
+	ipmb_req_record *record = &req_record[index][seq_num];
 
-void register_seq(uint8_t index, uint8_t seq_num)
-{
-	seq_table[index][seq_num] = 1;
+	req_wheel[index][record->wheel_slot] &= ~((uint64_t)1 << seq_num);
+	record->in_use = false;
 }
 
 uint8_t get_free_seq(uint8_t index)
@@ -155,7 +164,7 @@ uint8_t get_free_seq(uint8_t index)
 
 	do {
 		current_seq[index] = (current_seq[index] + 1) & 0x3f;
-		if (!seq_table[index][current_seq[index]]) {
+		if (!req_record[index][current_seq[index]].in_use) {
 			break;
 		}
 
@@ -171,69 +180,47 @@ uint8_t get_free_seq(uint8_t index)
 
 /* Record IPMB request for checking response sequence and finding source
  * sequence for bridge command */
-void insert_req_ipmi_msg(ipmi_msg_cfg *pnode, ipmi_msg *msg, uint8_t index)
+void insert_req_ipmi_msg(ipmi_msg *msg, uint8_t index)
 {
-	CHECK_NULL_ARG(pnode);
 	CHECK_NULL_ARG(msg);
 
-	ipmi_msg_cfg *ptr_start = pnode;
+	uint8_t seq_num = msg->seq_target & (SEQ_NUM - 1);
 	int ret;
 
 	ret = k_mutex_lock(&mutex_id[index], K_MSEC(1000));
 	if (ret) {
 		LOG_ERR("Failed to lock the mutex(%d)", ret);
 		return;
-	} else {
-		// No more room, remove the first node.
-		if (seq_current_count[index] == MAX_SEQ_QUENE) {
-			ipmi_msg_cfg *temp;
-			temp = pnode->next;
-			if (temp == NULL) {
-				LOG_ERR("Not a circular linked list");
-				k_mutex_unlock(&mutex_id[index]);
-				return;
-			}
-			pnode->next = temp->next;
-			SAFE_FREE(temp);
-			seq_current_count[index]--;
-		}
-
-		while (pnode && pnode->next != ptr_start) {
-			pnode = pnode->next;
-		}
-
-		if (pnode == NULL) {
-			LOG_ERR("Not a circular linked list");
-			k_mutex_unlock(&mutex_id[index]);
-			return;
-		}
+	}
 
-		/* Allocate memory for the new node and put data in it.*/
-		pnode->next = malloc(sizeof(ipmi_msg_cfg));
-		if (pnode->next == NULL) {
-			k_mutex_unlock(&mutex_id[index]);
-			return;
-		}
-		pnode = pnode->next;
+	ipmb_req_record *record = &req_record[index][seq_num];
+	if (record->in_use) {
+		// No free sequence left, the oldest request on this sequence is dropped
+		LOG_WRN("IPMB[%x] seq %d still in use, netfn: %x, cmd: %x", index, seq_num,
+			record->netfn, record->cmd);
+		remove_req_record(index, seq_num);
+	}
 
-		msg->timestamp = osKernelGetSysTimerCount();
-		memcpy(&pnode->buffer, msg, sizeof(ipmi_msg));
-		register_seq(index, pnode->buffer.seq_target);
+	msg->timestamp = osKernelGetSysTimerCount();
+	record->netfn = msg->netfn;
+	record->cmd = msg->cmd;
+	record->seq_source = msg->seq_source;
+	record->pldm_inst_id = msg->pldm_inst_id;
+	record->InF_source = msg->InF_source;
+	record->InF_target = msg->InF_target;
+	record->wheel_slot = (req_wheel_tick + IPMB_REQ_TIMEOUT_TICKS) % IPMB_REQ_WHEEL_SIZE;
+	record->in_use = true;
+	req_wheel[index][record->wheel_slot] |= ((uint64_t)1 << seq_num);
 
-		pnode->next = ptr_start;
-		seq_current_count[index]++;
-		k_mutex_unlock(&mutex_id[index]);
-		return;
-	}
+	k_mutex_unlock(&mutex_id[index]);
 }
 
 /* Find if any IPMB request record match receiving response */
-bool find_req_ipmi_msg(ipmi_msg_cfg *pnode, ipmi_msg *msg, uint8_t index)
+bool find_req_ipmi_msg(ipmi_msg *msg, uint8_t index)
 {
-	CHECK_NULL_ARG_WITH_RETURN(pnode, false);
 	CHECK_NULL_ARG_WITH_RETURN(msg, false);
 
-	ipmi_msg_cfg *ptr_start = pnode;
+	uint8_t seq_num = msg->seq_target & (SEQ_NUM - 1);
 	int ret;
 
 	ret = k_mutex_lock(&mutex_id[index], K_MSEC(1000));
@@ -242,86 +229,45 @@ bool find_req_ipmi_msg(ipmi_msg_cfg *pnode, ipmi_msg *msg, uint8_t index)
 		return false;
 	}
 
-	while ((pnode != NULL && pnode->next != ptr_start) &&
-	       (((pnode->next)->buffer.netfn != (msg->netfn & (~0x01))) ||
-		((pnode->next)->buffer.cmd != msg->cmd) ||
-		((pnode->next)->buffer.seq_target != msg->seq_target))) {
-		pnode = pnode->next;
-	}
-
-	if (pnode == NULL) {
-		LOG_ERR("pnode list should be circular, list end found");
-		k_mutex_unlock(&mutex_id[index]);
-		return false;
-	}
-
-	if (pnode->next == ptr_start) {
+	ipmb_req_record *record = &req_record[index][seq_num];
+	if (!record->in_use || (record->netfn != (msg->netfn & (~0x01))) ||
+	    (record->cmd != msg->cmd)) {
 		LOG_ERR("no req match recv resp");
-		LOG_ERR("node netfn: %x,cmd: %x, seq_t: %x", (pnode->next)->buffer.netfn,
-			(pnode->next)->buffer.cmd, (pnode->next)->buffer.seq_target);
+		LOG_ERR("node netfn: %x,cmd: %x, seq_t: %x, in use: %d", record->netfn,
+			record->cmd, seq_num, record->in_use);
 		LOG_ERR("msg netfn: %x,cmd: %x, seq_t: %x", msg->netfn, msg->cmd, msg->seq_target);
 		k_mutex_unlock(&mutex_id[index]);
 		return false;
 	}
 
-	/* Now pointer points to a node and the node next to it has to be removed */
-	ipmi_msg_cfg *temp;
-	temp = pnode->next;
-
-	if (temp == NULL) {
-		LOG_ERR("pnode list should be circular, list end found");
-		k_mutex_unlock(&mutex_id[index]);
-		return false;
-	}
-
 	// find source sequence for responding
-	msg->seq_source = temp->buffer.seq_source;
-	unregister_seq(index, temp->buffer.seq_target);
-
-	msg->pldm_inst_id = temp->buffer.pldm_inst_id;
-	msg->InF_source = temp->buffer.InF_source;
-	msg->InF_target = temp->buffer.InF_target;
-	/*temp points to the node which has to be removed*/
-	pnode->next = temp->next;
-	/*We removed the node which is next to the pointer (which is also temp) */
-
-	/* Because we deleted the node, we no longer require the memory used for it
-   * free() will deallocate the memory.
-   */
-	SAFE_FREE(temp);
-	seq_current_count[index]--;
+	msg->seq_source = record->seq_source;
+	msg->pldm_inst_id = record->pldm_inst_id;
+	msg->InF_source = record->InF_source;
+	msg->InF_target = record->InF_target;
+	remove_req_record(index, seq_num);
 
 	k_mutex_unlock(&mutex_id[index]);
 	return true;
 }
 
-void clear_req_ipmi_msg(ipmi_msg_cfg *pnode, ipmi_msg *msg, uint8_t index)
+void clear_req_ipmi_msg(ipmi_msg *msg, uint8_t index)
 {
-	CHECK_NULL_ARG(pnode);
 	CHECK_NULL_ARG(msg);
 
+	uint8_t seq_num = msg->seq & (SEQ_NUM - 1);
 	int ret = 0;
 
-	// Mutex for request sequence linked list change
+	// Mutex for request record change
 	ret = k_mutex_lock(&mutex_id[index], K_MSEC(1000));
 	if (ret) {
 		LOG_ERR("Failed to lock the mutex id%d, ret%d", index, ret);
 		return;
 	}
 
-	ipmi_msg_cfg *temp = NULL;
-	while (pnode->next != P_start[index]) {
-		temp = pnode->next;
-		if ((temp->buffer.netfn == msg->netfn) && (temp->buffer.cmd == msg->cmd) &&
-		    (temp->buffer.seq == msg->seq)) {
-			pnode->next = temp->next;
-			unregister_seq(index, temp->buffer.seq_target);
-			SAFE_FREE(temp);
-			seq_current_count[index]--;
-			break;
-		}
-
-		pnode = pnode->next;
+	ipmb_req_record *record = &req_record[index][seq_num];
+	if (record->in_use && (record->netfn == msg->netfn) && (record->cmd == msg->cmd)) {
+		remove_req_record(index, seq_num);
 	}
 
 	k_mutex_unlock(&mutex_id[index]);
@@ -482,8 +428,7 @@ void IPMB_TXTask(void *pvParameters, void *arvg0, void *arvg1)
 				memcpy(&i2c_msg->data[0], &ipmb_buffer_tx[1], req_tx_size);
 
 				current_msg_tx->buffer.seq_target = current_msg_tx->buffer.seq;
-				insert_req_ipmi_msg(P_start[ipmb_cfg.index],
-						    &current_msg_tx->buffer, ipmb_cfg.index);
+				insert_req_ipmi_msg(&current_msg_tx->buffer, ipmb_cfg.index);
 				if (DEBUG_IPMB) {
 					LOG_DBG("Send a request message, from(%d) to(%d) netfn(0x%x) cmd(0x%x) CC(0x%x)",
 						current_msg_tx->buffer.InF_source,
@@ -509,8 +454,7 @@ void IPMB_TXTask(void *pvParameters, void *arvg0, void *arvg1)
 			}
 
 			if (ret) {
-				find_req_ipmi_msg(P_start[ipmb_cfg.index],
-						  &(current_msg_tx->buffer), ipmb_cfg.index);
+				find_req_ipmi_msg(&(current_msg_tx->buffer), ipmb_cfg.index);
 
 				current_msg_tx->retries += 1;
 
@@ -688,8 +632,7 @@ void IPMB_RXTask(void *pvParameters, void *arvg0, void *arvg1)
 			if (IS_RESPONSE(current_msg_rx->buffer)) { // Response message
 				/* Find the corresponding request message*/
 				current_msg_rx->buffer.seq_target = current_msg_rx->buffer.seq;
-				if (find_req_ipmi_msg(P_start[ipmb_cfg.index],
-						      &(current_msg_rx->buffer), ipmb_cfg.index)) {
+				if (find_req_ipmi_msg(&(current_msg_rx->buffer), ipmb_cfg.index)) {
 					if (DEBUG_IPMB) {
 						LOG_DBG("Found the corresponding request message, from(0x%x) to(0x%x) target_seq_num(%d)",
 							current_msg_rx->buffer.InF_source,
@@ -1063,7 +1006,7 @@ ipmb_error ipmb_read(ipmi_msg *msg, uint8_t index)
 	if (k_msgq_get(&ipmb_rxqueue[index], (ipmi_msg *)msg, K_MSEC(IPMB_SEQ_TIMEOUT_MS))) {
 		LOG_ERR("Failed to get IPMB message from RX queue, netfn0x%02x cmd0x%02x seq%d",
 			msg->netfn, msg->cmd, msg->seq);
-		clear_req_ipmi_msg(P_start[index], (ipmi_msg *)msg, index);
+		clear_req_ipmi_msg((ipmi_msg *)msg, index);
 		ret = IPMB_ERROR_GET_MESSAGE_QUEUE;
 		goto exit;
 	}
@@ -1129,46 +1072,35 @@ ipmb_error ipmb_decode(ipmi_msg *msg, uint8_t *buffer, uint8_t len)
 
 void IPMB_SeqTimeout_handler(void *arug0, void *arug1, void *arug2)
 {
-	ipmi_msg_cfg *pnode;
 	int ret;
-	uint8_t index;
-	uint32_t current_time;
+	uint8_t index, seq_num;
+	uint64_t expired;
 
 	while (1) {
-		k_msleep(IPMB_SEQ_TIMEOUT_MS);
+		k_msleep(IPMB_REQ_WHEEL_TICK_MS);
+		req_wheel_tick = (req_wheel_tick + 1) % IPMB_REQ_WHEEL_SIZE;
+
 		for (index = 0; index < MAX_IPMB_IDX; index++) {
 			if (!IPMB_config_table[index].enable_status) {
 				continue;
 			}
 
 			ret = k_mutex_lock(&mutex_id[index], K_MSEC(1000));
-
 			if (ret) {
 				LOG_ERR("Failed to lock the mutex, ret(%d)", ret);
-			} else {
-				pnode = P_start[index];
-				while (pnode->next != P_start[index]) {
-					current_time = osKernelGetSysTimerCount();
-					// The queue stay more than 1000 ms need to be killed
-					if (current_time + tick_fix -
-							    ((pnode->next)->buffer.timestamp) >
-						    (IPMB_SEQ_TIMEOUT_MS / 1000) * sys_tick_freq ||
-					    (current_time + tick_fix -
-					     ((pnode->next)->buffer.timestamp)) &
-						    0x80000000) {
-						ipmi_msg_cfg *temp;
-						temp = pnode->next;
-						pnode->next = temp->next;
-						unregister_seq(index, temp->buffer.seq_target);
-						SAFE_FREE(temp);
-						seq_current_count[index]--;
-					}
+				continue;
+			}
 
-					pnode = pnode->next;
+			// Requests in this slot stay more than IPMB_SEQ_TIMEOUT_MS
+			expired = req_wheel[index][req_wheel_tick];
+			req_wheel[index][req_wheel_tick] = 0;
+			for (seq_num = 0; expired != 0; seq_num++, expired >>= 1) {
+				if (expired & 1) {
+					req_record[index][seq_num].in_use = false;
 				}
-
-				k_mutex_unlock(&mutex_id[index]);
 			}
+
+			k_mutex_unlock(&mutex_id[index]);
 		}
 	}
 }
@@ -1234,16 +1166,8 @@ void create_ipmb_threads(uint8_t index)
 
 	memset(&IPMB_TxTask_attr, 0, sizeof(IPMB_TxTask_attr));
 	memset(&IPMB_RxTask_attr, 0, sizeof(IPMB_RxTask_attr));
-	memset(&seq_table[index], 0, sizeof(bool) * SEQ_NUM);
-
-	P_start[index] = (void *)malloc(sizeof(struct ipmi_msg_cfg));
-	if (P_start[index] == NULL) {
-		LOG_ERR("Memory allocation failed!");
-		return;
-	}
-
-	P_temp = P_start[index];
-	P_temp->next = P_temp;
+	memset(&req_record[index], 0, sizeof(ipmb_req_record) * SEQ_NUM);
+	memset(&req_wheel[index], 0, sizeof(uint64_t) * IPMB_REQ_WHEEL_SIZE);
 
 	int i = 0, retry = 3;
 	for (i = 0; i <= retry; ++i) {
@@ -1332,10 +1256,6 @@ void ipmb_init(void)
 
 	memset(&current_seq, 0, sizeof(uint8_t) * MAX_IPMB_IDX);
 
-	// Get the RTOS kernel system timer
-	sys_tick_freq = osKernelGetSysTimerFreq();
-	tick_fix = sys_tick_freq / 1000;
-
 	// Initial mutex
 	for (i = 0; i < MAX_IPMB_IDX; i++) {
 		if (k_mutex_init(&mutex_send_req[i])) {
@@ -63,7 +63,6 @@
 #define DEBUG_IPMB 0
 
 #define SEQ_NUM 64
-#define MAX_SEQ_QUENE 15
 #define MEM_ALLOCATE_RETRY_TIME 2
 #define IPMI_DATA_MAX_LENGTH 520
 #define IPMB_REQ_HEADER_LENGTH 6
@@ -82,6 +81,10 @@
 #define IPMB_RETRY_DELAY_MS 500
 #define IPMB_POLLING_TIME_MS 1
 #define IPMB_SEQ_TIMEOUT_MS 3000
+/* A request expires between IPMB_SEQ_TIMEOUT_MS and one wheel tick later */
+#define IPMB_REQ_WHEEL_SIZE 8
+#define IPMB_REQ_WHEEL_TICK_MS (IPMB_SEQ_TIMEOUT_MS / 4)
+#define IPMB_REQ_TIMEOUT_TICKS 5
 #define IPMB_SEQ_TIMEOUT_STACK_SIZE 512
 #define I2C_RETRY_TIME 5
 
@@ -189,7 +192,6 @@ typedef struct ipmi_msg {
 typedef struct ipmi_msg_cfg {
 	ipmi_msg buffer; /**< IPMI Message */
 	uint8_t retries; /**< Current retry counter */
-	struct ipmi_msg_cfg *next;
 } __attribute__((packed, aligned(4))) ipmi_msg_cfg;
 
 bool pal_load_ipmb_config(void);
@@ -22,8 +22,31 @@
 #include "plat_version.h"
 
 #define IPMI_THREAD_STACK_SIZE 4096
+#ifndef IPMI_BUF_LEN
 #define IPMI_BUF_LEN 10
+#endif
 #define IPMI_HANDLE_THREAD_STACK_SIZE 4096
+#define IPMI_HANDLE_TIMEOUT_S 10
+
+/*
+ * Slow commands (PECI, APML, JTAG, flash...) run on their own workers, concurrently with the
+ * other commands. Off by default, a platform whose handlers don't rely on serialized execution
+ * opts in from plat_def.h. Each worker costs two thread stacks.
+ */
+#ifndef IPMI_SLOW_WORKER_NUM
+#define IPMI_SLOW_WORKER_NUM 0
+#endif
+#ifndef IPMI_SLOW_BUF_LEN
+#define IPMI_SLOW_BUF_LEN 10
+#endif
+#define IPMI_SLOW_WORKER_STACK_SIZE 2048
+
+/* Latency is kept for the first IPMI_LATENCY_CMD_NUM netfn/cmd pairs seen */
+#ifndef IPMI_LATENCY_CMD_NUM
+#define IPMI_LATENCY_CMD_NUM 16
+#endif
+/* bucket i counts handling time below 4^i ms, the last one counts the rest */
+#define IPMI_LATENCY_BUCKET_NUM 8
 #ifndef IANA_ID
 #define IANA_ID 0x00A015 // Meta's IANA
 #endif
@@ -50,6 +73,17 @@ struct ipmi_response {
 	uint8_t data[0];
 };
 
+typedef struct _ipmi_latency_stat {
+	uint8_t netfn;
+	uint8_t cmd;
+	bool is_slow;
+	uint32_t count;
+	uint32_t timeout_count;
+	uint32_t max_us;
+	uint64_t total_us;
+	uint32_t bucket[IPMI_LATENCY_BUCKET_NUM];
+} ipmi_latency_stat;
+
 typedef struct common_addsel_msg_t {
 	uint8_t InF_target;
 	uint8_t sensor_type;
@@ -309,6 +343,7 @@ enum {
 	CMD_OEM_1S_NOTIFY_PMIC_ERROR = 0xB0,
 	CMD_OEM_1S_WRITE_READ_DIMM = 0xB1,
 	CMD_OEM_1S_GET_SDR = 0xC0,
+	CMD_OEM_1S_GET_SDR_IMAGE = 0xC1,
 	CMD_OEM_1S_SEND_APML_ALERT_TO_BMC = 0xD0,
 	CMD_OEM_1S_GET_DIMM_I3C_MUX_SELECTION = 0xB2,
 	CMD_OEM_1S_PRE_POWER_OFF_CONTROL = 0xD1,
@@ -332,5 +367,8 @@ enum {
 };
 
 ipmb_error notify_ipmi_client(ipmi_msg_cfg *msg_cfg);
+bool pal_is_slow_ipmi_cmd(uint8_t netfn, uint8_t cmd);
+uint8_t ipmi_get_latency_stat(ipmi_latency_stat *stat, uint8_t max_num, uint32_t *untracked_count);
+void ipmi_reset_latency_stat(void);
 
 #endif
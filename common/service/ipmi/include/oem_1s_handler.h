@@ -67,6 +67,11 @@ enum GET_SET_VGPIO_OPTIONS {
 	SET_VGPIO_STATUS,
 };
 
+enum GET_SDR_IMAGE_OPTIONS {
+	SDR_IMAGE_OPTION_GET_INFO = 0,
+	SDR_IMAGE_OPTION_READ,
+};
+
 typedef struct _ACCURACY_SENSOR_READING_REQ {
 	uint8_t sensor_num;
 	uint8_t read_option;
@@ -110,6 +115,7 @@ void OEM_1S_SET_CARD_TYPE(ipmi_msg *msg);
 void OEM_1S_CLEAR_CMOS(ipmi_msg *msg);
 void OEM_1S_NOTIFY_PMIC_ERROR(ipmi_msg *msg);
 void OEM_1S_GET_SDR(ipmi_msg *msg);
+void OEM_1S_GET_SDR_IMAGE(ipmi_msg *msg);
 void OEM_1S_BMC_IPMB_ACCESS(ipmi_msg *msg);
 void OEM_1S_GET_HSC_STATUS(ipmi_msg *msg);
 void OEM_1S_GET_BIOS_VERSION(ipmi_msg *msg);
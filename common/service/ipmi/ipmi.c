@@ -46,21 +46,38 @@
 
 LOG_MODULE_REGISTER(ipmi);
 
-#define IPMI_QUEUE_SIZE 5
-
 struct k_thread IPMI_thread;
 K_KERNEL_STACK_MEMBER(IPMI_thread_stack, IPMI_THREAD_STACK_SIZE);
 
 struct k_thread IPMI_handle_thread;
 K_KERNEL_STACK_MEMBER(IPMI_handle_thread_stack, IPMI_HANDLE_THREAD_STACK_SIZE);
 
+#if IPMI_SLOW_WORKER_NUM
+struct k_thread ipmi_slow_worker_threads[IPMI_SLOW_WORKER_NUM];
+K_THREAD_STACK_ARRAY_DEFINE(ipmi_slow_worker_stacks, IPMI_SLOW_WORKER_NUM,
+			    IPMI_SLOW_WORKER_STACK_SIZE);
+
+struct k_thread ipmi_slow_handle_threads[IPMI_SLOW_WORKER_NUM];
+K_THREAD_STACK_ARRAY_DEFINE(ipmi_slow_handle_stacks, IPMI_SLOW_WORKER_NUM,
+			    IPMI_HANDLE_THREAD_STACK_SIZE);
+#endif
+
 char __aligned(4) ipmi_msgq_buffer[IPMI_BUF_LEN * sizeof(struct ipmi_msg_cfg)];
 struct k_msgq ipmi_msgq;
+#if IPMI_SLOW_WORKER_NUM
+char __aligned(4) ipmi_slow_msgq_buffer[IPMI_SLOW_BUF_LEN * sizeof(struct ipmi_msg_cfg)];
+struct k_msgq ipmi_slow_msgq;
+#endif
 char __aligned(4) self_ipmi_msgq_buffer[1 * sizeof(struct ipmi_msg_cfg)];
 struct k_msgq self_ipmi_msgq;
 
 static struct k_mutex mutex_purge_msgq;
 
+static ipmi_latency_stat latency_stat[IPMI_LATENCY_CMD_NUM];
+static uint8_t latency_stat_num;
+static uint32_t latency_untracked_count;
+K_MUTEX_DEFINE(latency_stat_mutex);
+
 // Send message to IPMI message queue
 ipmb_error notify_ipmi_client(ipmi_msg_cfg *msg_cfg)
 {
@@ -191,6 +208,42 @@ __weak bool pal_immediate_respond_from_HOST(uint8_t netfn, uint8_t cmd)
 	return false;
 }
 
+__weak bool pal_is_slow_ipmi_cmd(uint8_t netfn, uint8_t cmd)
+{
+	if (netfn == NETFN_APP_REQ) {
+		return (cmd == CMD_APP_MASTER_WRITE_READ);
+	}
+
+	if (netfn != NETFN_OEM_1S_REQ) {
+		return false;
+	}
+
+	switch (cmd) {
+	case CMD_OEM_1S_FW_UPDATE:
+	case CMD_OEM_1S_READ_FW_IMAGE:
+	case CMD_OEM_1S_JTAG_TCK_CYCLE:
+	case CMD_OEM_1S_SET_JTAG_TAP_STA:
+	case CMD_OEM_1S_JTAG_DATA_SHIFT:
+	case CMD_OEM_1S_PECI_ACCESS:
+	case CMD_OEM_1S_APML_READ:
+	case CMD_OEM_1S_APML_WRITE:
+	case CMD_OEM_1S_SEND_APML_REQUEST:
+	case CMD_OEM_1S_GET_APML_RESPONSE:
+	case CMD_OEM_1S_GET_FW_SHA256:
+	case CMD_OEM_1S_COPY_FLASH_IMAGE:
+	case CMD_OEM_1S_I2C_DEV_SCAN:
+	case CMD_OEM_1S_PEX_FLASH_READ:
+	case CMD_OEM_1S_BRIDGE_I2C_MSG_BY_COMPNT:
+	case CMD_OEM_1S_WRITE_READ_DIMM:
+	case CMD_OEM_1S_SEND_MCTP_PLDM_COMMAND:
+	case CMD_OEM_1S_SPI_REGISTER_READ:
+	case CMD_OEM_1S_ERASE_BIOS_FLASH:
+		return true;
+	default:
+		return false;
+	}
+}
+
 __weak int pal_record_bios_fw_version(uint8_t *buf, uint8_t size)
 {
 	return -2;
@@ -426,10 +479,119 @@ void ipmi_cmd_handle(void *parameters, void *arvg0, void *arvg1)
 	}
 }
 
+static void ipmi_record_latency(ipmi_msg_cfg *msg_cfg, bool is_slow, uint32_t elapsed_us,
+				bool is_timeout)
+{
+	CHECK_NULL_ARG(msg_cfg);
+
+	k_mutex_lock(&latency_stat_mutex, K_FOREVER);
+
+	ipmi_latency_stat *stat = NULL;
+	for (uint8_t i = 0; i < latency_stat_num; i++) {
+		if ((latency_stat[i].netfn == msg_cfg->buffer.netfn) &&
+		    (latency_stat[i].cmd == msg_cfg->buffer.cmd)) {
+			stat = &latency_stat[i];
+			break;
+		}
+	}
+
+	if (stat == NULL) {
+		if (latency_stat_num >= IPMI_LATENCY_CMD_NUM) {
+			latency_untracked_count++;
+			k_mutex_unlock(&latency_stat_mutex);
+			return;
+		}
+		stat = &latency_stat[latency_stat_num++];
+		memset(stat, 0, sizeof(ipmi_latency_stat));
+		stat->netfn = msg_cfg->buffer.netfn;
+		stat->cmd = msg_cfg->buffer.cmd;
+	}
+
+	uint8_t bucket = 0;
+	while ((bucket < (IPMI_LATENCY_BUCKET_NUM - 1)) &&
+	       (elapsed_us >= (1000U << (2 * bucket)))) {
+		bucket++;
+	}
+
+	stat->is_slow = is_slow;
+	stat->count++;
+	stat->timeout_count += (is_timeout ? 1 : 0);
+	stat->max_us = MAX(stat->max_us, elapsed_us);
+	stat->total_us += elapsed_us;
+	stat->bucket[bucket]++;
+
+	k_mutex_unlock(&latency_stat_mutex);
+}
+
+uint8_t ipmi_get_latency_stat(ipmi_latency_stat *stat, uint8_t max_num, uint32_t *untracked_count)
+{
+	CHECK_NULL_ARG_WITH_RETURN(stat, 0);
+
+	k_mutex_lock(&latency_stat_mutex, K_FOREVER);
+	uint8_t num = MIN(max_num, latency_stat_num);
+	memcpy(stat, latency_stat, num * sizeof(ipmi_latency_stat));
+	if (untracked_count) {
+		*untracked_count = latency_untracked_count;
+	}
+	k_mutex_unlock(&latency_stat_mutex);
+
+	return num;
+}
+
+void ipmi_reset_latency_stat(void)
+{
+	k_mutex_lock(&latency_stat_mutex, K_FOREVER);
+	latency_stat_num = 0;
+	latency_untracked_count = 0;
+	k_mutex_unlock(&latency_stat_mutex);
+}
+
+/* Run one command on the given handler thread, abort it if it does not finish in time */
+static void ipmi_run_cmd_handle(struct k_thread *thread, k_thread_stack_t *stack, size_t stack_size,
+				ipmi_msg_cfg *msg_cfg, bool is_slow)
+{
+	CHECK_NULL_ARG(thread);
+	CHECK_NULL_ARG(stack);
+	CHECK_NULL_ARG(msg_cfg);
+
+	bool is_timeout = false;
+	uint32_t start_cycle = k_cycle_get_32();
+
+	k_tid_t tid = k_thread_create(thread, stack, stack_size, ipmi_cmd_handle, (void *)msg_cfg,
+				      NULL, NULL, CONFIG_MAIN_THREAD_PRIORITY, 0, K_NO_WAIT);
+	k_thread_name_set(thread, is_slow ? "IPMI_slow_handle_thread" : "IPMI_handle_thread");
+	if (k_thread_join(tid, K_SECONDS(IPMI_HANDLE_TIMEOUT_S)) == -EAGAIN) { // timeout
+		k_thread_abort(tid);
+		is_timeout = true;
+		LOG_ERR("%s(): abort the handler due to timeout. netfn: %x, cmd: %x", __func__,
+			msg_cfg->buffer.netfn, msg_cfg->buffer.cmd);
+	}
+
+	ipmi_record_latency(msg_cfg, is_slow, k_cyc_to_us_floor32(k_cycle_get_32() - start_cycle),
+			    is_timeout);
+}
+
+#if IPMI_SLOW_WORKER_NUM
+static void ipmi_slow_worker(void *arvg0, void *arvg1, void *arvg2)
+{
+	int index = POINTER_TO_INT(arvg0);
+	ipmi_msg_cfg msg_cfg;
+
+	while (1) {
+		memset(&msg_cfg, 0, sizeof(ipmi_msg_cfg));
+		k_msgq_get(&ipmi_slow_msgq, &msg_cfg, K_FOREVER);
+
+		ipmi_run_cmd_handle(&ipmi_slow_handle_threads[index],
+				    ipmi_slow_handle_stacks[index],
+				    K_THREAD_STACK_SIZEOF(ipmi_slow_handle_stacks[index]), &msg_cfg,
+				    true);
+	}
+}
+#endif
+
 void IPMI_handler(void *arug0, void *arug1, void *arug2)
 {
 	ipmi_msg_cfg msg_cfg;
-	k_tid_t tid = 0;
 
 	while (1) {
 		memset(&msg_cfg, 0, sizeof(ipmi_msg_cfg));
@@ -438,16 +600,21 @@ void IPMI_handler(void *arug0, void *arug1, void *arug2)
 		LOG_DBG("IPMI_handler[%d]: netfn: %x", msg_cfg.buffer.data_len,
 			msg_cfg.buffer.netfn);
 		LOG_HEXDUMP_DBG(msg_cfg.buffer.data, msg_cfg.buffer.data_len, "");
-		tid = k_thread_create(&IPMI_handle_thread, IPMI_handle_thread_stack,
-				      K_THREAD_STACK_SIZEOF(IPMI_handle_thread_stack),
-				      ipmi_cmd_handle, (void *)&msg_cfg, NULL, NULL,
-				      CONFIG_MAIN_THREAD_PRIORITY, 0, K_NO_WAIT);
-		if (k_thread_join(tid, K_SECONDS(10)) == -EAGAIN) { // timeout
-			k_thread_abort(tid);
-			LOG_ERR("%s(): abort the handler due to timeout. netfn: %x, cmd: %x",
-				__func__, msg_cfg.buffer.netfn, msg_cfg.buffer.cmd);
+
+#if IPMI_SLOW_WORKER_NUM
+		/* Hand slow commands over so they don't hold up cheap ones queued behind them */
+		if (pal_is_slow_ipmi_cmd(msg_cfg.buffer.netfn, msg_cfg.buffer.cmd)) {
+			if (k_msgq_put(&ipmi_slow_msgq, &msg_cfg, K_NO_WAIT) == 0) {
+				continue;
+			}
+			LOG_WRN("Slow ipmi queue full, handle netfn: %x, cmd: %x directly",
+				msg_cfg.buffer.netfn, msg_cfg.buffer.cmd);
 		}
-		k_thread_name_set(&IPMI_handle_thread, "IPMI_handle_thread");
+#endif
+
+		ipmi_run_cmd_handle(&IPMI_handle_thread, IPMI_handle_thread_stack,
+				    K_THREAD_STACK_SIZEOF(IPMI_handle_thread_stack), &msg_cfg,
+				    false);
 	}
 }
 
@@ -455,6 +622,10 @@ void ipmi_init(void)
 {
 	LOG_DBG("ipmi_init");
 	k_msgq_init(&ipmi_msgq, ipmi_msgq_buffer, sizeof(struct ipmi_msg_cfg), IPMI_BUF_LEN);
+#if IPMI_SLOW_WORKER_NUM
+	k_msgq_init(&ipmi_slow_msgq, ipmi_slow_msgq_buffer, sizeof(struct ipmi_msg_cfg),
+		    IPMI_SLOW_BUF_LEN);
+#endif
 	k_msgq_init(&self_ipmi_msgq, self_ipmi_msgq_buffer, sizeof(struct ipmi_msg_cfg), 1);
 
 	if (k_mutex_init(&mutex_purge_msgq)) {
@@ -465,6 +636,16 @@ void ipmi_init(void)
 			IPMI_handler, NULL, NULL, NULL, CONFIG_MAIN_THREAD_PRIORITY, 0, K_NO_WAIT);
 	k_thread_name_set(&IPMI_thread, "IPMI_thread");
 
+#if IPMI_SLOW_WORKER_NUM
+	for (int i = 0; i < IPMI_SLOW_WORKER_NUM; i++) {
+		k_thread_create(&ipmi_slow_worker_threads[i], ipmi_slow_worker_stacks[i],
+				K_THREAD_STACK_SIZEOF(ipmi_slow_worker_stacks[i]), ipmi_slow_worker,
+				INT_TO_POINTER(i), NULL, NULL, CONFIG_MAIN_THREAD_PRIORITY, 0,
+				K_NO_WAIT);
+		k_thread_name_set(&ipmi_slow_worker_threads[i], "IPMI_slow_worker");
+	}
+#endif
+
 #if MAX_IPMB_IDX
 	ipmb_init();
 #endif
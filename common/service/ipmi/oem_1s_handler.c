@@ -18,6 +18,7 @@
 #include <stdlib.h>
 #include <drivers/peci.h>
 #include <drivers/flash.h>
+#include <sys/byteorder.h>
 #include "libutil.h"
 #include "ipmb.h"
 #include "sensor.h"
@@ -53,6 +54,9 @@
 #ifdef ENABLE_SBMR
 #include "sbmr.h"
 #endif
+#ifdef CONFIG_IPMI_KCS_ASPEED
+#include "kcs.h"
+#endif
 #include "pcc.h"
 #include "hal_wdt.h"
 #include "pldm.h"
@@ -276,6 +280,11 @@ __weak void OEM_1S_FW_UPDATE(ipmi_msg *msg)
 			return;
 		}
 
+#ifdef ENABLE_FW_UPDATE_PIPELINE
+		// The sector write worker owns the BIOS SPI mux, it switches it for each sector
+		status = fw_update(offset, length, &msg->data[7], (target & IS_SECTOR_END_MASK),
+				   pos);
+#else
 		// Switch GPIO(BIOS SPI Selection Pin) to BIC
 		bool ret = pal_switch_bios_spi_mux(GPIO_HIGH);
 		if (!ret) {
@@ -292,6 +301,7 @@ __weak void OEM_1S_FW_UPDATE(ipmi_msg *msg)
 			msg->completion_code = CC_UNSPECIFIED_ERROR;
 			return;
 		}
+#endif
 
 	} else if ((target == BIC_UPDATE) || (target == (BIC_UPDATE | IS_SECTOR_END_MASK))) {
 		// Expect BIC firmware size not bigger than 320k
@@ -1342,7 +1352,8 @@ __weak void OEM_1S_CONTROL_SENSOR_POLLING(ipmi_msg *msg)
 
 		control_sensor_index = sensor_config_index_map[sensor_number[index]];
 		msg->data[return_data_index] = sensor_number[index];
-		if (control_sensor_index != SENSOR_FAIL) {
+		if ((control_sensor_index != SENSOR_FAIL) &&
+		    (control_sensor_index < sensor_config_count)) {
 			// Enable or Disable sensor polling
 			sensor_config[control_sensor_index].is_enable_polling =
 				((operation == DISABLE_SENSOR_POLLING) ? DISABLE_SENSOR_POLLING :
@@ -2185,6 +2196,85 @@ __weak void OEM_1S_GET_SDR(ipmi_msg *msg)
 	return;
 }
 
+/*
+ * Bulk SDR repository transfer.
+ * Info:  req [0x00], resp [CRC32 (4), image size (4), record count (2)]
+ * Read:  req [0x01, offset (4), length (2), 0 for as much as fits]
+ *        resp [CRC32 (4), image data]
+ * All fields are LSB first. The CRC is returned with every chunk so the reader can restart
+ * when the repository changes during the download.
+ */
+__weak void OEM_1S_GET_SDR_IMAGE(ipmi_msg *msg)
+{
+	CHECK_NULL_ARG(msg);
+
+	if (msg->data_len < 1) {
+		msg->completion_code = CC_INVALID_LENGTH;
+		return;
+	}
+
+	sdr_image_info info = { 0 };
+
+	switch (msg->data[0]) {
+	case SDR_IMAGE_OPTION_GET_INFO:
+		if (msg->data_len != 1) {
+			msg->completion_code = CC_INVALID_LENGTH;
+			return;
+		}
+		// Rebuilt on demand when sensors were added or changed since the last build
+		if (!sdr_image_get_info(&info)) {
+			msg->completion_code = CC_NOT_SUPP_IN_CURR_STATE;
+			return;
+		}
+		sys_put_le32(info.crc32, &msg->data[0]);
+		sys_put_le32(info.size, &msg->data[4]);
+		sys_put_le16(info.record_count, &msg->data[8]);
+		msg->data_len = 10;
+		break;
+	case SDR_IMAGE_OPTION_READ: {
+		if (msg->data_len != 7) {
+			msg->completion_code = CC_INVALID_LENGTH;
+			return;
+		}
+		if (!sdr_image_get_info(&info)) {
+			msg->completion_code = CC_NOT_SUPP_IN_CURR_STATE;
+			return;
+		}
+
+		uint32_t offset = sys_get_le32(&msg->data[1]);
+		uint16_t req_len = sys_get_le16(&msg->data[5]);
+		uint16_t max_len = IPMI_DATA_MAX_LENGTH - 4;
+#ifdef CONFIG_IPMI_KCS_ASPEED
+		// The KCS response buffer also holds netfn, cmd and completion code
+		if ((msg->InF_source >= HOST_KCS_1) && (msg->InF_source <= HOST_KCS_4)) {
+			max_len = KCS_BUFF_SIZE - 3 - 4;
+		}
+#endif
+		if ((req_len == 0) || (req_len > max_len)) {
+			req_len = max_len;
+		}
+
+		uint32_t crc32 = 0;
+		uint16_t read_len = sdr_image_read(offset, &msg->data[4], req_len, &crc32);
+		if (read_len == 0) {
+			msg->completion_code = CC_PARAM_OUT_OF_RANGE;
+			return;
+		}
+
+		// The CRC of the image this chunk came from, it changes if the table was updated
+		sys_put_le32(crc32, &msg->data[0]);
+		msg->data_len = 4 + read_len;
+		break;
+	}
+	default:
+		msg->completion_code = CC_INVALID_DATA_FIELD;
+		return;
+	}
+
+	msg->completion_code = CC_SUCCESS;
+	return;
+}
+
 __weak void OEM_1S_BMC_IPMB_ACCESS(ipmi_msg *msg)
 {
 	CHECK_NULL_ARG(msg);
@@ -2770,6 +2860,10 @@ void IPMI_OEM_1S_handler(ipmi_msg *msg)
 		LOG_DBG("Received 1S Get SDR command");
 		OEM_1S_GET_SDR(msg);
 		break;
+	case CMD_OEM_1S_GET_SDR_IMAGE:
+		LOG_DBG("Received 1S Get SDR image command");
+		OEM_1S_GET_SDR_IMAGE(msg);
+		break;
 	case CMD_OEM_1S_BMC_IPMB_ACCESS:
 		LOG_DBG("Received 1S BMC IPMB Access command");
 		OEM_1S_BMC_IPMB_ACCESS(msg);
@@ -245,7 +245,10 @@ __weak void STORAGE_GET_SDR(ipmi_msg *msg)
 	msg->data[1] = (next_record_ID >> 8) & 0xFF;
 
 	table_ptr = (uint8_t *)&full_sdr_table[record_ID];
-	pal_set_SDR(table_ptr);
+	// The record only has to be fixed up once, when its first chunk is read
+	if (offset == 0) {
+		pal_set_SDR(table_ptr);
+	}
 	memcpy(&msg->data[2], (table_ptr + offset), req_len);
 
 	msg->data_len = req_len + 2; // return next record ID + sdr data
@@ -84,6 +84,13 @@ static uint8_t set_thread_name(mctp *mctp_inst)
 			 "mctptx_%02x_%02x_%02x", mctp_inst->medium_type, i3c_conf->bus,
 			 i3c_conf->addr);
 		break;
+	case MCTP_MEDIUM_TYPE_LOOPBACK:
+		LOG_DBG("medium_type: loopback");
+		snprintf(mctp_inst->mctp_rx_task_name, sizeof(mctp_inst->mctp_rx_task_name),
+			 "mctprx_%02x_lo", mctp_inst->medium_type);
+		snprintf(mctp_inst->mctp_tx_task_name, sizeof(mctp_inst->mctp_tx_task_name),
+			 "mctptx_%02x_lo", mctp_inst->medium_type);
+		break;
 	default:
 		return MCTP_ERROR;
 		break;
@@ -109,6 +116,11 @@ static uint8_t mctp_medium_init(mctp *mctp_inst, mctp_medium_conf medium_conf)
 	case MCTP_MEDIUM_TYPE_CONTROLLER_I3C:
 		ret = mctp_i3c_controller_init(mctp_inst, medium_conf);
 		break;
+#endif
+#ifdef ENABLE_MCTP_LOOPBACK
+	case MCTP_MEDIUM_TYPE_LOOPBACK:
+		ret = mctp_loopback_init(mctp_inst, medium_conf);
+		break;
 #endif
 	default:
 		return MCTP_ERROR;
@@ -130,6 +142,11 @@ static uint8_t mctp_medium_deinit(mctp *mctp_inst)
 	case MCTP_MEDIUM_TYPE_CONTROLLER_I3C:
 		mctp_i3c_deinit(mctp_inst);
 		break;
+#endif
+#ifdef ENABLE_MCTP_LOOPBACK
+	case MCTP_MEDIUM_TYPE_LOOPBACK:
+		mctp_loopback_deinit(mctp_inst);
+		break;
 #endif
 	default:
 		return MCTP_ERROR;
@@ -163,6 +180,140 @@ static uint8_t bridge_msg(mctp *mctp_inst, uint8_t *buf, uint16_t len)
 	return mctp_bridge_msg(target_mctp, buf, len, target_ext_params);
 }
 
+#define MCTP_ASSEMBLY_SLOT_NONE 0xFF
+
+static struct {
+	uint8_t buf[MSG_ASSEMBLY_BUF_SIZE];
+	mctp *owner;
+	uint8_t msg_tag;
+	uint8_t to;
+	bool in_use;
+	int64_t update_time_ms;
+} __aligned(4) assembly_slab[MCTP_ASSEMBLY_BUF_NUM];
+
+static mctp_assembly_stat assembly_stat;
+K_MUTEX_DEFINE(assembly_mutex);
+
+/* Must be called with assembly_mutex held */
+static bool mctp_assembly_is_owned(mctp *mctp_inst, uint8_t msg_tag, uint8_t to)
+{
+	uint8_t slot = mctp_inst->temp_msg_buf[msg_tag][to].slot;
+	if (slot >= MCTP_ASSEMBLY_BUF_NUM) {
+		return false;
+	}
+
+	return (assembly_slab[slot].in_use && (assembly_slab[slot].owner == mctp_inst) &&
+		(assembly_slab[slot].msg_tag == msg_tag) && (assembly_slab[slot].to == to));
+}
+
+/* Must be called with assembly_mutex held */
+static void mctp_assembly_reclaim_expired(int64_t now_ms)
+{
+	for (uint8_t i = 0; i < MCTP_ASSEMBLY_BUF_NUM; i++) {
+		if (assembly_slab[i].in_use &&
+		    ((now_ms - assembly_slab[i].update_time_ms) > MCTP_ASSEMBLY_TIMEOUT_MS)) {
+			LOG_WRN("Reassembly timeout, mctp %p tag %d to %d", assembly_slab[i].owner,
+				assembly_slab[i].msg_tag, assembly_slab[i].to);
+			assembly_slab[i].in_use = false;
+			assembly_stat.timeout_count++;
+			assembly_stat.in_use_count--;
+		}
+	}
+}
+
+static bool mctp_assembly_alloc(mctp *mctp_inst, uint8_t msg_tag, uint8_t to)
+{
+	int64_t now_ms = k_uptime_get();
+	uint8_t slot = MCTP_ASSEMBLY_SLOT_NONE;
+
+	k_mutex_lock(&assembly_mutex, K_FOREVER);
+
+	/* A lost EOM must not pin a buffer, release the stale ones first */
+	mctp_assembly_reclaim_expired(now_ms);
+
+	for (uint8_t i = 0; i < MCTP_ASSEMBLY_BUF_NUM; i++) {
+		if (!assembly_slab[i].in_use) {
+			slot = i;
+			break;
+		}
+	}
+
+	if (slot == MCTP_ASSEMBLY_SLOT_NONE) {
+		assembly_stat.slab_exhausted_count++;
+		k_mutex_unlock(&assembly_mutex);
+		return false;
+	}
+
+	assembly_slab[slot].owner = mctp_inst;
+	assembly_slab[slot].msg_tag = msg_tag;
+	assembly_slab[slot].to = to;
+	assembly_slab[slot].update_time_ms = now_ms;
+	assembly_slab[slot].in_use = true;
+	assembly_stat.alloc_count++;
+	assembly_stat.in_use_count++;
+
+	k_mutex_unlock(&assembly_mutex);
+
+	mctp_inst->temp_msg_buf[msg_tag][to].buf = assembly_slab[slot].buf;
+	mctp_inst->temp_msg_buf[msg_tag][to].slot = slot;
+	mctp_inst->temp_msg_buf[msg_tag][to].offset = 0;
+	return true;
+}
+
+/* Refresh the buffer timeout, return false if it was reclaimed in the meantime */
+static bool mctp_assembly_touch(mctp *mctp_inst, uint8_t msg_tag, uint8_t to)
+{
+	bool is_owned = false;
+
+	k_mutex_lock(&assembly_mutex, K_FOREVER);
+	is_owned = mctp_assembly_is_owned(mctp_inst, msg_tag, to);
+	if (is_owned) {
+		assembly_slab[mctp_inst->temp_msg_buf[msg_tag][to].slot].update_time_ms =
+			k_uptime_get();
+	}
+	k_mutex_unlock(&assembly_mutex);
+
+	return is_owned;
+}
+
+static void mctp_assembly_release(mctp *mctp_inst, uint8_t msg_tag, uint8_t to)
+{
+	k_mutex_lock(&assembly_mutex, K_FOREVER);
+	if (mctp_assembly_is_owned(mctp_inst, msg_tag, to)) {
+		assembly_slab[mctp_inst->temp_msg_buf[msg_tag][to].slot].in_use = false;
+		assembly_stat.in_use_count--;
+	}
+	k_mutex_unlock(&assembly_mutex);
+
+	mctp_inst->temp_msg_buf[msg_tag][to].buf = NULL;
+	mctp_inst->temp_msg_buf[msg_tag][to].slot = MCTP_ASSEMBLY_SLOT_NONE;
+	mctp_inst->temp_msg_buf[msg_tag][to].offset = 0;
+}
+
+static void mctp_assembly_release_all(mctp *mctp_inst)
+{
+	for (uint8_t tag = 0; tag < MCTP_MAX_MSG_TAG_NUM; tag++) {
+		mctp_assembly_release(mctp_inst, tag, 0);
+		mctp_assembly_release(mctp_inst, tag, 1);
+	}
+}
+
+static void mctp_assembly_count(uint32_t *counter)
+{
+	k_mutex_lock(&assembly_mutex, K_FOREVER);
+	(*counter)++;
+	k_mutex_unlock(&assembly_mutex);
+}
+
+void mctp_get_assembly_stat(mctp_assembly_stat *stat)
+{
+	CHECK_NULL_ARG(stat);
+
+	k_mutex_lock(&assembly_mutex, K_FOREVER);
+	memcpy(stat, &assembly_stat, sizeof(mctp_assembly_stat));
+	k_mutex_unlock(&assembly_mutex);
+}
+
 static uint8_t mctp_pkt_assembling(mctp *mctp_inst, uint8_t *buf, uint16_t len)
 {
 	CHECK_NULL_ARG_WITH_RETURN(mctp_inst, MCTP_ERROR);
@@ -172,34 +323,45 @@ static uint8_t mctp_pkt_assembling(mctp *mctp_inst, uint8_t *buf, uint16_t len)
 	mctp_hdr *hdr = (mctp_hdr *)buf;
 	uint8_t **buf_p = &mctp_inst->temp_msg_buf[hdr->msg_tag][hdr->to].buf;
 	uint16_t *offset_p = &mctp_inst->temp_msg_buf[hdr->msg_tag][hdr->to].offset;
+	uint8_t *next_seq_p = &mctp_inst->temp_msg_buf[hdr->msg_tag][hdr->to].next_seq;
 
-	/* one packet message, do nothing */
-	if (hdr->som && hdr->eom)
+	/* one packet message, handled from the read buffer directly */
+	if (hdr->som && hdr->eom) {
+		if (*buf_p) {
+			LOG_WRN("Unexpected single packet message during assembling");
+			mctp_assembly_release(mctp_inst, hdr->msg_tag, hdr->to);
+		}
 		return MCTP_SUCCESS;
-	/* first packet, allocate memory to hold data */
-	if (hdr->som && !hdr->eom) {
+	}
+	/* first packet, take a buffer from the slab to hold data */
+	if (hdr->som) {
 		if (*buf_p) {
 			LOG_WRN("Unexpected SOM received?");
-			free(*buf_p);
+			mctp_assembly_release(mctp_inst, hdr->msg_tag, hdr->to);
 		}
-		*offset_p = 0;
 
-		*buf_p = (uint8_t *)malloc(MSG_ASSEMBLY_BUF_SIZE);
-		if (!*buf_p) {
-			LOG_WRN("cannot create memory...");
+		if (!mctp_assembly_alloc(mctp_inst, hdr->msg_tag, hdr->to)) {
+			LOG_WRN("No free reassembly buffer");
 			return MCTP_ERROR;
 		}
-		memset(*buf_p, 0, MSG_ASSEMBLY_BUF_SIZE);
+		*next_seq_p = hdr->pkt_seq;
+	} else if (!(*buf_p) || !mctp_assembly_touch(mctp_inst, hdr->msg_tag, hdr->to)) {
+		LOG_HEXDUMP_WRN(buf, len, "There was no SOM package before?");
+		mctp_assembly_release(mctp_inst, hdr->msg_tag, hdr->to);
+		return MCTP_ERROR;
 	}
 
-	if (!(*buf_p)) {
-		LOG_HEXDUMP_WRN(buf, len, "There was no SOM package before?");
+	if (hdr->pkt_seq != *next_seq_p) {
+		LOG_WRN("Packet sequence %d out of order, expect %d", hdr->pkt_seq, *next_seq_p);
+		mctp_assembly_count(&assembly_stat.out_of_seq_count);
 		return MCTP_ERROR;
 	}
+	*next_seq_p = (hdr->pkt_seq + 1) & MCTP_HDR_SEQ_MASK;
 
 	uint16_t offset_new = *offset_p + len - sizeof(mctp_hdr);
 	if (offset_new > MSG_ASSEMBLY_BUF_SIZE) {
 		LOG_WRN("assembly size %d over buffer size %d", offset_new, MSG_ASSEMBLY_BUF_SIZE);
+		mctp_assembly_count(&assembly_stat.overflow_count);
 		return MCTP_ERROR;
 	}
 	/* Appending other packet after the first packet */
@@ -224,7 +386,9 @@ static void mctp_rx_task(void *arg, void *dummy0, void *dummy1)
 	LOG_INF("mctp_rx_task start %p", mctp_inst);
 
 	while (1) {
-		k_msleep(MCTP_POLL_TIME_MS);
+		if (mctp_inst->rx_mode == MCTP_RX_MODE_POLL)
+			k_msleep(MCTP_POLL_TIME_MS);
+
 		uint8_t read_buf[256] = { 0 };
 		mctp_ext_params ext_params;
 		uint8_t ret = MCTP_ERROR;
@@ -233,8 +397,14 @@ static void mctp_rx_task(void *arg, void *dummy0, void *dummy1)
 		uint16_t read_len =
 			mctp_inst->read_data(mctp_inst, read_buf, sizeof(read_buf), &ext_params);
 
-		if (!read_len)
+		if (!read_len) {
+			/* Nothing read or read failed, back off instead of spinning */
+			if (mctp_inst->rx_mode == MCTP_RX_MODE_EVENT)
+				k_msleep(MCTP_POLL_TIME_MS);
 			continue;
+		}
+
+		mctp_inst->rx_packet_count++;
 
 		LOG_HEXDUMP_DBG(read_buf, read_len, "mctp receive data");
 
@@ -289,9 +459,7 @@ static void mctp_rx_task(void *arg, void *dummy0, void *dummy1)
 
 	error:
 		if (mctp_inst->temp_msg_buf[hdr->msg_tag][hdr->to].buf) {
-			free(mctp_inst->temp_msg_buf[hdr->msg_tag][hdr->to].buf);
-			mctp_inst->temp_msg_buf[hdr->msg_tag][hdr->to].buf = NULL;
-			mctp_inst->temp_msg_buf[hdr->msg_tag][hdr->to].offset = 0;
+			mctp_assembly_release(mctp_inst, hdr->msg_tag, hdr->to);
 		}
 	}
 }
@@ -437,6 +605,10 @@ mctp *mctp_init(void)
 		return NULL;
 
 	memset(mctp_inst, 0, sizeof(*mctp_inst));
+	for (uint8_t tag = 0; tag < MCTP_MAX_MSG_TAG_NUM; tag++) {
+		mctp_inst->temp_msg_buf[tag][0].slot = MCTP_ASSEMBLY_SLOT_NONE;
+		mctp_inst->temp_msg_buf[tag][1].slot = MCTP_ASSEMBLY_SLOT_NONE;
+	}
 	mctp_inst->medium_type = MCTP_MEDIUM_TYPE_UNKNOWN;
 	mctp_inst->max_msg_size = MCTP_DEFAULT_MSG_MAX_SIZE;
 	mctp_inst->endpoint = plat_get_eid();
@@ -513,6 +685,8 @@ uint8_t mctp_stop(mctp *mctp_inst)
 		mctp_inst->mctp_tx_queue.buffer_start = NULL;
 	}
 
+	mctp_assembly_release_all(mctp_inst);
+
 	mctp_inst->is_servcie_start = 0;
 	return MCTP_SUCCESS;
 }
@@ -630,6 +804,19 @@ uint8_t mctp_send_msg(mctp *mctp_inst, uint8_t *buf, uint16_t len, mctp_ext_para
 	return mctp_pass_tx_task(mctp_inst, buf, len, ext_params, 0);
 }
 
+uint8_t mctp_set_rx_mode(mctp *mctp_inst, MCTP_RX_MODE rx_mode)
+{
+	CHECK_NULL_ARG_WITH_RETURN(mctp_inst, MCTP_ERROR);
+
+	if ((rx_mode != MCTP_RX_MODE_EVENT) && (rx_mode != MCTP_RX_MODE_POLL)) {
+		LOG_WRN("Invalid rx mode %d", rx_mode);
+		return MCTP_ERROR;
+	}
+
+	mctp_inst->rx_mode = rx_mode;
+	return MCTP_SUCCESS;
+}
+
 uint8_t mctp_reg_endpoint_resolve_func(mctp *mctp_inst, endpoint_resolve resolve_fn)
 {
 	CHECK_NULL_ARG_WITH_RETURN(mctp_inst, MCTP_ERROR);
@@ -38,6 +38,16 @@ extern "C" {
 
 #define MSG_ASSEMBLY_BUF_SIZE 1024
 
+/* Reassembly buffers are shared by every mctp instance */
+#ifndef MCTP_ASSEMBLY_BUF_NUM
+#define MCTP_ASSEMBLY_BUF_NUM 4
+#endif
+
+/* A message without packet for this long releases its reassembly buffer */
+#ifndef MCTP_ASSEMBLY_TIMEOUT_MS
+#define MCTP_ASSEMBLY_TIMEOUT_MS 1000
+#endif
+
 #define MCTP_RX_TASK_STACK_SIZE 4096
 #define MCTP_TX_TASK_STACK_SIZE 2048
 #define MCTP_TASK_NAME_LEN 32
@@ -63,6 +73,16 @@ extern "C" {
 
 #define MCTP_POLL_TIME_MS 1
 
+/*
+ * MCTP_RX_MODE_EVENT: the rx task waits in the medium read, which blocks on the target queue for
+ * smbus and on the IBI semaphore for i3c controller, and only sleeps when a read returns nothing.
+ * MCTP_RX_MODE_POLL: the rx task sleeps MCTP_POLL_TIME_MS before every read.
+ */
+typedef enum {
+	MCTP_RX_MODE_EVENT = 0,
+	MCTP_RX_MODE_POLL,
+} MCTP_RX_MODE;
+
 #define MCTP_MSG_TYPE_SHIFT 0
 #define MCTP_MSG_TYPE_MASK 0x7F
 
@@ -85,6 +105,7 @@ typedef enum {
 	MCTP_MEDIUM_TYPE_SMBUS,
 	MCTP_MEDIUM_TYPE_CONTROLLER_I3C,
 	MCTP_MEDIUM_TYPE_TARGET_I3C,
+	MCTP_MEDIUM_TYPE_LOOPBACK,
 	MCTP_MEDIUM_TYPE_MAX
 } MCTP_MEDIUM_TYPE;
 
@@ -178,6 +199,8 @@ typedef struct _mctp {
 	K_KERNEL_STACK_MEMBER(tx_task_stack_area, MCTP_TX_TASK_STACK_SIZE);
 	uint8_t mctp_rx_task_name[MCTP_TASK_NAME_LEN];
 	uint8_t mctp_tx_task_name[MCTP_TASK_NAME_LEN];
+	MCTP_RX_MODE rx_mode;
+	uint32_t rx_packet_count;
 
 	/* write queue */
 	struct k_msgq mctp_tx_queue;
@@ -186,6 +209,8 @@ typedef struct _mctp {
 	struct {
 		uint8_t *buf;
 		uint16_t offset;
+		uint8_t slot;
+		uint8_t next_seq;
 	} temp_msg_buf[MCTP_MAX_MSG_TAG_NUM][2];
 
 	/* the callback when recevie mctp data */
@@ -194,6 +219,7 @@ typedef struct _mctp {
 	/* for pldm instance id */
 	uint8_t pldm_inst_id;
 	uint32_t pldm_inst_table; // 32 bits field for instance id
+	void *pldm_wait_msg[32]; // pending pldm request of each instance id
 
 	/* for cci_msg_tag */
 	uint8_t cci_msg_tag;
@@ -206,6 +232,15 @@ typedef struct _mctp {
 	uint8_t msg_tag;
 } mctp;
 
+typedef struct _mctp_assembly_stat {
+	uint32_t alloc_count;
+	uint32_t slab_exhausted_count;
+	uint32_t timeout_count;
+	uint32_t out_of_seq_count;
+	uint32_t overflow_count;
+	uint8_t in_use_count;
+} mctp_assembly_stat;
+
 typedef struct _mctp_smbus_port {
 	mctp *mctp_inst;
 	uint8_t channel_target;
@@ -260,6 +295,14 @@ uint8_t mctp_smbus_deinit(mctp *mctp_inst);
 uint8_t mctp_i3c_controller_init(mctp *mctp_instance, mctp_medium_conf medium_conf);
 uint8_t mctp_i3c_target_init(mctp *mctp_instance, mctp_medium_conf medium_conf);
 uint8_t mctp_i3c_deinit(mctp *mctp_instance);
+uint8_t mctp_loopback_init(mctp *mctp_inst, mctp_medium_conf medium_conf);
+uint8_t mctp_loopback_deinit(mctp *mctp_inst);
+
+/* reassembly buffer counters */
+void mctp_get_assembly_stat(mctp_assembly_stat *stat);
+
+/* select how the rx task waits for packets */
+uint8_t mctp_set_rx_mode(mctp *mctp_inst, MCTP_RX_MODE rx_mode);
 
 /* register endpoint resolve function */
 uint8_t mctp_reg_endpoint_resolve_func(mctp *mctp_inst, endpoint_resolve resolve_fn);
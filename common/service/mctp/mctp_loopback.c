@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plat_def.h"
+#ifdef ENABLE_MCTP_LOOPBACK
+#include "mctp.h"
+
+#include <string.h>
+#include <zephyr.h>
+#include <logging/log.h>
+#include "libutil.h"
+
+LOG_MODULE_REGISTER(mctp_loopback);
+
+/*
+ * Loopback medium: every packet written by the instance is read back by its own rx task.
+ * It only serves benchmarking and testing of the upper layers, one instance at a time.
+ */
+
+#ifndef MCTP_LOOPBACK_QUEUE_SIZE
+#define MCTP_LOOPBACK_QUEUE_SIZE 16
+#endif
+
+#define MCTP_LOOPBACK_PKT_SIZE (MCTP_DEFAULT_MSG_MAX_SIZE + MCTP_TRANSPORT_HEADER_SIZE)
+#define MCTP_LOOPBACK_READ_TIMEOUT_MS 100
+#define MCTP_LOOPBACK_WRITE_TIMEOUT_MS 100
+
+typedef struct _mctp_loopback_pkt {
+	uint16_t len;
+	uint8_t buf[MCTP_LOOPBACK_PKT_SIZE];
+} mctp_loopback_pkt;
+
+K_MSGQ_DEFINE(loopback_msgq, sizeof(mctp_loopback_pkt), MCTP_LOOPBACK_QUEUE_SIZE, 4);
+
+static mctp *loopback_owner;
+
+static uint16_t mctp_loopback_read(void *mctp_p, uint8_t *buf, uint32_t len,
+				   mctp_ext_params *extra_data)
+{
+	CHECK_NULL_ARG_WITH_RETURN(mctp_p, 0);
+	CHECK_NULL_ARG_WITH_RETURN(buf, 0);
+	CHECK_NULL_ARG_WITH_RETURN(extra_data, 0);
+
+	mctp_loopback_pkt pkt;
+	if (k_msgq_get(&loopback_msgq, &pkt, K_MSEC(MCTP_LOOPBACK_READ_TIMEOUT_MS))) {
+		return 0;
+	}
+
+	if (pkt.len > len) {
+		LOG_WRN("Drop packet length %d over buffer size %d", pkt.len, len);
+		return 0;
+	}
+
+	extra_data->type = MCTP_MEDIUM_TYPE_LOOPBACK;
+	memcpy(buf, pkt.buf, pkt.len);
+	return pkt.len;
+}
+
+static uint16_t mctp_loopback_write(void *mctp_p, uint8_t *buf, uint32_t len,
+				    mctp_ext_params extra_data)
+{
+	CHECK_NULL_ARG_WITH_RETURN(mctp_p, MCTP_ERROR);
+	CHECK_NULL_ARG_WITH_RETURN(buf, MCTP_ERROR);
+	CHECK_ARG_WITH_RETURN(!len, MCTP_ERROR);
+
+	if (len > MCTP_LOOPBACK_PKT_SIZE) {
+		LOG_WRN("Packet length %d over loopback size %d", len, MCTP_LOOPBACK_PKT_SIZE);
+		return MCTP_ERROR;
+	}
+
+	mctp_loopback_pkt pkt;
+	pkt.len = len;
+	memcpy(pkt.buf, buf, len);
+
+	if (k_msgq_put(&loopback_msgq, &pkt, K_MSEC(MCTP_LOOPBACK_WRITE_TIMEOUT_MS))) {
+		LOG_WRN("Loopback queue full");
+		return MCTP_ERROR;
+	}
+
+	return MCTP_SUCCESS;
+}
+
+uint8_t mctp_loopback_init(mctp *mctp_inst, mctp_medium_conf medium_conf)
+{
+	CHECK_NULL_ARG_WITH_RETURN(mctp_inst, MCTP_ERROR);
+
+	if (loopback_owner && (loopback_owner != mctp_inst)) {
+		LOG_ERR("Loopback medium is already used by %p", loopback_owner);
+		return MCTP_ERROR;
+	}
+
+	loopback_owner = mctp_inst;
+	k_msgq_purge(&loopback_msgq);
+
+	mctp_inst->medium_conf = medium_conf;
+	mctp_inst->read_data = mctp_loopback_read;
+	mctp_inst->write_data = mctp_loopback_write;
+
+	return MCTP_SUCCESS;
+}
+
+uint8_t mctp_loopback_deinit(mctp *mctp_inst)
+{
+	CHECK_NULL_ARG_WITH_RETURN(mctp_inst, MCTP_ERROR);
+
+	if (loopback_owner == mctp_inst) {
+		loopback_owner = NULL;
+		k_msgq_purge(&loopback_msgq);
+	}
+
+	mctp_inst->read_data = NULL;
+	mctp_inst->write_data = NULL;
+	memset(&mctp_inst->medium_conf, 0, sizeof(mctp_inst->medium_conf));
+	return MCTP_SUCCESS;
+}
+
+#endif // ENABLE_MCTP_LOOPBACK
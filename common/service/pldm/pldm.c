@@ -21,7 +21,6 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/printk.h>
-#include <sys/slist.h>
 #include <zephyr.h>
 #include "libutil.h"
 #include "ipmi.h"
@@ -55,14 +54,22 @@ LOG_MODULE_REGISTER(pldm);
 #define PLDM_BRIDGE_IPMI_MAX_RETRY PLDM_MSG_MAX_RETRY
 #endif
 
+#ifndef PLDM_WAIT_MSG_NUM
+#define PLDM_WAIT_MSG_NUM 32
+#endif
+
+/* mctp_pldm_read waits this much longer than the request timeout for the monitor to report */
+#define PLDM_READ_WAIT_MARGIN_MS (2 * PLDM_MSG_CHECK_PER_MS)
+
 #define PLDM_RESP_MSG_PROC_MUTEX_TIMEOUT_MS 500
 #define PLDM_TASK_NAME_MAX_SIZE 32
 
 #define PLDM_READ_EVENT_SUCCESS BIT(0)
 #define PLDM_READ_EVENT_TIMEOUT BIT(1)
+#define PLDM_READ_EVENT_FAIL BIT(2)
 
 typedef struct _wait_msg {
-	sys_snode_t node;
+	bool in_use;
 	mctp *mctp_inst;
 	int64_t exp_to_ms;
 	pldm_msg msg;
@@ -74,7 +81,8 @@ struct _pldm_handler_query_entry {
 };
 
 typedef struct _pldm_recv_resp_arg {
-	struct k_msgq *msgq;
+	struct k_msgq msgq;
+	uint8_t msgq_buffer[1];
 	uint8_t *rbuf;
 	uint16_t rbuf_len;
 	uint16_t return_len;
@@ -90,7 +98,12 @@ static struct _pldm_handler_query_entry query_tbl[] = {
 
 static K_MUTEX_DEFINE(wait_recv_resp_mutex);
 
-static sys_slist_t wait_recv_resp_list = SYS_SLIST_STATIC_INIT(&wait_recv_resp_list);
+/* Pending requests, also indexed by mctp_inst->pldm_wait_msg[inst_id] for response matching */
+static wait_msg wait_msg_pool[PLDM_WAIT_MSG_NUM];
+static uint8_t wait_msg_next;
+
+/* given whenever an instance id is released, wakes up a blocked async sender */
+K_SEM_DEFINE(pldm_instid_free_sem, 0, 1);
 
 static bool unregister_instid(void *mctp_p, uint8_t inst_num)
 {
@@ -111,6 +124,7 @@ static bool unregister_instid(void *mctp_p, uint8_t inst_num)
 		return false;
 	}
 	WRITE_BIT(mctp_inst->pldm_inst_table, inst_num, 0);
+	k_sem_give(&pldm_instid_free_sem);
 
 	return true;
 }
@@ -145,16 +159,141 @@ static bool register_instid(void *mctp_p, uint8_t *inst_num)
 	return true;
 }
 
+/* Must be called with wait_recv_resp_mutex held */
+static wait_msg *wait_msg_alloc(void)
+{
+	for (uint8_t i = 0; i < PLDM_WAIT_MSG_NUM; i++) {
+		wait_msg *p = &wait_msg_pool[wait_msg_next];
+		wait_msg_next = (wait_msg_next + 1) % PLDM_WAIT_MSG_NUM;
+		if (!p->in_use) {
+			memset(p, 0, sizeof(*p));
+			p->in_use = true;
+			return p;
+		}
+	}
+
+	return NULL;
+}
+
+/* Must be called with wait_recv_resp_mutex held, the entry stays in use until wait_msg_free */
+static bool wait_msg_detach(wait_msg *p)
+{
+	CHECK_NULL_ARG_WITH_RETURN(p, false);
+
+	if (p->mctp_inst->pldm_wait_msg[p->msg.hdr.inst_id] == p) {
+		p->mctp_inst->pldm_wait_msg[p->msg.hdr.inst_id] = NULL;
+	}
+
+	return unregister_instid(p->mctp_inst, p->msg.hdr.inst_id);
+}
+
+static void wait_msg_free(wait_msg *p)
+{
+	CHECK_NULL_ARG(p);
+
+	k_mutex_lock(&wait_recv_resp_mutex, K_FOREVER);
+	p->in_use = false;
+	k_mutex_unlock(&wait_recv_resp_mutex);
+}
+
+/* Drop a pending request, return false if its response or timeout is already being reported */
+static bool wait_msg_cancel(mctp *mctp_inst, uint8_t inst_id, void *recv_resp_cb_args)
+{
+	CHECK_NULL_ARG_WITH_RETURN(mctp_inst, false);
+
+	bool is_cancelled = false;
+
+	k_mutex_lock(&wait_recv_resp_mutex, K_FOREVER);
+	wait_msg *p = (wait_msg *)mctp_inst->pldm_wait_msg[inst_id & PLDM_HDR_INST_ID_MASK];
+	if (p && (p->msg.recv_resp_cb_args == recv_resp_cb_args)) {
+		wait_msg_detach(p);
+		p->in_use = false;
+		is_cancelled = true;
+	}
+	k_mutex_unlock(&wait_recv_resp_mutex);
+
+	return is_cancelled;
+}
+
+/* Must be called with wait_recv_resp_mutex held */
+static wait_msg *wait_msg_register(mctp *mctp_inst, pldm_msg *msg)
+{
+	CHECK_NULL_ARG_WITH_RETURN(mctp_inst, NULL);
+	CHECK_NULL_ARG_WITH_RETURN(msg, NULL);
+
+	uint8_t get_inst_id = 0xff;
+
+	if (register_instid(mctp_inst, &get_inst_id) == false) {
+		LOG_ERR("Register failed!");
+		return NULL;
+	}
+
+	wait_msg *p = wait_msg_alloc();
+	if (!p) {
+		unregister_instid(mctp_inst, get_inst_id);
+		LOG_WRN("wait_msg pool exhausted!");
+		return NULL;
+	}
+
+	/* set pldm header */
+	msg->hdr.inst_id = get_inst_id;
+	msg->hdr.msg_type = MCTP_MSG_TYPE_PLDM;
+
+	/* set mctp extra parameters */
+	msg->ext_params.tag_owner = 1;
+
+	p->mctp_inst = mctp_inst;
+	p->msg = *msg;
+	p->exp_to_ms = k_uptime_get() + (msg->timeout_ms ? msg->timeout_ms : PLDM_MSG_TIMEOUT_MS);
+	mctp_inst->pldm_wait_msg[get_inst_id] = p;
+
+	return p;
+}
+
+/* p is the registered wait_msg of a request, or NULL for a response */
+static uint8_t pldm_msg_transmit(mctp *mctp_inst, pldm_msg *msg, wait_msg *p)
+{
+	CHECK_NULL_ARG_WITH_RETURN(mctp_inst, PLDM_ERROR);
+	CHECK_NULL_ARG_WITH_RETURN(msg, PLDM_ERROR);
+
+	uint16_t len = sizeof(msg->hdr) + msg->len;
+	uint8_t buf[len];
+
+	LOG_HEXDUMP_DBG(buf, len, __func__);
+
+	memcpy(buf, &msg->hdr, sizeof(msg->hdr));
+	memcpy(buf + sizeof(msg->hdr), msg->buf, msg->len);
+
+	uint8_t rc = mctp_send_msg(mctp_inst, buf, len, msg->ext_params);
+	if (rc == MCTP_ERROR) {
+		LOG_ERR("mctp_send_msg error!!");
+
+		if ((p != NULL) &&
+		    !wait_msg_cancel(mctp_inst, msg->hdr.inst_id, msg->recv_resp_cb_args)) {
+			/* Its callback owns the request now and reports the result */
+			LOG_WRN("Request inst_id %x already completed", msg->hdr.inst_id);
+			return PLDM_SUCCESS;
+		}
+
+		return PLDM_ERROR;
+	}
+
+	return PLDM_SUCCESS;
+}
+
 void pldm_read_resp_handler(void *args, uint8_t *rbuf, uint16_t rlen)
 {
 	CHECK_NULL_ARG(args);
-	CHECK_NULL_ARG(rbuf);
-
-	if (!rlen)
-		return;
 
 	pldm_recv_resp_arg *recv_arg = (pldm_recv_resp_arg *)args;
 
+	/* mctp_pldm_read waits for an event once the request can't be cancelled, always post one */
+	if (!rbuf || !rlen) {
+		uint8_t status = PLDM_READ_EVENT_FAIL;
+		k_msgq_put(&recv_arg->msgq, &status, K_NO_WAIT);
+		return;
+	}
+
 	if (rlen > recv_arg->rbuf_len) {
 		LOG_WRN("Response length(%d) is greater than buffer length(%d)!", rlen,
 			recv_arg->rbuf_len);
@@ -164,16 +303,16 @@ void pldm_read_resp_handler(void *args, uint8_t *rbuf, uint16_t rlen)
 	}
 	memcpy(recv_arg->rbuf, rbuf, recv_arg->return_len);
 	uint8_t status = PLDM_READ_EVENT_SUCCESS;
-	k_msgq_put(recv_arg->msgq, &status, K_NO_WAIT);
+	k_msgq_put(&recv_arg->msgq, &status, K_NO_WAIT);
 }
 
 static void pldm_read_timeout_handler(void *args)
 {
 	CHECK_NULL_ARG(args);
 
-	struct k_msgq *msgq = (struct k_msgq *)args;
+	pldm_recv_resp_arg *recv_arg = (pldm_recv_resp_arg *)args;
 	uint8_t status = PLDM_READ_EVENT_TIMEOUT;
-	k_msgq_put(msgq, &status, K_NO_WAIT);
+	k_msgq_put(&recv_arg->msgq, &status, K_NO_WAIT);
 }
 
 /*
@@ -188,32 +327,19 @@ uint16_t mctp_pldm_read(void *mctp_p, pldm_msg *msg, uint8_t *rbuf, uint16_t rbu
 	if (!rbuf_len)
 		return 0;
 
-	uint8_t event_msgq_buffer[1];
-	struct k_msgq *event_msgq_p = (struct k_msgq *)malloc(sizeof(struct k_msgq));
-	if (!event_msgq_p) {
-		LOG_WRN("Failed to allocate event_msgq_p");
-		return 0;
-	}
-	uint16_t ret_len = 0;
 	uint8_t max_retry = 0;
 
-	k_msgq_init(event_msgq_p, event_msgq_buffer, sizeof(uint8_t), 1);
-
-	pldm_recv_resp_arg *recv_arg_p = (pldm_recv_resp_arg *)malloc(sizeof(pldm_recv_resp_arg));
-	if (!recv_arg_p) {
-		SAFE_FREE(event_msgq_p);
-		LOG_WRN("Failed to allocate recv_arg_p");
-		return 0;
-	}
-	recv_arg_p->msgq = event_msgq_p;
-	recv_arg_p->rbuf = rbuf;
-	recv_arg_p->rbuf_len = rbuf_len;
-	recv_arg_p->return_len = 0;
+	/* Context on this stack, no callback may refer to it once this function returns */
+	pldm_recv_resp_arg recv_arg;
+	k_msgq_init(&recv_arg.msgq, recv_arg.msgq_buffer, sizeof(uint8_t), 1);
+	recv_arg.rbuf = rbuf;
+	recv_arg.rbuf_len = rbuf_len;
+	recv_arg.return_len = 0;
 
 	msg->recv_resp_cb_fn = pldm_read_resp_handler;
-	msg->recv_resp_cb_args = (void *)recv_arg_p;
+	msg->recv_resp_cb_args = (void *)&recv_arg;
 	msg->timeout_cb_fn = pldm_read_timeout_handler;
-	msg->timeout_cb_fn_args = (void *)event_msgq_p;
+	msg->timeout_cb_fn_args = (void *)&recv_arg;
 	// use pldm type to decide the timeout and max retry
 	if (msg->hdr.pldm_type == PLDM_TYPE_FW_UPDATE) {
 		msg->timeout_ms = PLDM_FW_UPDATE_TIMEOUT_MS;
@@ -235,26 +361,124 @@ uint16_t mctp_pldm_read(void *mctp_p, pldm_msg *msg, uint8_t *rbuf, uint16_t rbu
 			LOG_WRN("Send msg failed!");
 			continue;
 		}
-		if (k_msgq_get(event_msgq_p, &event, K_FOREVER)) {
-			LOG_WRN("Failed to get status from msgq!");
-			continue;
+		if (k_msgq_get(&recv_arg.msgq, &event,
+			       K_MSEC(msg->timeout_ms + PLDM_READ_WAIT_MARGIN_MS))) {
+			if (wait_msg_cancel(mctp_p, msg->hdr.inst_id, &recv_arg)) {
+				LOG_WRN("Failed to get status from msgq!");
+				continue;
+			}
+			/*
+			 * Not cancellable means the response or timeout callback owns recv_arg and
+			 * always posts an event, wait for it so that recv_arg outlives the callback
+			 * and no stale event is left for the next retry.
+			 */
+			k_msgq_get(&recv_arg.msgq, &event, K_FOREVER);
 		}
 		if (event == PLDM_READ_EVENT_SUCCESS) {
-			ret_len = recv_arg_p->return_len;
-			SAFE_FREE(recv_arg_p);
-			SAFE_FREE(event_msgq_p);
-			return ret_len;
+			return recv_arg.return_len;
 		}
 	}
-	SAFE_FREE(event_msgq_p);
-	SAFE_FREE(recv_arg_p);
 	LOG_ERR("Retry reach max!, pldm msg max retry: %d", PLDM_MSG_MAX_RETRY);
 	return 0;
 }
 
-static uint8_t pldm_msg_timeout_check(sys_slist_t *list, struct k_mutex *mutex)
+static void pldm_async_complete(pldm_async_req *req, uint8_t status)
+{
+	CHECK_NULL_ARG(req);
+
+	req->status = status;
+	if (req->done_fn)
+		req->done_fn(req);
+	/* Last access to req, the owner may reuse it as soon as pldm_async_wait takes this */
+	k_sem_give(&req->done);
+}
+
+static void pldm_async_resp_handler(void *args, uint8_t *rbuf, uint16_t rlen)
+{
+	CHECK_NULL_ARG(args);
+	CHECK_NULL_ARG(rbuf);
+
+	pldm_async_req *req = (pldm_async_req *)args;
+	req->return_len = MIN(rlen, req->rbuf_len);
+	if (req->rbuf && req->return_len)
+		memcpy(req->rbuf, rbuf, req->return_len);
+
+	pldm_async_complete(req, PLDM_ASYNC_DONE);
+}
+
+static void pldm_async_timeout_handler(void *args)
+{
+	CHECK_NULL_ARG(args);
+
+	pldm_async_req *req = (pldm_async_req *)args;
+	req->return_len = 0;
+	pldm_async_complete(req, PLDM_ASYNC_TIMEOUT);
+}
+
+/*
+ * Flow control follows the instance id allocator, sync and async requests share the
+ * PLDM_ASYNC_MAX_INFLIGHT budget of the mctp instance.
+ */
+uint8_t mctp_pldm_send_async(void *mctp_p, pldm_msg *msg, pldm_async_req *req, int32_t wait_ms)
+{
+	CHECK_NULL_ARG_WITH_RETURN(mctp_p, PLDM_ERROR);
+	CHECK_NULL_ARG_WITH_RETURN(msg, PLDM_ERROR);
+	CHECK_NULL_ARG_WITH_RETURN(req, PLDM_ERROR);
+
+	mctp *mctp_inst = (mctp *)mctp_p;
+	int64_t deadline_ms = k_uptime_get() + wait_ms;
+	wait_msg *p = NULL;
+
+	k_sem_init(&req->done, 0, 1);
+	req->status = PLDM_ASYNC_PENDING;
+	req->return_len = 0;
+
+	msg->hdr.rq = PLDM_REQUEST;
+	msg->recv_resp_cb_fn = pldm_async_resp_handler;
+	msg->recv_resp_cb_args = (void *)req;
+	msg->timeout_cb_fn = pldm_async_timeout_handler;
+	msg->timeout_cb_fn_args = (void *)req;
+	if (!msg->timeout_ms)
+		msg->timeout_ms = PLDM_MSG_TIMEOUT_MS;
+
+	while (1) {
+		/* Check the budget and take an instance id under one lock */
+		k_mutex_lock(&wait_recv_resp_mutex, K_FOREVER);
+		if (__builtin_popcount(mctp_inst->pldm_inst_table) <
+		    MIN(PLDM_ASYNC_MAX_INFLIGHT, PLDM_MAX_INSTID_COUNT)) {
+			p = wait_msg_register(mctp_inst, msg);
+			k_mutex_unlock(&wait_recv_resp_mutex);
+			break;
+		}
+		k_mutex_unlock(&wait_recv_resp_mutex);
+
+		int64_t remain_ms = deadline_ms - k_uptime_get();
+		if ((remain_ms <= 0) || k_sem_take(&pldm_instid_free_sem, K_MSEC(remain_ms))) {
+			LOG_DBG("No free instance id in %d ms", wait_ms);
+			return PLDM_ERROR;
+		}
+	}
+
+	if (!p) {
+		return PLDM_ERROR;
+	}
+
+	return pldm_msg_transmit(mctp_inst, msg, p);
+}
+
+uint8_t pldm_async_wait(pldm_async_req *req, k_timeout_t timeout)
+{
+	CHECK_NULL_ARG_WITH_RETURN(req, PLDM_ASYNC_TIMEOUT);
+
+	/* Status alone is not enough, the completion may still be inside k_sem_give */
+	if (k_sem_take(&req->done, timeout))
+		return PLDM_ASYNC_PENDING;
+
+	return req->status;
+}
+
+static uint8_t pldm_msg_timeout_check(struct k_mutex *mutex)
 {
-	CHECK_NULL_ARG_WITH_RETURN(list, MCTP_ERROR);
 	CHECK_NULL_ARG_WITH_RETURN(mutex, MCTP_ERROR);
 
 	if (k_mutex_lock(mutex, K_MSEC(PLDM_RESP_MSG_PROC_MUTEX_TIMEOUT_MS))) {
@@ -262,30 +486,29 @@ static uint8_t pldm_msg_timeout_check(sys_slist_t *list, struct k_mutex *mutex)
 		return MCTP_ERROR;
 	}
 
-	sys_snode_t *node;
-	sys_snode_t *s_node;
-	sys_snode_t *pre_node = NULL;
 	int64_t cur_uptime = k_uptime_get();
 
-	SYS_SLIST_FOR_EACH_NODE_SAFE (list, node, s_node) {
-		wait_msg *p = (wait_msg *)node;
+	for (uint8_t i = 0; i < PLDM_WAIT_MSG_NUM; i++) {
+		wait_msg *p = &wait_msg_pool[i];
+
+		/* skip free entries and the ones whose response is being handled */
+		if (!p->in_use ||
+		    (p->mctp_inst->pldm_wait_msg[p->msg.hdr.inst_id] != (void *)p)) {
+			continue;
+		}
 
 		if ((p->exp_to_ms <= cur_uptime)) {
 			printk("pldm msg timeout!!\n");
 			printk("cmd %x, inst_id %x\n", p->msg.hdr.cmd, p->msg.hdr.inst_id);
-			sys_slist_remove(list, pre_node, node);
 
-			if (unregister_instid(p->mctp_inst, p->msg.hdr.inst_id) == false) {
+			if (wait_msg_detach(p) == false) {
 				LOG_ERR("Unregister failed!");
-				return PLDM_ERROR;
 			}
 
 			if (p->msg.timeout_cb_fn)
 				p->msg.timeout_cb_fn(p->msg.timeout_cb_fn_args);
 
-			free(p);
-		} else {
-			pre_node = node;
+			p->in_use = false;
 		}
 	}
 
@@ -302,7 +525,7 @@ static void pldm_msg_timeout_monitor(void *dummy0, void *dummy1, void *dummy2)
 	while (1) {
 		k_msleep(PLDM_MSG_CHECK_PER_MS);
 
-		pldm_msg_timeout_check(&wait_recv_resp_list, &wait_recv_resp_mutex);
+		pldm_msg_timeout_check(&wait_recv_resp_mutex);
 	}
 }
 
@@ -316,46 +539,32 @@ static uint8_t pldm_resp_msg_process(mctp *const mctp_inst, uint8_t *buf, uint32
 		return PLDM_ERROR;
 
 	const pldm_hdr *hdr = (pldm_hdr *)buf;
-	sys_snode_t *node;
-	sys_snode_t *s_node;
-	sys_snode_t *pre_node = NULL;
-	sys_snode_t *found_node = NULL;
+	wait_msg *p = NULL;
 
 	if (k_mutex_lock(&wait_recv_resp_mutex, K_MSEC(PLDM_RESP_MSG_PROC_MUTEX_TIMEOUT_MS))) {
 		LOG_WRN("pldm mutex is locked over %d ms!!", PLDM_RESP_MSG_PROC_MUTEX_TIMEOUT_MS);
 		return PLDM_ERROR;
 	}
 
-	SYS_SLIST_FOR_EACH_NODE_SAFE (&wait_recv_resp_list, node, s_node) {
-		const wait_msg *p = (wait_msg *)node;
-
-		/* found the proper handler */
-		if ((p->msg.hdr.inst_id == hdr->inst_id) &&
-		    (p->msg.hdr.pldm_type == hdr->pldm_type) && (p->msg.hdr.cmd == hdr->cmd) &&
-		    (p->mctp_inst == mctp_inst)) {
-			found_node = node;
-			sys_slist_remove(&wait_recv_resp_list, pre_node, node);
-
-			if (unregister_instid(mctp_inst, p->msg.hdr.inst_id) == false) {
-				LOG_ERR("Unregister failed!");
-				k_mutex_unlock(&wait_recv_resp_mutex);
-				return PLDM_ERROR;
-			}
-			break;
-		} else {
-			pre_node = node;
+	/* found the proper handler */
+	p = (wait_msg *)mctp_inst->pldm_wait_msg[hdr->inst_id];
+	if (p && (p->msg.hdr.pldm_type == hdr->pldm_type) && (p->msg.hdr.cmd == hdr->cmd)) {
+		/* The entry is detached even if its instance id is out of sync, still complete it */
+		if (wait_msg_detach(p) == false) {
+			LOG_ERR("Unregister failed!");
 		}
+	} else {
+		p = NULL;
 	}
 	k_mutex_unlock(&wait_recv_resp_mutex);
 
-	if (found_node) {
+	if (p) {
 		/* invoke resp handler */
-		wait_msg *p = (wait_msg *)found_node;
 		if (p->msg.recv_resp_cb_fn)
 			/* remove pldm header for handler */
 			p->msg.recv_resp_cb_fn(p->msg.recv_resp_cb_args, buf + sizeof(p->msg.hdr),
 					       len - sizeof(p->msg.hdr));
-		free(p);
+		wait_msg_free(p);
 	}
 
 	return PLDM_SUCCESS;
@@ -444,7 +653,6 @@ uint8_t mctp_pldm_send_msg(void *mctp_p, pldm_msg *msg)
 	CHECK_NULL_ARG_WITH_RETURN(msg, PLDM_ERROR);
 
 	mctp *mctp_inst = (mctp *)mctp_p;
-	uint8_t get_inst_id = 0xff;
 	wait_msg *p = NULL;
 
 	/*
@@ -453,67 +661,15 @@ uint8_t mctp_pldm_send_msg(void *mctp_p, pldm_msg *msg)
 	*/
 
 	if (msg->hdr.rq) {
-		if (register_instid(mctp_p, &get_inst_id) == false) {
-			LOG_ERR("Register failed!");
-			return PLDM_ERROR;
-		}
-
-		/* set pldm header */
-		msg->hdr.inst_id = get_inst_id;
-		msg->hdr.msg_type = MCTP_MSG_TYPE_PLDM;
-
-		/* set mctp extra parameters */
-		msg->ext_params.tag_owner = 1;
-	}
-
-	uint16_t len = sizeof(msg->hdr) + msg->len;
-	uint8_t buf[len];
-
-	LOG_HEXDUMP_DBG(buf, len, __func__);
-
-	memcpy(buf, &msg->hdr, sizeof(msg->hdr));
-	memcpy(buf + sizeof(msg->hdr), msg->buf, msg->len);
-
-	if (msg->hdr.rq) {
-		p = (wait_msg *)malloc(sizeof(*p));
-		if (!p) {
-			LOG_WRN("wait_msg alloc failed!");
-			goto error;
-		}
-
-		memset(p, 0, sizeof(*p));
-		p->mctp_inst = mctp_inst;
-		p->msg = *msg;
-		p->exp_to_ms =
-			k_uptime_get() + (msg->timeout_ms ? msg->timeout_ms : PLDM_MSG_TIMEOUT_MS);
-
 		k_mutex_lock(&wait_recv_resp_mutex, K_FOREVER);
-		sys_slist_append(&wait_recv_resp_list, &p->node);
+		p = wait_msg_register(mctp_inst, msg);
 		k_mutex_unlock(&wait_recv_resp_mutex);
-	}
-
-	uint8_t rc = mctp_send_msg(mctp_inst, buf, len, msg->ext_params);
-	if (rc == MCTP_ERROR) {
-		LOG_ERR("mctp_send_msg error!!");
-
-		if (p != NULL) {
-			sys_slist_find_and_remove(&wait_recv_resp_list, &p->node);
-			SAFE_FREE(p);
-		}
-
-		goto error;
-	}
-
-	return PLDM_SUCCESS;
-
-error:
-	if (msg->hdr.rq) {
-		if (unregister_instid(mctp_p, get_inst_id) == false) {
-			LOG_ERR("Unregister failed!");
+		if (!p) {
+			return PLDM_ERROR;
 		}
 	}
 
-	return PLDM_ERROR;
+	return pldm_msg_transmit(mctp_inst, msg, p);
 }
 
 /**
@@ -95,6 +95,36 @@ typedef struct _pldm_msg {
 	void *timeout_cb_fn_args;
 } pldm_msg;
 
+/* Requests in flight per mctp instance before mctp_pldm_send_async waits, at most 32 */
+#ifndef PLDM_ASYNC_MAX_INFLIGHT
+#define PLDM_ASYNC_MAX_INFLIGHT 8
+#endif
+
+typedef enum {
+	PLDM_ASYNC_PENDING = 0,
+	PLDM_ASYNC_DONE,
+	PLDM_ASYNC_TIMEOUT,
+} PLDM_ASYNC_STATUS;
+
+/*
+ * Caller owned context of an asynchronous request, it must stay valid and must not be reused
+ * until pldm_async_wait has returned its completion. done_fn runs on the mctp rx or pldm
+ * timeout thread and must not block or release req, it is called before the completion is
+ * signaled to pldm_async_wait.
+ */
+typedef struct _pldm_async_req {
+	/* set by caller */
+	uint8_t *rbuf;
+	uint16_t rbuf_len;
+	void (*done_fn)(struct _pldm_async_req *req);
+	void *user_data;
+
+	/* set by pldm */
+	uint8_t status;
+	uint16_t return_len;
+	struct k_sem done;
+} pldm_async_req;
+
 typedef struct _pldm {
 	/* pldm message response timeout prcoess resource */
 	k_tid_t monitor_task;
@@ -137,6 +167,12 @@ int pldm_send_ipmi_request(ipmi_msg *msg);
 
 uint16_t mctp_pldm_read(void *mctp_p, pldm_msg *msg, uint8_t *rbuf, uint16_t rbuf_len);
 
+/* send a request without waiting for its response, wait_ms bounds the wait for a free slot */
+uint8_t mctp_pldm_send_async(void *mctp_p, pldm_msg *msg, pldm_async_req *req, int32_t wait_ms);
+/* wait for an asynchronous request to complete, return its PLDM_ASYNC_STATUS, the completion
+ * of each successfully sent request is returned once */
+uint8_t pldm_async_wait(pldm_async_req *req, k_timeout_t timeout);
+
 pldm_t *pldm_init(void *interface, uint8_t user_idx);
 
 uint8_t get_supported_pldm_type(uint8_t *buf, uint8_t buf_size);
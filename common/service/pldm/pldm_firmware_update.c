@@ -40,6 +40,7 @@
 #include "mp2988.h"
 #include "mp29816a.h"
 #include "raa228249.h"
+#include "vr_fwupdate.h"
 
 LOG_MODULE_DECLARE(pldm);
 
@@ -213,6 +214,36 @@ uint8_t pldm_pcie_switch_update(void *fw_update_param)
 	return pldm_fw_update(fw_update_param, pos);
 }
 
+static const vr_fw_update_entry vr_fw_update_table[] = {
+	{ KEYWORD_VR_ISL69259, isl69259_fwupdate, &isl69259_vr_update_ops },
+	{ KEYWORD_VR_XDPE12284C, xdpe12284c_fwupdate, NULL },
+	{ KEYWORD_VR_MP2971, mp2971_fwupdate, NULL },
+	{ KEYWORD_VR_MP2856, mp2971_fwupdate, NULL },
+	{ KEYWORD_VR_MP2857, mp2971_fwupdate, NULL },
+#ifndef DISABLE_XDPE15284
+	{ KEYWORD_VR_XDPE15284, xdpe15284_fwupdate, NULL },
+#endif
+#ifndef DISABLE_MP2985
+	{ KEYWORD_VR_MP2985, mp2985_fwupdate, NULL },
+#endif
+	{ KEYWORD_VR_RAA229620, raa229621_fwupdate, &raa229621_vr_update_ops },
+	{ KEYWORD_VR_RAA229621, raa229621_fwupdate, &raa229621_vr_update_ops },
+	{ KEYWORD_VR_ISL69260, raa229621_fwupdate, &raa229621_vr_update_ops },
+	{ KEYWORD_VR_MPQ8746, mpq8746_fwupdate, NULL },
+	{ KEYWORD_VR_MP2898, mp289x_fwupdate, NULL },
+	{ KEYWORD_VR_MP2894, mp289x_fwupdate, NULL },
+	{ KEYWORD_VR_TPS53685, tps536xx_fwupdate, &tps536xx_vr_update_ops },
+	{ KEYWORD_VR_TPS536C5, tps536xx_fwupdate, &tps536xx_vr_update_ops },
+	{ KEYWORD_VR_TDA38741, tda38741_fwupdate, NULL },
+	{ KEYWORD_VR_MP2988, mp2988_fwupdate, NULL },
+#ifdef ENABLE_MP29816A
+	{ KEYWORD_VR_MP29816A, mp29816a_fwupdate, NULL },
+#endif
+#ifdef ENABLE_RAA228249
+	{ KEYWORD_VR_RAA228249, raa228249_fwupdate, NULL },
+#endif
+};
+
 uint8_t pldm_vr_update(void *fw_update_param)
 {
 	CHECK_NULL_ARG_WITH_RETURN(fw_update_param, 1);
@@ -221,27 +252,38 @@ uint8_t pldm_vr_update(void *fw_update_param)
 
 	CHECK_NULL_ARG_WITH_RETURN(p->data, 1);
 
-	uint8_t ret = 1;
+	static vr_fw_update_ctx vr_ctx;
 
-	static uint8_t *hex_buff = NULL;
-	if (p->data_ofs == 0) {
-		if (hex_buff) {
-			LOG_ERR("previous hex_buff doesn't clean up!");
-			goto exit;
+	if ((p->data_ofs == 0) && !vr_fw_update_is_resend(&vr_ctx, p->data_ofs, p->data_len)) {
+		if (vr_fw_update_is_active(&vr_ctx)) {
+			LOG_ERR("previous VR update doesn't clean up!");
+			vr_fw_update_abort(&vr_ctx);
+			return 1;
 		}
-		hex_buff = malloc(fw_update_cfg.image_size);
-		if (!hex_buff) {
-			LOG_ERR("Failed to malloc hex_buff");
+
+		const vr_fw_update_entry *entry = vr_fw_update_find(
+			vr_fw_update_table, ARRAY_SIZE(vr_fw_update_table), p->comp_version_str);
+		if (entry == NULL) {
+			LOG_ERR("Non-support VR detected with component string %s!",
+				log_strdup(p->comp_version_str));
+			return 1;
+		}
+
+		if (vr_fw_update_begin(&vr_ctx, entry, p->bus, p->addr,
+				       fw_update_cfg.image_size) == false) {
 			return 1;
 		}
 	}
 
-	if (!hex_buff) {
+	if (!vr_fw_update_is_active(&vr_ctx)) {
 		LOG_ERR("First package(offset=0) has missed");
 		return 1;
 	}
 
-	memcpy(hex_buff + p->data_ofs, p->data, p->data_len);
+	if (vr_fw_update_put_chunk(&vr_ctx, p->data_ofs, p->data, p->data_len) == false) {
+		vr_fw_update_abort(&vr_ctx);
+		return 1;
+	}
 
 	p->next_ofs = p->data_ofs + p->data_len;
 	p->next_len = fw_update_cfg.max_buff_size;
@@ -254,98 +296,7 @@ uint8_t pldm_vr_update(void *fw_update_param)
 		p->next_len = 0;
 	}
 
-	if (!strncmp(p->comp_version_str, KEYWORD_VR_ISL69259,
-		     ARRAY_SIZE(KEYWORD_VR_ISL69259) - 1)) {
-		if (isl69259_fwupdate(p->bus, p->addr, hex_buff, fw_update_cfg.image_size) == false)
-			goto exit;
-	} else if (!strncmp(p->comp_version_str, KEYWORD_VR_XDPE12284C,
-			    ARRAY_SIZE(KEYWORD_VR_XDPE12284C) - 1)) {
-		if (xdpe12284c_fwupdate(p->bus, p->addr, hex_buff, fw_update_cfg.image_size) ==
-		    false)
-			goto exit;
-	} else if ((!strncmp(p->comp_version_str, KEYWORD_VR_MP2971,
-			     ARRAY_SIZE(KEYWORD_VR_MP2971) - 1)) ||
-		   (!strncmp(p->comp_version_str, KEYWORD_VR_MP2856,
-			     ARRAY_SIZE(KEYWORD_VR_MP2856) - 1)) ||
-		   (!strncmp(p->comp_version_str, KEYWORD_VR_MP2857,
-			     ARRAY_SIZE(KEYWORD_VR_MP2857) - 1))) {
-		if (mp2971_fwupdate(p->bus, p->addr, hex_buff, fw_update_cfg.image_size) == false)
-			goto exit;
-	}
-#ifndef DISABLE_XDPE15284
-	else if (!strncmp(p->comp_version_str, KEYWORD_VR_XDPE15284,
-			  ARRAY_SIZE(KEYWORD_VR_XDPE15284) - 1)) {
-		if (xdpe15284_fwupdate(p->bus, p->addr, hex_buff, fw_update_cfg.image_size) ==
-		    false)
-			goto exit;
-	}
-#endif
-#ifndef DISABLE_MP2985
-	else if (!strncmp(p->comp_version_str, KEYWORD_VR_MP2985,
-			  ARRAY_SIZE(KEYWORD_VR_MP2985) - 1)) {
-		if (mp2985_fwupdate(p->bus, p->addr, hex_buff, fw_update_cfg.image_size) == false)
-			goto exit;
-	}
-#endif
-	else if ((!strncmp(p->comp_version_str, KEYWORD_VR_RAA229620,
-			   ARRAY_SIZE(KEYWORD_VR_RAA229620) - 1)) ||
-		 (!strncmp(p->comp_version_str, KEYWORD_VR_RAA229621,
-			   ARRAY_SIZE(KEYWORD_VR_RAA229621) - 1)) ||
-		 (!strncmp(p->comp_version_str, KEYWORD_VR_ISL69260,
-			   ARRAY_SIZE(KEYWORD_VR_ISL69260) - 1))) {
-		if (raa229621_fwupdate(p->bus, p->addr, hex_buff, fw_update_cfg.image_size) ==
-		    false)
-			goto exit;
-	} else if (!strncmp(p->comp_version_str, KEYWORD_VR_MPQ8746,
-			    ARRAY_SIZE(KEYWORD_VR_MPQ8746) - 1)) {
-		if (mpq8746_fwupdate(p->bus, p->addr, hex_buff, fw_update_cfg.image_size) == false)
-			goto exit;
-	} else if ((!strncmp(p->comp_version_str, KEYWORD_VR_MP2898,
-			     ARRAY_SIZE(KEYWORD_VR_MP2898) - 1)) ||
-		   (!strncmp(p->comp_version_str, KEYWORD_VR_MP2894,
-			     ARRAY_SIZE(KEYWORD_VR_MP2894) - 1))) {
-		if (mp289x_fwupdate(p->bus, p->addr, hex_buff, fw_update_cfg.image_size) == false)
-			goto exit;
-	} else if ((!strncmp(p->comp_version_str, KEYWORD_VR_TPS53685,
-			     ARRAY_SIZE(KEYWORD_VR_TPS53685) - 1)) ||
-		   (!strncmp(p->comp_version_str, KEYWORD_VR_TPS536C5,
-			     ARRAY_SIZE(KEYWORD_VR_TPS536C5) - 1))) {
-		if (tps536xx_fwupdate(p->bus, p->addr, hex_buff, fw_update_cfg.image_size) == false)
-			goto exit;
-	} else if (!strncmp(p->comp_version_str, KEYWORD_VR_TDA38741,
-			    ARRAY_SIZE(KEYWORD_VR_TDA38741) - 1)) {
-		if (tda38741_fwupdate(p->bus, p->addr, hex_buff, fw_update_cfg.image_size) == false)
-			goto exit;
-	} else if (!strncmp(p->comp_version_str, KEYWORD_VR_MP2988,
-			    ARRAY_SIZE(KEYWORD_VR_MP2988) - 1)) {
-		if (mp2988_fwupdate(p->bus, p->addr, hex_buff, fw_update_cfg.image_size) == false)
-			goto exit;
-	}
-#ifdef ENABLE_MP29816A
-	else if (!strncmp(p->comp_version_str, KEYWORD_VR_MP29816A,
-			  ARRAY_SIZE(KEYWORD_VR_MP29816A) - 1)) {
-		if (mp29816a_fwupdate(p->bus, p->addr, hex_buff, fw_update_cfg.image_size) == false)
-			goto exit;
-	}
-#endif
-#ifdef ENABLE_RAA228249
-	else if (!strncmp(p->comp_version_str, KEYWORD_VR_RAA228249,
-			  ARRAY_SIZE(KEYWORD_VR_RAA228249) - 1)) {
-		if (raa228249_fwupdate(p->bus, p->addr, hex_buff, fw_update_cfg.image_size) ==
-		    false)
-			goto exit;
-	}
-#endif
-	else {
-		LOG_ERR("Non-support VR detected with component string %s!",
-			log_strdup(p->comp_version_str));
-		goto exit;
-	}
-
-	ret = 0;
-exit:
-	SAFE_FREE(hex_buff);
-	return ret;
+	return (vr_fw_update_end(&vr_ctx) == true) ? 0 : 1;
 }
 
 uint8_t pldm_cpld_update(void *fw_update_param)
@@ -20,6 +20,7 @@
 #include <stdlib.h>
 #include <drivers/spi_nor.h>
 #include <drivers/flash.h>
+#include <sys/crc.h>
 #include "sensor.h"
 #include "plat_def.h"
 #ifdef ENABLE_PLDM_SENSOR
@@ -147,6 +148,7 @@ uint8_t pldm_get_sensor_reading(void *mctp_inst, uint8_t *buf, uint16_t len, uin
 	struct pldm_get_sensor_reading_resp *res_p = (struct pldm_get_sensor_reading_resp *)resp;
 	uint8_t sensor_number = (uint8_t)req_p->sensor_id;
 	PDR_numeric_sensor sensor_pdr;
+	bool is_data_size_set = false;
 
 	if (len != PLDM_GET_SENSOR_READING_REQ_BYTES) {
 		res_p->completion_code = PLDM_ERROR_INVALID_LENGTH;
@@ -166,10 +168,16 @@ uint8_t pldm_get_sensor_reading(void *mctp_inst, uint8_t *buf, uint16_t len, uin
 #ifdef ENABLE_PLDM_SENSOR
 	uint8_t sensor_operational_state = PLDM_SENSOR_STATUSUNKOWN;
 
-	status = pldm_sensor_get_reading_from_cache(sensor_number, &reading,
-						    &sensor_operational_state);
+	uint8_t sensor_data_size = PLDM_SENSOR_DATA_SIZE_UINT32;
+
+	status = pldm_sensor_get_encoded_reading(sensor_number, &reading, &sensor_data_size,
+						 &sensor_operational_state);
 	res_p->completion_code = status;
 	res_p->sensor_operational_state = sensor_operational_state;
+	if (status != PLDM_PLATFORM_INVALID_SENSOR_ID) {
+		res_p->sensor_data_size = sensor_data_size;
+		is_data_size_set = true;
+	}
 #else
 	status = get_sensor_reading(sensor_config, sensor_config_count, sensor_number, &reading,
 				    GET_FROM_CACHE);
@@ -209,11 +217,13 @@ uint8_t pldm_get_sensor_reading(void *mctp_inst, uint8_t *buf, uint16_t len, uin
 #endif
 
 ret:
-	if (get_pdr_with_sensor_id(sensor_number, &sensor_pdr) != 0) {
-		/* Only support 4-bytes unsinged sensor data */
-		res_p->sensor_data_size = PLDM_SENSOR_DATA_SIZE_UINT32;
-	} else {
-		res_p->sensor_data_size = sensor_pdr.sensor_data_size;
+	if (!is_data_size_set) {
+		if (get_pdr_with_sensor_id(sensor_number, &sensor_pdr) != 0) {
+			/* Only support 4-bytes unsinged sensor data */
+			res_p->sensor_data_size = PLDM_SENSOR_DATA_SIZE_UINT32;
+		} else {
+			res_p->sensor_data_size = sensor_pdr.sensor_data_size;
+		}
 	}
 
 	res_p->sensor_event_message_enable = PLDM_EVENTS_DISABLED;
@@ -941,16 +951,66 @@ uint8_t pldm_get_pdr(void *mctp_inst, uint8_t *buf, uint16_t len, uint8_t instan
 	CHECK_NULL_ARG_WITH_RETURN(resp_len, PLDM_ERROR);
 	CHECK_NULL_ARG_WITH_RETURN(ext_params, PLDM_ERROR);
 
-	int response_count = 0;
 	uint32_t record_count = get_record_count();
+	uint32_t record_size = 0, offset = 0, response_count = 0;
 	struct pldm_get_pdr_req *req_p = (struct pldm_get_pdr_req *)buf;
 	struct pldm_get_pdr_resp *res_p = (struct pldm_get_pdr_resp *)resp;
 
-	response_count =
-		get_pdr_table_via_record_handle(&res_p->record_data[0], req_p->record_handle);
-	if (response_count <= 0) {
-		LOG_ERR("Failed to get PDR for record handle: %x\n", req_p->record_handle);
-		return PLDM_ERROR;
+	if (len != sizeof(struct pldm_get_pdr_req)) {
+		res_p->completion_code = PLDM_ERROR_INVALID_LENGTH;
+		*resp_len = 1;
+		return PLDM_SUCCESS;
+	}
+
+	const uint8_t *record = pdr_get_record(req_p->record_handle, &record_size);
+	if (record == NULL) {
+		res_p->completion_code = PLDM_PLATFORM_INVALID_RECORD_HANDLE;
+		*resp_len = 1;
+		return PLDM_SUCCESS;
+	}
+
+	switch (req_p->transfer_operation_flag) {
+	case PLDM_GET_PDR_GET_FIRST_PART:
+		offset = 0;
+		break;
+	case PLDM_GET_PDR_GET_NEXT_PART:
+		/* The data transfer handle is the byte offset of the next part in the record */
+		offset = req_p->data_transfer_handle;
+		if (offset >= record_size) {
+			res_p->completion_code = PLDM_PLATFORM_INVALID_DATA_TRANSFER_HANDLE;
+			*resp_len = 1;
+			return PLDM_SUCCESS;
+		}
+		break;
+	default:
+		res_p->completion_code = PLDM_PLATFORM_INVALID_TRANSFER_OPERATION_FLAG;
+		*resp_len = 1;
+		return PLDM_SUCCESS;
+	}
+
+	/* A request count of zero asks for as much of the record as fits in one response */
+	response_count = record_size - offset;
+	if (req_p->request_count != 0 && response_count > req_p->request_count) {
+		response_count = req_p->request_count;
+	}
+	if (response_count > sizeof(res_p->record_data)) {
+		response_count = sizeof(res_p->record_data);
+	}
+	/* Leave room for the TransferCRC behind the last part of a multipart transfer */
+	if ((offset != 0) && (offset + response_count == record_size) &&
+	    (response_count == sizeof(res_p->record_data))) {
+		response_count--;
+	}
+	memcpy(res_p->record_data, record + offset, response_count);
+
+	if (offset + response_count < record_size) {
+		res_p->transfer_flag =
+			(offset == 0) ? PLDM_TRANSFER_FLAG_START : PLDM_TRANSFER_FLAG_MIDDLE;
+		res_p->next_data_transfer_handle = offset + response_count;
+	} else {
+		res_p->transfer_flag = (offset == 0) ? PLDM_TRANSFER_FLAG_START_AND_END :
+						       PLDM_TRANSFER_FLAG_END;
+		res_p->next_data_transfer_handle = 0;
 	}
 
 	if (req_p->record_handle + 1 >= record_count) {
@@ -959,9 +1019,14 @@ uint8_t pldm_get_pdr(void *mctp_inst, uint8_t *buf, uint16_t len, uint8_t instan
 		res_p->next_record_handle = req_p->record_handle + 1;
 	}
 
-	res_p->transfer_flag = PLDM_TRANSFER_FLAG_START_AND_END;
 	res_p->response_count = response_count;
-	*resp_len = sizeof(struct pldm_get_pdr_resp);
+	*resp_len = sizeof(struct pldm_get_pdr_resp) - sizeof(res_p->record_data) + response_count;
+
+	/* DSP0248 GetPDR: TransferCRC over the whole record is only present with the END flag */
+	if (res_p->transfer_flag == PLDM_TRANSFER_FLAG_END) {
+		res_p->record_data[response_count] = crc8(record, record_size, 0x07, 0x00, false);
+		*resp_len += 1;
+	}
 	res_p->completion_code = PLDM_SUCCESS;
 	return PLDM_SUCCESS;
 }
@@ -181,6 +181,10 @@ enum pldm_platform_completion_codes {
 	PLDM_PLATFORM_INVALID_STATE_VALUE = 0x81,
 	PLDM_PLATFORM_UNSUPPORTED_EFFECTERSTATE = 0x82,
 
+	/* GetPDR */
+	PLDM_PLATFORM_INVALID_DATA_TRANSFER_HANDLE = 0x80,
+	PLDM_PLATFORM_INVALID_TRANSFER_OPERATION_FLAG = 0x81,
+	PLDM_PLATFORM_INVALID_RECORD_HANDLE = 0x82,
 };
 
 enum pldm_oem_platform_completion_codes {
@@ -395,6 +399,11 @@ enum pldm_get_pdr_transfer_flag {
 	PLDM_TRANSFER_FLAG_START_AND_END = 0x05,
 };
 
+enum pldm_get_pdr_transfer_operation_flag {
+	PLDM_GET_PDR_GET_NEXT_PART = 0x00,
+	PLDM_GET_PDR_GET_FIRST_PART = 0x01,
+};
+
 struct pldm_get_pdr_req {
 	uint32_t record_handle;
 	uint32_t data_transfer_handle;
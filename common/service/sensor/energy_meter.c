@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <logging/log.h>
+#include "libutil.h"
+#include "energy_meter.h"
+
+LOG_MODULE_REGISTER(energy_meter);
+
+typedef struct _energy_meter_sample {
+	uint64_t energy;
+	uint64_t time;
+	int64_t uptime_ms;
+} energy_meter_sample;
+
+typedef struct _energy_meter {
+	bool used;
+	uint8_t dev;
+	uint8_t counter;
+	uint32_t last_energy;
+	uint32_t last_time;
+	uint8_t head;
+	uint8_t count;
+	energy_meter_sample sample[ENERGY_METER_SAMPLE_NUM];
+} energy_meter;
+
+static energy_meter meter_table[ENERGY_METER_NUM];
+K_MUTEX_DEFINE(energy_meter_mutex);
+
+static energy_meter *energy_meter_find(uint8_t dev, uint8_t counter, bool alloc)
+{
+	energy_meter *free_meter = NULL;
+	for (int i = 0; i < ENERGY_METER_NUM; i++) {
+		if (!meter_table[i].used) {
+			if (free_meter == NULL) {
+				free_meter = &meter_table[i];
+			}
+			continue;
+		}
+		if ((meter_table[i].dev == dev) && (meter_table[i].counter == counter)) {
+			return &meter_table[i];
+		}
+	}
+
+	if (!alloc || (free_meter == NULL)) {
+		return NULL;
+	}
+
+	memset(free_meter, 0, sizeof(energy_meter));
+	free_meter->used = true;
+	free_meter->dev = dev;
+	free_meter->counter = counter;
+	return free_meter;
+}
+
+static energy_meter_sample *energy_meter_sample_at(energy_meter *meter, uint8_t age)
+{
+	/* age 0 is the newest sample */
+	return &meter->sample[(meter->head + ENERGY_METER_SAMPLE_NUM - 1 - age) %
+			      ENERGY_METER_SAMPLE_NUM];
+}
+
+bool energy_meter_update(uint8_t dev, uint8_t counter, uint32_t energy, uint32_t time)
+{
+	bool ret = false;
+
+	k_mutex_lock(&energy_meter_mutex, K_FOREVER);
+	energy_meter *meter = energy_meter_find(dev, counter, true);
+	if (meter == NULL) {
+		LOG_WRN("No free energy meter for device 0x%x counter %d", dev, counter);
+		goto unlock;
+	}
+
+	energy_meter_sample new_sample = { 0 };
+	if (meter->count != 0) {
+		energy_meter_sample *last = energy_meter_sample_at(meter, 0);
+		/* Unsigned subtraction handles a single wraparound of either counter */
+		uint32_t diff_energy = energy - meter->last_energy;
+		uint32_t diff_time = time - meter->last_time;
+		if (diff_time == 0) {
+			/* The device has not updated its counters since the last sample */
+			ret = true;
+			goto unlock;
+		}
+		new_sample.energy = last->energy + diff_energy;
+		new_sample.time = last->time + diff_time;
+	}
+	new_sample.uptime_ms = k_uptime_get();
+
+	meter->sample[meter->head] = new_sample;
+	meter->head = (meter->head + 1) % ENERGY_METER_SAMPLE_NUM;
+	if (meter->count < ENERGY_METER_SAMPLE_NUM) {
+		meter->count++;
+	}
+	meter->last_energy = energy;
+	meter->last_time = time;
+	ret = true;
+
+unlock:
+	k_mutex_unlock(&energy_meter_mutex);
+	return ret;
+}
+
+/*
+ * Energy and time consumed between the newest sample and the oldest sample that is still
+ * within window_ms of it, so the average power is taken over the whole window no matter
+ * how often the counters were sampled. Returns false until two samples are available.
+ */
+bool energy_meter_get_delta(uint8_t dev, uint8_t counter, uint32_t window_ms,
+			    uint32_t *diff_energy, uint32_t *diff_time)
+{
+	CHECK_NULL_ARG_WITH_RETURN(diff_energy, false);
+	CHECK_NULL_ARG_WITH_RETURN(diff_time, false);
+
+	bool ret = false;
+
+	k_mutex_lock(&energy_meter_mutex, K_FOREVER);
+	energy_meter *meter = energy_meter_find(dev, counter, false);
+	if ((meter == NULL) || (meter->count < 2)) {
+		goto unlock;
+	}
+
+	energy_meter_sample *newest = energy_meter_sample_at(meter, 0);
+	energy_meter_sample *oldest = energy_meter_sample_at(meter, 1);
+	if (window_ms != ENERGY_METER_LAST_SAMPLE) {
+		for (uint8_t age = 2; age < meter->count; age++) {
+			energy_meter_sample *sample = energy_meter_sample_at(meter, age);
+			if ((newest->uptime_ms - sample->uptime_ms) > window_ms) {
+				break;
+			}
+			oldest = sample;
+		}
+	}
+
+	uint64_t energy = newest->energy - oldest->energy;
+	uint64_t time = newest->time - oldest->time;
+	*diff_energy = (energy > UINT32_MAX) ? UINT32_MAX : (uint32_t)energy;
+	*diff_time = (time > UINT32_MAX) ? UINT32_MAX : (uint32_t)time;
+	ret = true;
+
+unlock:
+	k_mutex_unlock(&energy_meter_mutex);
+	return ret;
+}
+
+/* Forget the history of a device, e.g. when its counters restart after a power cycle */
+void energy_meter_reset(uint8_t dev)
+{
+	k_mutex_lock(&energy_meter_mutex, K_FOREVER);
+	for (int i = 0; i < ENERGY_METER_NUM; i++) {
+		if (meter_table[i].used && (meter_table[i].dev == dev)) {
+			meter_table[i].used = false;
+		}
+	}
+	k_mutex_unlock(&energy_meter_mutex);
+}
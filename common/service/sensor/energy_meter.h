@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ENERGY_METER_H
+#define ENERGY_METER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Integrates free running 32-bit energy/time counters of a device into average power.
+ * A meter is keyed by (device, counter), so every CPU socket or DIMM group keeps its
+ * own history, and it may be fed more often than the sensor sweep reads it.
+ */
+
+#ifndef ENERGY_METER_NUM
+#define ENERGY_METER_NUM 8
+#endif
+#ifndef ENERGY_METER_SAMPLE_NUM
+#define ENERGY_METER_SAMPLE_NUM 8
+#endif
+
+/* Use the two newest samples instead of a time window */
+#define ENERGY_METER_LAST_SAMPLE 0
+
+bool energy_meter_update(uint8_t dev, uint8_t counter, uint32_t energy, uint32_t time);
+bool energy_meter_get_delta(uint8_t dev, uint8_t counter, uint32_t window_ms,
+			    uint32_t *diff_energy, uint32_t *diff_time);
+void energy_meter_reset(uint8_t dev);
+
+#endif
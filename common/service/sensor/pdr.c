@@ -33,51 +33,108 @@ PDR_numeric_sensor *numeric_sensor_table = NULL;
 PDR_sensor_auxiliary_names *sensor_auxiliary_names_table = NULL;
 PDR_entity_auxiliary_names *entity_auxiliary_names_table = NULL;
 
+/* All PDR tables live back to back in one buffer laid out in record handle order, so a
+ * GetPDR request is served by slicing the buffer instead of searching each table. */
+static uint8_t *pdr_repository = NULL;
+
+typedef struct {
+	uint8_t *base;
+	uint32_t first_handle;
+	uint32_t count;
+	uint32_t record_size;
+} pdr_section;
+
+enum PDR_SECTION {
+	PDR_SECTION_NUMERIC_SENSOR,
+	PDR_SECTION_SENSOR_AUX_NAMES,
+	PDR_SECTION_ENTITY_AUX_NAMES,
+	PDR_SECTION_MAX,
+};
+
+static pdr_section pdr_sections[PDR_SECTION_MAX];
+
 int pdr_init(void)
 {
-	uint32_t pdr_count = 0, record_handle = 0x0, largest_record_size = 0;
+	uint32_t record_handle = 0x0, largest_record_size = 0, repository_size = 0;
+	uint32_t pdr_count = 0;
+	pdr_section *section = NULL;
 
 	LOG_INF("pldm disable sensors count: 0x%x", plat_get_disabled_sensor_count());
 
-	pdr_count = plat_get_pdr_size(PLDM_NUMERIC_SENSOR_PDR);
+	pdr_info = (PDR_INFO *)malloc(sizeof(PDR_INFO));
+	if (pdr_info == NULL) {
+		LOG_ERR("Failed to malloc PDR info");
+		return -1;
+	}
+	memset(pdr_info, 0, sizeof(PDR_INFO));
+
+	pdr_sections[PDR_SECTION_NUMERIC_SENSOR].count = plat_get_pdr_size(PLDM_NUMERIC_SENSOR_PDR);
+	pdr_sections[PDR_SECTION_NUMERIC_SENSOR].record_size = sizeof(PDR_numeric_sensor);
+
+	pdr_sections[PDR_SECTION_SENSOR_AUX_NAMES].count =
+		plat_get_pdr_size(PLDM_SENSOR_AUXILIARY_NAMES_PDR);
+	pdr_sections[PDR_SECTION_SENSOR_AUX_NAMES].record_size =
+		sizeof(PDR_sensor_auxiliary_names);
+
+	pdr_sections[PDR_SECTION_ENTITY_AUX_NAMES].count =
+		plat_get_pdr_size(PLDM_ENTITY_AUXILIARY_NAMES_PDR);
+	if (pdr_sections[PDR_SECTION_ENTITY_AUX_NAMES].count != 0) {
+		plat_init_entity_aux_names_pdr_table();
+		pdr_sections[PDR_SECTION_ENTITY_AUX_NAMES].record_size =
+			plat_get_pdr_entity_aux_names_size();
+	}
+
+	for (int i = 0; i < PDR_SECTION_MAX; i++) {
+		pdr_sections[i].first_handle = record_handle;
+		record_handle += pdr_sections[i].count;
+		repository_size += pdr_sections[i].count * pdr_sections[i].record_size;
+		if (pdr_sections[i].count != 0 &&
+		    largest_record_size < pdr_sections[i].record_size) {
+			largest_record_size = pdr_sections[i].record_size;
+		}
+	}
+
+	if (repository_size != 0) {
+		pdr_repository = (uint8_t *)malloc(repository_size);
+		if (pdr_repository == NULL) {
+			LOG_ERR("Failed to malloc PDR repository, size: %u", repository_size);
+			return -1;
+		}
+	}
+
+	uint32_t offset = 0;
+	for (int i = 0; i < PDR_SECTION_MAX; i++) {
+		if (pdr_sections[i].count != 0) {
+			pdr_sections[i].base = pdr_repository + offset;
+		}
+		offset += pdr_sections[i].count * pdr_sections[i].record_size;
+	}
+
+	section = &pdr_sections[PDR_SECTION_NUMERIC_SENSOR];
+	pdr_count = section->count;
 	if (pdr_count != 0) {
 		total_record_count += pdr_count;
-		numeric_sensor_table =
-			(PDR_numeric_sensor *)malloc(pdr_count * sizeof(PDR_numeric_sensor));
+		numeric_sensor_table = (PDR_numeric_sensor *)section->base;
 		plat_load_numeric_sensor_pdr_table(numeric_sensor_table);
-		if (numeric_sensor_table == NULL) {
-			LOG_ERR("Failed to malloc numeric sensor PDR table");
-			return -1;
-		}
-		pdr_info->repository_size += pdr_count * sizeof(PDR_numeric_sensor);
 
 		for (uint32_t i = 0; i < pdr_count; i++) {
-			numeric_sensor_table[i].pdr_common_header.record_handle = record_handle;
+			numeric_sensor_table[i].pdr_common_header.record_handle =
+				section->first_handle + i;
 			numeric_sensor_table[i].pdr_common_header.data_length +=
 				(sizeof(PDR_numeric_sensor) - sizeof(PDR_common_header));
-			record_handle++;
-		}
-
-		if (largest_record_size < sizeof(PDR_numeric_sensor)) {
-			largest_record_size = sizeof(PDR_numeric_sensor);
 		}
 	}
 
-	pdr_count = plat_get_pdr_size(PLDM_SENSOR_AUXILIARY_NAMES_PDR);
+	section = &pdr_sections[PDR_SECTION_SENSOR_AUX_NAMES];
+	pdr_count = section->count;
 	if (pdr_count != 0) {
 		total_record_count += pdr_count;
-		sensor_auxiliary_names_table = (PDR_sensor_auxiliary_names *)malloc(
-			pdr_count * sizeof(PDR_sensor_auxiliary_names));
+		sensor_auxiliary_names_table = (PDR_sensor_auxiliary_names *)section->base;
 		plat_load_aux_sensor_names_pdr_table(sensor_auxiliary_names_table);
-		if (sensor_auxiliary_names_table == NULL) {
-			LOG_ERR("Failed to malloc sensor auxiliary names PDR table");
-			return -1;
-		}
-		pdr_info->repository_size += pdr_count * sizeof(PDR_sensor_auxiliary_names);
 
 		for (uint32_t i = 0; i < pdr_count; i++) {
 			sensor_auxiliary_names_table[i].pdr_common_header.record_handle =
-				record_handle;
+				section->first_handle + i;
 			sensor_auxiliary_names_table[i].pdr_common_header.data_length +=
 				(sizeof(PDR_sensor_auxiliary_names) - sizeof(PDR_common_header));
 
@@ -87,31 +144,19 @@ int pdr_init(void)
 				sensor_auxiliary_names_table[i].sensorName[j] = sys_cpu_to_be16(
 					sensor_auxiliary_names_table[i].sensorName[j]);
 			}
-
-			record_handle++;
-		}
-
-		if (largest_record_size < sizeof(PDR_sensor_auxiliary_names)) {
-			largest_record_size = sizeof(PDR_sensor_auxiliary_names);
 		}
 	}
 
-	pdr_count = plat_get_pdr_size(PLDM_ENTITY_AUXILIARY_NAMES_PDR);
+	section = &pdr_sections[PDR_SECTION_ENTITY_AUX_NAMES];
+	pdr_count = section->count;
 	if (pdr_count != 0) {
-		plat_init_entity_aux_names_pdr_table();
 		total_record_count += pdr_count;
-		entity_auxiliary_names_table = (PDR_entity_auxiliary_names *)malloc(
-			pdr_count * plat_get_pdr_entity_aux_names_size());
+		entity_auxiliary_names_table = (PDR_entity_auxiliary_names *)section->base;
 		plat_load_entity_aux_names_pdr_table(entity_auxiliary_names_table);
-		if (entity_auxiliary_names_table == NULL) {
-			LOG_ERR("Failed to malloc entity auxiliary names PDR table");
-			return -1;
-		}
-		pdr_info->repository_size += pdr_count * plat_get_pdr_entity_aux_names_size();
 
 		for (uint32_t i = 0; i < pdr_count; i++) {
 			entity_auxiliary_names_table[i].pdr_common_header.record_handle =
-				record_handle;
+				section->first_handle + i;
 			entity_auxiliary_names_table[i].pdr_common_header.data_length +=
 				(plat_get_pdr_entity_aux_names_size() - sizeof(PDR_common_header));
 			// Convert entity name to UTF16-BE
@@ -120,22 +165,12 @@ int pdr_init(void)
 				entity_auxiliary_names_table[i].entityName[j] = sys_cpu_to_be16(
 					entity_auxiliary_names_table[i].entityName[j]);
 			}
-
-			record_handle++;
-		}
-
-		if (largest_record_size < sizeof(PDR_entity_auxiliary_names)) {
-			largest_record_size = sizeof(PDR_entity_auxiliary_names);
 		}
 	}
 
-	pdr_info = (PDR_INFO *)malloc(sizeof(PDR_INFO));
-	if (pdr_info == NULL) {
-		LOG_ERR("Failed to malloc PDR info");
-		return false;
-	}
 	pdr_info->repository_state = PDR_STATE_AVAILABLE;
 	pdr_info->record_count = total_record_count;
+	pdr_info->repository_size = repository_size;
 	pdr_info->largest_record_size = largest_record_size;
 
 	return 0;
@@ -235,49 +270,38 @@ int pldm_get_sensor_name_via_sensor_id(uint16_t sensor_id, char *sensor_name, si
 	return -1;
 }
 
-int get_pdr_table_via_record_handle(uint8_t *record_data, uint32_t record_handle)
+const uint8_t *pdr_get_record(uint32_t record_handle, uint32_t *record_size)
 {
-	uint32_t numeric_sensor_pdr_count = 0, aux_sensor_name_pdr_count = 0,
-		 entity_aux_name_pdr_count = 0;
+	CHECK_NULL_ARG_WITH_RETURN(record_size, NULL);
 
-	numeric_sensor_pdr_count = plat_get_pdr_size(PLDM_NUMERIC_SENSOR_PDR);
-	aux_sensor_name_pdr_count = plat_get_pdr_size(PLDM_SENSOR_AUXILIARY_NAMES_PDR);
-	entity_aux_name_pdr_count = plat_get_pdr_size(PLDM_ENTITY_AUXILIARY_NAMES_PDR);
-
-	if (record_handle < numeric_sensor_pdr_count) {
-		for (int i = 0; i < numeric_sensor_pdr_count; i++) {
-			if (numeric_sensor_table[i].pdr_common_header.record_handle ==
-			    record_handle) {
-				memcpy(record_data, &numeric_sensor_table[i],
-				       sizeof(PDR_numeric_sensor));
-				return sizeof(PDR_numeric_sensor);
-			}
-		}
-	} else if (record_handle < numeric_sensor_pdr_count + aux_sensor_name_pdr_count) {
-		for (int i = 0; i < aux_sensor_name_pdr_count; i++) {
-			if (sensor_auxiliary_names_table[i].pdr_common_header.record_handle ==
-			    record_handle) {
-				memcpy(record_data, &sensor_auxiliary_names_table[i],
-				       sizeof(PDR_sensor_auxiliary_names));
-				return sizeof(PDR_sensor_auxiliary_names);
-			}
+	for (int i = 0; i < PDR_SECTION_MAX; i++) {
+		const pdr_section *section = &pdr_sections[i];
+		if (record_handle < section->first_handle ||
+		    record_handle - section->first_handle >= section->count) {
+			continue;
 		}
-	} else if (record_handle < numeric_sensor_pdr_count + aux_sensor_name_pdr_count +
-					   entity_aux_name_pdr_count) {
-		for (int i = 0; i < entity_aux_name_pdr_count; i++) {
-			if (entity_auxiliary_names_table[i].pdr_common_header.record_handle ==
-			    record_handle) {
-				memcpy(record_data, &entity_auxiliary_names_table[i],
-				       plat_get_pdr_entity_aux_names_size());
-				return plat_get_pdr_entity_aux_names_size();
-			}
-		}
-	} else {
-		LOG_ERR("Failed to get PDR via record handle: %x\n", record_handle);
+
+		*record_size = section->record_size;
+		return section->base +
+		       (record_handle - section->first_handle) * section->record_size;
+	}
+
+	LOG_ERR("Failed to get PDR via record handle: %x", record_handle);
+	return NULL;
+}
+
+int get_pdr_table_via_record_handle(uint8_t *record_data, uint32_t record_handle)
+{
+	CHECK_NULL_ARG_WITH_RETURN(record_data, -1);
+
+	uint32_t record_size = 0;
+	const uint8_t *record = pdr_get_record(record_handle, &record_size);
+	if (record == NULL) {
 		return -1;
 	}
 
-	return -1;
+	memcpy(record_data, record, record_size);
+	return record_size;
 }
 
 uint32_t get_record_count()
@@ -38,6 +38,148 @@ K_THREAD_STACK_ARRAY_DEFINE(pldm_sensor_poll_stacks, MAX_SENSOR_THREAD_ID,
 pldm_sensor_thread *pldm_sensor_thread_list;
 pldm_sensor_info *pldm_sensor_list[MAX_SENSOR_THREAD_ID];
 
+/* Open addressing sensor ID index over every thread's sensor list, sized to a power of two
+ * at least twice the sensor count so probes stay short. Filled in as each polling thread
+ * loads its list. The sensor count may depend on board ID, so a sensor that doesn't fit, or
+ * a failed allocation, leaves the index incomplete and lookups then fall back to the scan
+ * of every list. */
+typedef struct {
+	pldm_sensor_info *info;
+	uint16_t sensor_id;
+	uint8_t thread_id;
+} pldm_sensor_index_entry;
+
+static pldm_sensor_index_entry *pldm_sensor_index;
+static uint32_t pldm_sensor_index_mask;
+static bool pldm_sensor_index_complete;
+static struct k_spinlock pldm_sensor_index_lock;
+static struct k_spinlock pldm_sensor_encode_lock;
+
+static uint32_t pldm_sensor_index_hash(uint16_t sensor_id)
+{
+	return ((uint32_t)sensor_id * 0x9E3779B1) & pldm_sensor_index_mask;
+}
+
+static int pldm_sensor_index_init(void)
+{
+	uint32_t total_count = 0, capacity = 1;
+
+	for (int t_id = 0; t_id < MAX_SENSOR_THREAD_ID; t_id++) {
+		int count = plat_pldm_sensor_get_sensor_count(t_id);
+		if (count > 0) {
+			total_count += count;
+		}
+	}
+
+	while (capacity < total_count * 2) {
+		capacity <<= 1;
+	}
+
+	pldm_sensor_index = (pldm_sensor_index_entry *)calloc(capacity, sizeof(*pldm_sensor_index));
+	if (pldm_sensor_index == NULL) {
+		LOG_ERR("Failed to allocate PLDM sensor ID index, capacity: %u", capacity);
+		return -1;
+	}
+	pldm_sensor_index_mask = capacity - 1;
+	pldm_sensor_index_complete = true;
+
+	return 0;
+}
+
+static void pldm_sensor_index_add(int thread_id, pldm_sensor_info *list, int count)
+{
+	if (pldm_sensor_index == NULL) {
+		return;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&pldm_sensor_index_lock);
+
+	for (int s_id = 0; s_id < count; s_id++) {
+		uint16_t sensor_id = list[s_id].pdr_numeric_sensor.sensor_id;
+		uint32_t slot = pldm_sensor_index_hash(sensor_id);
+		uint32_t probe = 0;
+
+		while (pldm_sensor_index[slot].info != NULL &&
+		       pldm_sensor_index[slot].sensor_id != sensor_id) {
+			if (++probe > pldm_sensor_index_mask) {
+				break;
+			}
+			slot = (slot + 1) & pldm_sensor_index_mask;
+		}
+
+		if (probe > pldm_sensor_index_mask) {
+			LOG_WRN("PLDM sensor ID index is full, sensor 0x%x isn't indexed",
+				sensor_id);
+			pldm_sensor_index_complete = false;
+			continue;
+		}
+
+		if (pldm_sensor_index[slot].info != NULL) {
+			LOG_WRN("Duplicate PLDM sensor ID 0x%x in thread%d and thread%d", sensor_id,
+				pldm_sensor_index[slot].thread_id, thread_id);
+			// Keep the entry of the lower thread, same as a scan in thread order
+			if (pldm_sensor_index[slot].thread_id < thread_id) {
+				continue;
+			}
+		}
+
+		pldm_sensor_index[slot].sensor_id = sensor_id;
+		pldm_sensor_index[slot].thread_id = thread_id;
+		pldm_sensor_index[slot].info = &list[s_id];
+	}
+
+	k_spin_unlock(&pldm_sensor_index_lock, key);
+}
+
+static pldm_sensor_info *pldm_sensor_scan_via_sensor_id(uint16_t sensor_id)
+{
+	for (int t_id = 0; t_id < MAX_SENSOR_THREAD_ID; t_id++) {
+		if (pldm_sensor_list[t_id] == NULL) {
+			continue;
+		}
+
+		int pldm_sensor_count = plat_pldm_sensor_get_sensor_count(t_id);
+		for (int s_id = 0; s_id < pldm_sensor_count; s_id++) {
+			if (sensor_id == pldm_sensor_list[t_id][s_id].pdr_numeric_sensor.sensor_id) {
+				return &pldm_sensor_list[t_id][s_id];
+			}
+		}
+	}
+
+	return NULL;
+}
+
+pldm_sensor_info *pldm_sensor_find_via_sensor_id(uint16_t sensor_id)
+{
+	pldm_sensor_info *info = NULL;
+	bool complete = false;
+
+	if (pldm_sensor_index != NULL) {
+		k_spinlock_key_t key = k_spin_lock(&pldm_sensor_index_lock);
+
+		uint32_t slot = pldm_sensor_index_hash(sensor_id);
+		for (uint32_t probe = 0; probe <= pldm_sensor_index_mask; probe++) {
+			if (pldm_sensor_index[slot].info == NULL) {
+				break;
+			}
+			if (pldm_sensor_index[slot].sensor_id == sensor_id) {
+				info = pldm_sensor_index[slot].info;
+				break;
+			}
+			slot = (slot + 1) & pldm_sensor_index_mask;
+		}
+		complete = pldm_sensor_index_complete;
+
+		k_spin_unlock(&pldm_sensor_index_lock, key);
+	}
+
+	if ((info == NULL) && !complete) {
+		info = pldm_sensor_scan_via_sensor_id(sensor_id);
+	}
+
+	return info;
+}
+
 __weak pldm_sensor_thread *plat_pldm_sensor_load_thread()
 {
 	return NULL;
@@ -184,52 +326,37 @@ int pldm_sensor_get_info_via_sensor_id(uint16_t sensor_id, float *resolution, fl
 	CHECK_NULL_ARG_WITH_RETURN(cache, -1);
 	CHECK_NULL_ARG_WITH_RETURN(sensor_operational_state, -1);
 
-	int t_id = 0, s_id = 0, pldm_sensor_count = 0;
-
-	for (t_id = 0; t_id < MAX_SENSOR_THREAD_ID; t_id++) {
-		pldm_sensor_count = plat_pldm_sensor_get_sensor_count(t_id);
-		for (s_id = 0; s_id < pldm_sensor_count; s_id++) {
-			if (sensor_id ==
-			    pldm_sensor_list[t_id][s_id].pdr_numeric_sensor.sensor_id) {
-				// Get from numeric sensor PDR
-				*resolution =
-					pldm_sensor_list[t_id][s_id].pdr_numeric_sensor.resolution;
-				*offset = pldm_sensor_list[t_id][s_id].pdr_numeric_sensor.offset;
-				*unit_modifier = pldm_sensor_list[t_id][s_id]
-							 .pdr_numeric_sensor.unit_modifier;
-				// Get from sensor config
-				*cache = pldm_sensor_list[t_id][s_id].pldm_sensor_cfg.cache;
-				*sensor_operational_state =
-					pldm_sensor_list[t_id][s_id].pldm_sensor_cfg.cache_status;
-				return 0;
-			}
-		}
+	const pldm_sensor_info *info = pldm_sensor_find_via_sensor_id(sensor_id);
+	if (info == NULL) {
+		return -1;
 	}
 
-	return -1;
+	// Get from numeric sensor PDR
+	*resolution = info->pdr_numeric_sensor.resolution;
+	*offset = info->pdr_numeric_sensor.offset;
+	*unit_modifier = info->pdr_numeric_sensor.unit_modifier;
+	// Get from sensor config
+	*cache = info->pldm_sensor_cfg.cache;
+	*sensor_operational_state = info->pldm_sensor_cfg.cache_status;
+
+	return 0;
 }
 
-uint8_t pldm_sensor_get_reading_from_cache(uint16_t sensor_id, int *reading,
-					   uint8_t *sensor_operational_state)
+static void pldm_sensor_prepare_encoding(pldm_sensor_info *list, int count)
 {
-	CHECK_NULL_ARG_WITH_RETURN(reading, PLDM_ERROR);
-	CHECK_NULL_ARG_WITH_RETURN(sensor_operational_state, PLDM_ERROR);
-
-	float sensor_reading = 0, decimal = 0, resolution = 0, offset = 0;
-	int cache_reading = 0;
-	int8_t unit_modifier = 0;
-	int16_t integer = 0;
-
-	if (pldm_sensor_get_info_via_sensor_id(sensor_id, &resolution, &offset, &unit_modifier,
-					       &cache_reading, sensor_operational_state) != 0) {
-		// Couldn't find sensor id in pldm_sensor_list
-		return PLDM_PLATFORM_INVALID_SENSOR_ID;
+	for (int s_id = 0; s_id < count; s_id++) {
+		list[s_id].reading_scale =
+			power(10, -1 * list[s_id].pdr_numeric_sensor.unit_modifier);
+		list[s_id].encoded_valid = false;
 	}
+}
 
-	if (resolution == 0) {
-		// The value of resolution couldn't be 0
-		return PLDM_ERROR_INVALID_DATA;
-	}
+int pldm_sensor_encode_reading(const pldm_sensor_info *info, int cache_reading)
+{
+	CHECK_NULL_ARG_WITH_RETURN(info, 0);
+
+	float sensor_reading = 0, decimal = 0;
+	int16_t integer = 0;
 
 	// Convert two byte integer, two byte decimal sensor format to float
 	integer = cache_reading & 0xffff;
@@ -245,11 +372,72 @@ uint8_t pldm_sensor_get_reading_from_cache(uint16_t sensor_id, int *reading,
 	// X = sensor reading report to BMC
 	// Y = (X * resolution + offset ) * power (10, unit_modifier)
 	// X = (Y * power (10, -1 * unit_modifier) - offset ) / resolution
-	*reading = (int)((sensor_reading * power(10, -1 * unit_modifier) - offset) / resolution);
+	return (int)((sensor_reading * info->reading_scale - info->pdr_numeric_sensor.offset) /
+		     info->pdr_numeric_sensor.resolution);
+}
+
+static void pldm_sensor_update_encoded_reading(pldm_sensor_info *info)
+{
+	if ((info->pldm_sensor_cfg.cache_status != PLDM_SENSOR_ENABLED) ||
+	    (info->pdr_numeric_sensor.resolution == 0)) {
+		return;
+	}
+
+	int cache_reading = info->pldm_sensor_cfg.cache;
+	int encoded_reading = pldm_sensor_encode_reading(info, cache_reading);
+
+	k_spinlock_key_t key = k_spin_lock(&pldm_sensor_encode_lock);
+	info->encoded_source = cache_reading;
+	info->encoded_reading = encoded_reading;
+	info->encoded_valid = true;
+	k_spin_unlock(&pldm_sensor_encode_lock, key);
+}
+
+uint8_t pldm_sensor_get_encoded_reading(uint16_t sensor_id, int *reading, uint8_t *sensor_data_size,
+					uint8_t *sensor_operational_state)
+{
+	CHECK_NULL_ARG_WITH_RETURN(reading, PLDM_ERROR);
+	CHECK_NULL_ARG_WITH_RETURN(sensor_operational_state, PLDM_ERROR);
+
+	const pldm_sensor_info *info = pldm_sensor_find_via_sensor_id(sensor_id);
+	if (info == NULL) {
+		// Couldn't find sensor id in pldm_sensor_list
+		return PLDM_PLATFORM_INVALID_SENSOR_ID;
+	}
+
+	if (sensor_data_size != NULL) {
+		*sensor_data_size = info->pdr_numeric_sensor.sensor_data_size;
+	}
+	*sensor_operational_state = info->pldm_sensor_cfg.cache_status;
+
+	if (info->pdr_numeric_sensor.resolution == 0) {
+		// The value of resolution couldn't be 0
+		return PLDM_ERROR_INVALID_DATA;
+	}
+
+	/* The polling thread converts each new reading once. Readings cached outside of it,
+	 * e.g. by sensor callbacks or platform hooks, are converted here instead. */
+	k_spinlock_key_t key = k_spin_lock(&pldm_sensor_encode_lock);
+	int cache_reading = info->pldm_sensor_cfg.cache;
+	bool is_encoded = info->encoded_valid && (info->encoded_source == cache_reading);
+	if (is_encoded) {
+		*reading = info->encoded_reading;
+	}
+	k_spin_unlock(&pldm_sensor_encode_lock, key);
+
+	if (!is_encoded) {
+		*reading = pldm_sensor_encode_reading(info, cache_reading);
+	}
 
 	return PLDM_SUCCESS;
 }
 
+uint8_t pldm_sensor_get_reading_from_cache(uint16_t sensor_id, int *reading,
+					   uint8_t *sensor_operational_state)
+{
+	return pldm_sensor_get_encoded_reading(sensor_id, reading, NULL, sensor_operational_state);
+}
+
 void pldm_sensor_get_reading(sensor_cfg *pldm_sensor_cfg, uint32_t *update_time,
 			     uint32_t *update_time_ms, int pldm_sensor_count, int thread_id,
 			     int sensor_num)
@@ -418,6 +606,7 @@ int pldm_polling_sensor_reading_optional_check(pldm_sensor_info *pldm_snr_list,
 	pldm_sensor_get_reading(&pldm_snr_list->pldm_sensor_cfg, &pldm_snr_list->update_time,
 				&pldm_snr_list->update_time_ms, pldm_sensor_count, thread_id,
 				sensor_num);
+	pldm_sensor_update_encoded_reading(pldm_snr_list);
 
 	LOG_DBG("sensor0x%x, value0x%x, status 0x%x", pldm_snr_list->pdr_numeric_sensor.sensor_id,
 		pldm_snr_list->pldm_sensor_cfg.cache, pldm_snr_list->pldm_sensor_cfg.cache_status);
@@ -457,6 +646,9 @@ void pldm_sensor_polling_handler(void *arug0, void *arug1, void *arug2)
 		return;
 	}
 
+	pldm_sensor_prepare_encoding(pldm_sensor_list[thread_id], pldm_sensor_count);
+	pldm_sensor_index_add(thread_id, pldm_sensor_list[thread_id], pldm_sensor_count);
+
 	if (pldm_sensor_thread_list[thread_id].poll_interval_ms != 0) {
 		if (pldm_sensor_thread_list[thread_id].poll_interval_ms == 0xFF) {
 			poll_interval_ms = 0;
@@ -573,6 +765,10 @@ void pldm_sensor_monitor_init()
 		return;
 	}
 
+	if (pldm_sensor_index_init() != 0) {
+		LOG_ERR("Failed to initialize PLDM sensor ID index");
+	}
+
 	pldm_sensor_poll_thread_init();
 
 	return;
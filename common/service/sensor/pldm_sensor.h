@@ -40,6 +40,11 @@ typedef struct pldm_sensor_info {
 	sensor_cfg pldm_sensor_cfg;
 	uint32_t update_time_ms;
 	uint16_t poll_interval_ms;
+	/* Filled in by the PLDM sensor service when the sensor list is loaded and polled */
+	double reading_scale; // power(10, -unit_modifier)
+	bool encoded_valid;
+	int encoded_source; // cache value that encoded_reading was converted from
+	int encoded_reading; // PLDM present reading reported to BMC
 } pldm_sensor_info;
 
 typedef struct pldm_sensor_thread {
@@ -56,6 +61,9 @@ void pldm_sensor_polling_handler(void *arug0, void *arug1, void *arug2);
 void pldm_sensor_get_reading(sensor_cfg *pldm_sensor_cfg, uint32_t *update_time,
 			     uint32_t *update_time_ms, int pldm_sensor_count, int thread_id,
 			     int sensor_num);
+uint8_t pldm_sensor_get_encoded_reading(uint16_t sensor_id, int *reading, uint8_t *sensor_data_size,
+					uint8_t *sensor_operational_state);
+int pldm_sensor_encode_reading(const pldm_sensor_info *info, int cache_reading);
 uint8_t pldm_sensor_get_reading_from_cache(uint16_t sensor_id, int *reading,
 					   uint8_t *sensor_operational_state);
 bool pldm_sensor_is_interval_ready(pldm_sensor_info *pldm_sensor_list, uint8_t polling_time_config);
@@ -74,6 +82,7 @@ int pldm_polling_sensor_reading_optional_check(pldm_sensor_info *pldm_snr_list,
 					       int pldm_sensor_count, int thread_id, int sensor_num,
 					       bool interval_ready_check_en, bool polling_using_ms);
 pldm_sensor_thread *pldm_sensor_get_thread_info(int thread_id);
+pldm_sensor_info *pldm_sensor_find_via_sensor_id(uint16_t sensor_id);
 int pldm_sensor_get_info_via_sensor_id(uint16_t sensor_id, float *resolution, float *offset,
 				       int8_t *unit_modifier, int *cache,
 				       uint8_t *sensor_operational_state);
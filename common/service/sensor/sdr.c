@@ -15,7 +15,10 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <zephyr.h>
+#include <sys/crc.h>
 #include "sdr.h"
 #include "sensor.h"
 #include "plat_sdr_table.h"
@@ -38,6 +41,13 @@ SDR_Full_sensor *full_sdr_table;
 uint8_t sensor_config_size = 0;
 uint8_t sdr_count = 0;
 
+/* Image offset of every record, plus the image size as the last entry */
+static uint32_t *sdr_image_offset = NULL;
+static sdr_image_info sdr_image = { 0 };
+/* Set by every change to full_sdr_table, the image is rebuilt before it is served again */
+static bool sdr_image_dirty = true;
+K_MUTEX_DEFINE(sdr_image_mutex);
+
 void SDR_clear_ID(void)
 {
 	sdr_info.current_ID = sdr_info.start_ID;
@@ -112,13 +122,19 @@ void add_full_sdr_table(SDR_Full_sensor add_item)
 	}
 
 	if (index != SENSOR_NUM_MAX) {
+		k_mutex_lock(&sdr_image_mutex, K_FOREVER);
 		memcpy(&full_sdr_table[index], &add_item, sizeof(SDR_Full_sensor));
+		sdr_image_dirty = true;
+		k_mutex_unlock(&sdr_image_mutex);
 		LOG_INF("Replace the sensor[0x%02x] SDR", add_item.sensor_num);
 		return;
 	}
 	// Check SDR table size before adding SDR
 	if (sdr_count + 1 <= sensor_config_size) {
+		k_mutex_lock(&sdr_image_mutex, K_FOREVER);
 		full_sdr_table[sdr_count++] = add_item;
+		sdr_image_dirty = true;
+		k_mutex_unlock(&sdr_image_mutex);
 	} else {
 		LOG_ERR("Add SDR would over SDR max size");
 	}
@@ -137,6 +153,9 @@ void change_sensor_threshold(uint8_t sensor_num, uint8_t threshold_type, uint8_t
 			sensor_num, sdr_index);
 		return;
 	}
+
+	/* Hold the image lock so a chunk being read never mixes old and new data */
+	k_mutex_lock(&sdr_image_mutex, K_FOREVER);
 	switch (threshold_type) {
 	case THRESHOLD_UNR:
 		full_sdr_table[sdr_index].UNRT = change_value;
@@ -158,8 +177,11 @@ void change_sensor_threshold(uint8_t sensor_num, uint8_t threshold_type, uint8_t
 		break;
 	default:
 		LOG_ERR("Invalid threshold type during changing sensor threshold");
-		break;
+		k_mutex_unlock(&sdr_image_mutex);
+		return;
 	}
+	sdr_image_dirty = true;
+	k_mutex_unlock(&sdr_image_mutex);
 }
 
 void change_sensor_mbr(uint8_t sensor_num, uint8_t mbr_type, uint16_t change_value)
@@ -175,6 +197,8 @@ void change_sensor_mbr(uint8_t sensor_num, uint8_t mbr_type, uint16_t change_val
 			sensor_num, sdr_index);
 		return;
 	}
+
+	k_mutex_lock(&sdr_image_mutex, K_FOREVER);
 	switch (mbr_type) {
 	case MBR_M:
 		full_sdr_table[sdr_index].M = change_value & 0xFF;
@@ -197,8 +221,11 @@ void change_sensor_mbr(uint8_t sensor_num, uint8_t mbr_type, uint16_t change_val
 		break;
 	default:
 		LOG_ERR("Invalid MBR type during changing sensor MBR");
-		break;
+		k_mutex_unlock(&sdr_image_mutex);
+		return;
 	}
+	sdr_image_dirty = true;
+	k_mutex_unlock(&sdr_image_mutex);
 }
 
 uint8_t sdr_init(void)
@@ -233,9 +260,140 @@ uint8_t sdr_init(void)
 			   (full_sdr_table[sdr_count - 1].record_id_l);
 
 	is_sdr_not_init = false;
+	sdr_image_build();
+	return true;
+}
+
+static uint32_t sdr_record_size(uint16_t index)
+{
+	return IPMI_SDR_HEADER_LEN + full_sdr_table[index].record_len;
+}
+
+static bool sdr_image_build_locked(void)
+{
+	if (sdr_image_offset == NULL) {
+		sdr_image_offset = (uint32_t *)malloc((sensor_config_size + 1) * sizeof(uint32_t));
+		if (sdr_image_offset == NULL) {
+			LOG_ERR("Fail to allocate SDR image index");
+			return false;
+		}
+	}
+
+	uint32_t offset = 0, crc = 0;
+	for (uint16_t i = 0; i < sdr_count; i++) {
+		/* Apply the platform fixups of Get SDR once here instead of on every read */
+		pal_set_SDR((uint8_t *)&full_sdr_table[i]);
+		sdr_image_offset[i] = offset;
+		crc = crc32_ieee_update(crc, (uint8_t *)&full_sdr_table[i], sdr_record_size(i));
+		offset += sdr_record_size(i);
+	}
+	sdr_image_offset[sdr_count] = offset;
+
+	sdr_image.record_count = sdr_count;
+	sdr_image.size = offset;
+	sdr_image.crc32 = crc;
+	sdr_image_dirty = false;
+
+	return true;
+}
+
+/* Rebuild the image if full_sdr_table changed since the last build, sdr_image_mutex is held */
+static bool sdr_image_refresh_locked(void)
+{
+	if (is_sdr_not_init) {
+		return false;
+	}
+
+	if (sdr_image_dirty || (sdr_image_offset == NULL)) {
+		return sdr_image_build_locked();
+	}
+
 	return true;
 }
 
+/*
+ * Index full_sdr_table as one contiguous image and checksum it, so the BMC can compare the
+ * CRC with its copy and skip the download. The records are not copied, the image is read
+ * straight from the table through the offset index.
+ */
+bool sdr_image_build(void)
+{
+	if ((full_sdr_table == NULL) || (sensor_config_size == 0)) {
+		return false;
+	}
+
+	k_mutex_lock(&sdr_image_mutex, K_FOREVER);
+	bool ret = sdr_image_build_locked();
+	k_mutex_unlock(&sdr_image_mutex);
+
+	return ret;
+}
+
+bool sdr_image_get_info(sdr_image_info *info)
+{
+	CHECK_NULL_ARG_WITH_RETURN(info, false);
+
+	if ((full_sdr_table == NULL) || (sensor_config_size == 0)) {
+		return false;
+	}
+
+	k_mutex_lock(&sdr_image_mutex, K_FOREVER);
+	bool ret = sdr_image_refresh_locked();
+	if (ret) {
+		memcpy(info, &sdr_image, sizeof(sdr_image_info));
+	}
+	k_mutex_unlock(&sdr_image_mutex);
+	return ret;
+}
+
+/*
+ * Copy up to len bytes of the image from offset, returns the number of bytes copied.
+ * crc32 gets the CRC of the image the bytes were copied from.
+ */
+uint16_t sdr_image_read(uint32_t offset, uint8_t *buf, uint16_t len, uint32_t *crc32)
+{
+	CHECK_NULL_ARG_WITH_RETURN(buf, 0);
+	CHECK_NULL_ARG_WITH_RETURN(crc32, 0);
+
+	if ((full_sdr_table == NULL) || (sensor_config_size == 0)) {
+		return 0;
+	}
+
+	uint16_t copied = 0;
+
+	k_mutex_lock(&sdr_image_mutex, K_FOREVER);
+	if (!sdr_image_refresh_locked() || (offset >= sdr_image.size)) {
+		goto unlock;
+	}
+	*crc32 = sdr_image.crc32;
+
+	/* Find the record which holds offset */
+	uint16_t low = 0, high = sdr_image.record_count - 1;
+	while (low < high) {
+		uint16_t mid = (low + high + 1) / 2;
+		if (sdr_image_offset[mid] <= offset) {
+			low = mid;
+		} else {
+			high = mid - 1;
+		}
+	}
+
+	for (uint16_t i = low; (i < sdr_image.record_count) && (copied < len); i++) {
+		uint32_t record_ofs = offset + copied - sdr_image_offset[i];
+		if (record_ofs >= sdr_record_size(i)) {
+			/* Past the end of the image */
+			break;
+		}
+		uint32_t chunk = MIN(sdr_record_size(i) - record_ofs, (uint32_t)(len - copied));
+		memcpy(&buf[copied], (uint8_t *)&full_sdr_table[i] + record_ofs, chunk);
+		copied += chunk;
+	}
+
+unlock:
+	k_mutex_unlock(&sdr_image_mutex);
+	return copied;
+}
+
 uint8_t plat_get_sdr_size()
 {
 	return SDR_TABLE_SIZE;
@@ -429,6 +429,13 @@ typedef struct _SDR_INFO_ {
 	uint16_t current_ID;
 } SDR_INFO;
 
+/* The records of full_sdr_table back to back as the BMC sees them, with a CRC32 over them */
+typedef struct _sdr_image_info {
+	uint16_t record_count;
+	uint32_t size;
+	uint32_t crc32;
+} sdr_image_info;
+
 enum {
 	THRESHOLD_UNR,
 	THRESHOLD_UCR,
@@ -481,5 +488,9 @@ void change_sensor_threshold(uint8_t sensor_num, uint8_t threshold_type, uint8_t
 void change_sensor_mbr(uint8_t sensor_num, uint8_t mbr_type, uint16_t change_value);
 uint8_t plat_get_sdr_size();
 void load_sdr_table(void);
+void pal_set_SDR(uint8_t *table_ptr);
+bool sdr_image_build(void);
+bool sdr_image_get_info(sdr_image_info *info);
+uint16_t sdr_image_read(uint32_t offset, uint8_t *buf, uint16_t len, uint32_t *crc32);
 
 #endif
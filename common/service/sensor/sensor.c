@@ -32,6 +32,8 @@
 #include "util_sys.h"
 #include "plat_def.h"
 #include "libutil.h"
+#include "sensor_poll_sched.h"
+#include "sensor_poll_bus.h"
 
 #include <logging/log.h>
 
@@ -57,7 +59,8 @@ extern const int SENSOR_CONFIG_SIZE;
 struct k_thread sensor_poll;
 K_KERNEL_STACK_MEMBER(sensor_poll_stack, SENSOR_POLL_STACK_SIZE);
 
-uint8_t sensor_config_index_map[SENSOR_NUM_MAX];
+// Indexed by any 8-bit sensor number, add_sensor_config() may map number 0xFF as well
+uint8_t sensor_config_index_map[SENSOR_NUM_MAX + 1];
 uint8_t sdr_index_map[SENSOR_NUM_MAX];
 
 bool enable_sensor_poll_thread = true;
@@ -76,6 +79,15 @@ sensor_monitor_table_info *sensor_monitor_table;
 uint16_t sensor_monitor_count = 0;
 char common_sensor_table_name[] = "common sensor table";
 
+/* Direct sensor number to config index map of each monitor table */
+typedef struct _sensor_num_index_table {
+	sensor_cfg *cfg_table;
+	uint8_t index_map[SENSOR_NUM_MAX + 1];
+} sensor_num_index_table;
+
+static sensor_num_index_table *sensor_num_index = NULL;
+static uint16_t sensor_num_index_count = 0;
+
 // clang-format off
 const char *const sensor_type_name[] = {
 	sensor_name_to_num(tmp75)
@@ -816,8 +828,8 @@ static void init_sensor_num(void)
 {
 	for (int i = 0; i < SENSOR_NUM_MAX; i++) {
 		sdr_index_map[i] = 0xFF;
-		sensor_config_index_map[i] = 0xFF;
 	}
+	memset(sensor_config_index_map, 0xFF, sizeof(sensor_config_index_map));
 }
 
 void map_sensor_num_to_sdr_cfg(void)
@@ -864,10 +876,63 @@ __weak sensor_cfg *get_common_sensor_cfg_info(uint8_t sensor_num)
 	return NULL;
 }
 
-sensor_cfg *find_sensor_cfg_via_sensor_num(sensor_cfg *cfg_table, uint8_t cfg_count,
-					   uint8_t sensor_num)
+static sensor_num_index_table *get_sensor_num_index_table(sensor_cfg *cfg_table)
+{
+	for (uint16_t index = 0; index < sensor_num_index_count; ++index) {
+		if (sensor_num_index[index].cfg_table == cfg_table) {
+			return &sensor_num_index[index];
+		}
+	}
+
+	return NULL;
+}
+
+static void fill_sensor_num_index_table(sensor_num_index_table *index_table, sensor_cfg *cfg_table,
+					uint8_t cfg_count)
+{
+	CHECK_NULL_ARG(index_table);
+
+	index_table->cfg_table = cfg_table;
+	memset(index_table->index_map, SENSOR_NULL, sizeof(index_table->index_map));
+
+	if (cfg_table == NULL) {
+		return;
+	}
+
+	/* Keep the first entry if a sensor number is duplicated, same as linear search */
+	for (int index = cfg_count - 1; index >= 0; --index) {
+		index_table->index_map[cfg_table[index].num] = index;
+	}
+}
+
+void build_sensor_num_index(void)
 {
-	CHECK_NULL_ARG_WITH_RETURN(cfg_table, false);
+	SAFE_FREE(sensor_num_index);
+	sensor_num_index_count = 0;
+
+	if ((sensor_monitor_table == NULL) || (sensor_monitor_count == 0)) {
+		return;
+	}
+
+	sensor_num_index = (sensor_num_index_table *)malloc(sensor_monitor_count *
+							   sizeof(sensor_num_index_table));
+	if (sensor_num_index == NULL) {
+		LOG_ERR("Fail to allocate memory to sensor number index, use linear search");
+		return;
+	}
+
+	for (uint16_t index = 0; index < sensor_monitor_count; ++index) {
+		fill_sensor_num_index_table(&sensor_num_index[index],
+					    sensor_monitor_table[index].monitor_sensor_cfg,
+					    sensor_monitor_table[index].cfg_count);
+	}
+	sensor_num_index_count = sensor_monitor_count;
+}
+
+sensor_cfg *find_sensor_cfg_via_sensor_num_linear(sensor_cfg *cfg_table, uint8_t cfg_count,
+						  uint8_t sensor_num)
+{
+	CHECK_NULL_ARG_WITH_RETURN(cfg_table, NULL);
 
 	uint8_t index = 0;
 
@@ -880,12 +945,44 @@ sensor_cfg *find_sensor_cfg_via_sensor_num(sensor_cfg *cfg_table, uint8_t cfg_co
 	return NULL;
 }
 
+sensor_cfg *find_sensor_cfg_via_sensor_num(sensor_cfg *cfg_table, uint8_t cfg_count,
+					   uint8_t sensor_num)
+{
+	CHECK_NULL_ARG_WITH_RETURN(cfg_table, NULL);
+
+	sensor_num_index_table *index_table = get_sensor_num_index_table(cfg_table);
+	if (index_table != NULL) {
+		uint8_t index = index_table->index_map[sensor_num];
+		if ((index != SENSOR_NULL) && (index < cfg_count) &&
+		    (cfg_table[index].num == sensor_num)) {
+			return &cfg_table[index];
+		}
+	}
+
+	/* Table not indexed or changed after index built, fall back and refresh the entry */
+	sensor_cfg *cfg = find_sensor_cfg_via_sensor_num_linear(cfg_table, cfg_count, sensor_num);
+	if ((cfg != NULL) && (index_table != NULL)) {
+		index_table->index_map[sensor_num] = cfg - cfg_table;
+	}
+
+	return cfg;
+}
+
 bool access_check(uint8_t sensor_num)
 {
 	bool (*access_checker)(uint8_t);
+	uint8_t index = sensor_config_index_map[sensor_num];
 
-	access_checker = sensor_config[sensor_config_index_map[sensor_num]].access_checker;
-	return (access_checker)(sensor_config[sensor_config_index_map[sensor_num]].num);
+	if ((index == SENSOR_NULL) || (index >= sensor_config_count)) {
+		return false;
+	}
+
+	access_checker = sensor_config[index].access_checker;
+	if (access_checker == NULL) {
+		return false;
+	}
+
+	return (access_checker)(sensor_config[index].num);
 }
 
 void clear_unaccessible_sensor_cache(sensor_cfg *cfg)
@@ -1050,14 +1147,75 @@ __weak void plat_sensor_poll_post()
 	return;
 }
 
+void sensor_poll_monitor_sensor(uint16_t table_index, sensor_cfg *cfg, bool check_poll_time)
+{
+	CHECK_NULL_ARG(cfg);
+
+	if (table_index >= sensor_monitor_count) {
+		LOG_ERR("Invalid monitor table index: 0x%x", table_index);
+		return;
+	}
+
+	sensor_monitor_table_info *table_info = &sensor_monitor_table[table_index];
+	uint8_t sensor_num = cfg->num;
+	int reading = 0;
+	bool ret = false;
+
+	if (cfg->cache_status == SENSOR_NOT_PRESENT) {
+		return;
+	}
+
+	// Check whether monitoring sensor is enabled
+	if (cfg->is_enable_polling == DISABLE_SENSOR_POLLING) {
+		cfg->cache = SENSOR_FAIL;
+		cfg->cache_status = SENSOR_POLLING_DISABLE;
+		return;
+	}
+
+	if (check_poll_time && (cfg->poll_time != POLL_TIME_DEFAULT)) {
+		if (pal_is_time_to_poll(sensor_num, cfg->poll_time) == false) {
+			return;
+		}
+	}
+
+	if (table_info->pre_monitor != NULL) {
+		ret = table_info->pre_monitor(sensor_num, table_info->pre_post_monitor_arg);
+		if (ret != true) {
+			LOG_ERR("Pre-monitor fail, table index: 0x%x, sensor num: 0x%x",
+				table_index, sensor_num);
+			return;
+		}
+	}
+
+	// check init status then reinit before reading
+	if (cfg->is_initialized != true) {
+		if (cfg->access_checker(sensor_num) == true) { // to skip access check fail sensor
+			common_tbl_sen_reinit(sensor_num);
+		}
+	}
+
+	get_sensor_reading(table_info->monitor_sensor_cfg, table_info->cfg_count, sensor_num,
+			   &reading, GET_FROM_SENSOR);
+
+	if (table_info->post_monitor != NULL) {
+		ret = table_info->post_monitor(sensor_num, table_info->pre_post_monitor_arg);
+		if (ret != true) {
+			LOG_ERR("Post-monitor fail, table index: 0x%x, sensor num: 0x%x",
+				table_index, sensor_num);
+		}
+	}
+}
+
+void set_sensor_ready_flag(bool is_ready)
+{
+	is_sensor_ready_flag = is_ready;
+}
+
 void sensor_poll_handler(void *arug0, void *arug1, void *arug2)
 {
 	uint16_t table_index = 0;
 	uint8_t sensor_index = 0;
-	uint8_t sensor_num = 0;
 	int sensor_poll_interval_ms = 0;
-	int reading = 0;
-	bool ret = false;
 
 	k_msleep(1000); // delay 1 second to wait for drivers ready before start sensor polling
 
@@ -1087,57 +1245,9 @@ void sensor_poll_handler(void *arug0, void *arug1, void *arug2)
 				    false) { /* skip if disable sensor poll */
 					break;
 				}
-				sensor_cfg *cfg = &cfg_table[sensor_index];
-				sensor_num = cfg->num;
 
-				if (cfg->cache_status == SENSOR_NOT_PRESENT) {
-					continue;
-				}
-
-				// Check whether monitoring sensor is enabled
-				if (cfg->is_enable_polling == DISABLE_SENSOR_POLLING) {
-					cfg->cache = SENSOR_FAIL;
-					cfg->cache_status = SENSOR_POLLING_DISABLE;
-					continue;
-				}
-
-				if (cfg->poll_time != POLL_TIME_DEFAULT) {
-					if (pal_is_time_to_poll(sensor_num, cfg->poll_time) ==
-					    false) {
-						continue;
-					}
-				}
-
-				if (table_info->pre_monitor != NULL) {
-					ret = table_info->pre_monitor(
-						sensor_num, table_info->pre_post_monitor_arg);
-					if (ret != true) {
-						LOG_ERR("Pre-monitor fail, table index: 0x%x, sensor num: 0x%x",
-							table_index, sensor_num);
-						continue;
-					}
-				}
-
-				// check init status then reinit before reading
-				if (cfg->is_initialized != true) {
-					if (cfg->access_checker(sensor_num) ==
-					    true) { // to skip access check fail sensor
-						common_tbl_sen_reinit(sensor_num);
-					}
-				}
-
-				get_sensor_reading(cfg_table, sensor_count, sensor_num, &reading,
-						   GET_FROM_SENSOR);
-
-				if (table_info->post_monitor != NULL) {
-					ret = table_info->post_monitor(
-						sensor_num, table_info->pre_post_monitor_arg);
-					if (ret != true) {
-						LOG_ERR("Post-monitor fail, table index: 0x%x, sensor num: 0x%x",
-							table_index, sensor_num);
-						continue;
-					}
-				}
+				sensor_poll_monitor_sensor(table_index, &cfg_table[sensor_index],
+							   true);
 			}
 
 			k_yield();
@@ -1160,6 +1270,11 @@ __weak void pal_set_sensor_poll_interval(int *interval_ms)
 	return;
 }
 
+__weak uint8_t pal_get_sensor_poll_mode()
+{
+	return SENSOR_POLL_MODE_SWEEP;
+}
+
 __weak void pal_extend_sensor_config(void)
 {
 	return;
@@ -1252,9 +1367,28 @@ bool vr_stby_access(uint8_t sensor_num)
 
 void sensor_poll_init()
 {
+	k_thread_entry_t poll_handler = sensor_poll_handler;
+
+	switch (pal_get_sensor_poll_mode()) {
+	case SENSOR_POLL_MODE_SWEEP:
+		break;
+	case SENSOR_POLL_MODE_DEADLINE:
+		poll_handler = sensor_poll_sched_handler;
+		break;
+	case SENSOR_POLL_MODE_PER_BUS:
+#ifdef ENABLE_SENSOR_POLL_BUS_WORKER
+		poll_handler = sensor_poll_bus_handler;
+#else
+		LOG_ERR("Sensor poll bus worker is not enabled, use sweep mode");
+#endif
+		break;
+	default:
+		LOG_ERR("Unknown sensor poll mode, use sweep mode");
+		break;
+	}
+
 	k_thread_create(&sensor_poll, sensor_poll_stack, K_THREAD_STACK_SIZEOF(sensor_poll_stack),
-			sensor_poll_handler, NULL, NULL, NULL, CONFIG_MAIN_THREAD_PRIORITY, 0,
-			K_NO_WAIT);
+			poll_handler, NULL, NULL, NULL, CONFIG_MAIN_THREAD_PRIORITY, 0, K_NO_WAIT);
 	k_thread_name_set(&sensor_poll, "sensor_poll");
 	return;
 }
@@ -1275,11 +1409,13 @@ void add_sensor_config(sensor_cfg config)
 	uint8_t index = get_sensor_config_index(config.num);
 	if (index != SENSOR_NUM_MAX) {
 		memcpy(&sensor_config[index], &config, sizeof(sensor_cfg));
+		sensor_config_index_map[config.num] = index;
 		LOG_INF("Change the sensor[0x%02x] configuration", config.num);
 		return;
 	}
 	// Check config table size before adding sensor config
 	if (sensor_config_count + 1 <= sdr_count) {
+		sensor_config_index_map[config.num] = sensor_config_count;
 		sensor_config[sensor_config_count++] = config;
 	} else {
 		LOG_ERR("Add config would over config max size");
@@ -1312,6 +1448,8 @@ void init_sensor_monitor_table()
 	}
 
 	plat_fill_monitor_sensor_table();
+
+	build_sensor_num_index();
 }
 
 static inline bool init_drive_type(sensor_cfg *p, uint16_t current_drive)
@@ -1528,7 +1666,8 @@ __weak void load_sensor_config(void)
 void control_sensor_polling(uint8_t sensor_num, uint8_t optional, uint8_t cache_status)
 {
 	if ((sensor_num == SENSOR_NOT_SUPPORT) ||
-	    (sensor_config_index_map[sensor_num] == SENSOR_FAIL)) {
+	    (sensor_config_index_map[sensor_num] == SENSOR_FAIL) ||
+	    (sensor_config_index_map[sensor_num] >= sensor_config_count)) {
 		return;
 	}
 
@@ -200,6 +200,12 @@ enum SENSOR_DEV {
 	sensor_dev_max
 };
 
+enum SENSOR_POLL_MODE {
+	SENSOR_POLL_MODE_SWEEP = 0,
+	SENSOR_POLL_MODE_DEADLINE,
+	SENSOR_POLL_MODE_PER_BUS,
+};
+
 enum CONTROL_SENSOR_POLLING_OPTION {
 	DISABLE_SENSOR_POLLING = false,
 	ENABLE_SENSOR_POLLING = true,
@@ -281,6 +287,7 @@ typedef struct _sensor_cfg_ {
 	bool (*post_sensor_read_hook)(struct _sensor_cfg_ *, void *, int *);
 	void *post_sensor_read_args;
 	void *init_args;
+	uint32_t poll_period_ms; // used by deadline poll mode, 0 means follow poll_time
 
 	/* if there is new parameter should be added, please add on above */
 	void *priv_data;
@@ -826,7 +833,7 @@ enum TEMP_THRESHOLD_TYPE_E {
 extern bool enable_sensor_poll_thread;
 extern sensor_cfg *sensor_config;
 // Mapping sensor number to sensor config index
-extern uint8_t sensor_config_index_map[SENSOR_NUM_MAX];
+extern uint8_t sensor_config_index_map[SENSOR_NUM_MAX + 1];
 extern uint8_t sensor_config_count;
 extern sensor_monitor_table_info *sensor_monitor_table;
 extern uint16_t sensor_monitor_count;
@@ -862,9 +869,16 @@ uint8_t pal_get_monitor_sensor_count();
 void plat_fill_monitor_sensor_table();
 sensor_cfg *find_sensor_cfg_via_sensor_num(sensor_cfg *cfg_table, uint8_t cfg_count,
 					   uint8_t sensor_num);
+sensor_cfg *find_sensor_cfg_via_sensor_num_linear(sensor_cfg *cfg_table, uint8_t cfg_count,
+						  uint8_t sensor_num);
+void build_sensor_num_index(void);
 bool get_sensor_init_done_flag();
 sensor_cfg *get_common_sensor_cfg_info(uint8_t sensor_num);
 uint8_t common_tbl_sen_reinit(uint8_t sen_num);
 void plat_sensor_poll_post();
+uint8_t pal_get_sensor_poll_mode();
+void sensor_poll_handler(void *arug0, void *arug1, void *arug2);
+void sensor_poll_monitor_sensor(uint16_t table_index, sensor_cfg *cfg, bool check_poll_time);
+void set_sensor_ready_flag(bool is_ready);
 
 #endif
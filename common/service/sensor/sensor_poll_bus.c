@@ -0,0 +1,349 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zephyr.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <logging/log.h>
+#include "libutil.h"
+#include "plat_def.h"
+#include "sensor.h"
+
+#ifdef ENABLE_SENSOR_POLL_BUS_WORKER
+#include "sensor_poll_bus.h"
+
+LOG_MODULE_REGISTER(sensor_poll_bus);
+
+typedef struct _sensor_poll_bus_entry {
+	uint16_t table_index;
+	uint8_t sensor_index;
+} sensor_poll_bus_entry;
+
+typedef struct _sensor_poll_bus_group {
+	uint16_t entry_start;
+	sensor_poll_bus_stat stat;
+} sensor_poll_bus_group;
+
+typedef struct _sensor_poll_bus_worker {
+	struct k_thread thread;
+	struct k_sem start_sem;
+} sensor_poll_bus_worker;
+
+K_THREAD_STACK_ARRAY_DEFINE(sensor_poll_bus_stacks, SENSOR_POLL_BUS_WORKER_MAX,
+			    SENSOR_POLL_STACK_SIZE);
+static sensor_poll_bus_worker bus_worker[SENSOR_POLL_BUS_WORKER_MAX];
+static uint8_t bus_worker_count = 0;
+static struct k_sem sweep_done_sem;
+
+static sensor_poll_bus_entry *bus_entry = NULL;
+static sensor_poll_bus_group *bus_group = NULL;
+static uint16_t bus_group_count = 0;
+
+static uint32_t last_full_sweep_ms = 0;
+static uint32_t max_full_sweep_ms = 0;
+
+static bool is_table_polled_in_order(uint16_t table_index)
+{
+	/* Pre/post monitor hooks may switch shared resources for the whole table */
+	return ((sensor_monitor_table[table_index].pre_monitor != NULL) ||
+		(sensor_monitor_table[table_index].post_monitor != NULL));
+}
+
+__weak bool pal_is_sensor_polled_by_bus(sensor_cfg *cfg)
+{
+	CHECK_NULL_ARG_WITH_RETURN(cfg, false);
+
+	/* Only sensors behind a plain I2C port may be grouped by port number, the port field of
+	 * the others is not an I2C bus or the access is serialized by another service */
+	switch (cfg->type) {
+	case sensor_dev_ast_adc:
+	case sensor_dev_intel_peci:
+	case sensor_dev_pch:
+	case sensor_dev_ast_fan:
+	case sensor_dev_pmic:
+	case sensor_dev_apml_mailbox:
+	case sensor_dev_pm8702:
+	case sensor_dev_i3c_dimm:
+	case sensor_dev_mpro:
+	case sensor_dev_cx7:
+	case sensor_dev_nv_satmc:
+	case sensor_dev_ast_tach:
+	case sensor_dev_plat_def_sensor:
+		return false;
+	default:
+		return true;
+	}
+}
+
+static uint16_t get_group_key(uint16_t table_index, sensor_cfg *cfg)
+{
+	if (is_table_polled_in_order(table_index)) {
+		return (SENSOR_POLL_BUS_TABLE_GROUP | table_index);
+	}
+
+	if (pal_is_sensor_polled_by_bus(cfg) == false) {
+		return SENSOR_POLL_BUS_SHARED_GROUP;
+	}
+
+	return cfg->port;
+}
+
+static int find_group_index(uint16_t group_key)
+{
+	for (uint16_t index = 0; index < bus_group_count; ++index) {
+		if (bus_group[index].stat.group_key == group_key) {
+			return index;
+		}
+	}
+
+	return -1;
+}
+
+static bool sensor_poll_bus_build()
+{
+	uint16_t table_index = 0;
+	uint8_t sensor_index = 0;
+	uint32_t total_count = 0;
+	uint16_t group_count = 0;
+	bool is_port_used[UINT8_MAX + 1] = { 0 };
+	bool is_shared_used = false;
+
+	for (table_index = 0; table_index < sensor_monitor_count; ++table_index) {
+		sensor_cfg *cfg_table = sensor_monitor_table[table_index].monitor_sensor_cfg;
+		uint8_t cfg_count = sensor_monitor_table[table_index].cfg_count;
+		if ((cfg_table == NULL) || (cfg_count == 0)) {
+			continue;
+		}
+
+		total_count += cfg_count;
+		if (is_table_polled_in_order(table_index)) {
+			group_count++;
+			continue;
+		}
+
+		for (sensor_index = 0; sensor_index < cfg_count; ++sensor_index) {
+			if (pal_is_sensor_polled_by_bus(&cfg_table[sensor_index]) == false) {
+				if (is_shared_used == false) {
+					is_shared_used = true;
+					group_count++;
+				}
+			} else if (is_port_used[cfg_table[sensor_index].port] == false) {
+				is_port_used[cfg_table[sensor_index].port] = true;
+				group_count++;
+			}
+		}
+	}
+
+	if ((total_count == 0) || (total_count > UINT16_MAX)) {
+		LOG_ERR("Invalid sensor count to poll: %d", total_count);
+		return false;
+	}
+
+	bus_entry = (sensor_poll_bus_entry *)malloc(total_count * sizeof(sensor_poll_bus_entry));
+	bus_group = (sensor_poll_bus_group *)malloc(group_count * sizeof(sensor_poll_bus_group));
+	if ((bus_entry == NULL) || (bus_group == NULL)) {
+		LOG_ERR("Fail to allocate memory to sensor poll bus group");
+		SAFE_FREE(bus_entry);
+		SAFE_FREE(bus_group);
+		return false;
+	}
+	memset(bus_group, 0, group_count * sizeof(sensor_poll_bus_group));
+
+	/* First pass, create groups and count sensors of each group */
+	for (table_index = 0; table_index < sensor_monitor_count; ++table_index) {
+		sensor_cfg *cfg_table = sensor_monitor_table[table_index].monitor_sensor_cfg;
+		if (cfg_table == NULL) {
+			continue;
+		}
+
+		for (sensor_index = 0; sensor_index < sensor_monitor_table[table_index].cfg_count;
+		     ++sensor_index) {
+			uint16_t group_key = get_group_key(table_index, &cfg_table[sensor_index]);
+			int group_index = find_group_index(group_key);
+			if (group_index < 0) {
+				group_index = bus_group_count++;
+				bus_group[group_index].stat.group_key = group_key;
+			}
+			bus_group[group_index].stat.sensor_count++;
+		}
+	}
+
+	bus_worker_count = MIN(bus_group_count, SENSOR_POLL_BUS_WORKER_MAX);
+
+	uint16_t entry_start = 0;
+	for (uint16_t group_index = 0; group_index < bus_group_count; ++group_index) {
+		bus_group[group_index].entry_start = entry_start;
+		bus_group[group_index].stat.worker_index = group_index % bus_worker_count;
+		entry_start += bus_group[group_index].stat.sensor_count;
+		/* Reuse sensor count as fill position of second pass */
+		bus_group[group_index].stat.sensor_count = 0;
+	}
+
+	/* Second pass, fill sensors into groups and keep table order inside group */
+	for (table_index = 0; table_index < sensor_monitor_count; ++table_index) {
+		sensor_cfg *cfg_table = sensor_monitor_table[table_index].monitor_sensor_cfg;
+		if (cfg_table == NULL) {
+			continue;
+		}
+
+		for (sensor_index = 0; sensor_index < sensor_monitor_table[table_index].cfg_count;
+		     ++sensor_index) {
+			sensor_poll_bus_group *group = &bus_group[find_group_index(
+				get_group_key(table_index, &cfg_table[sensor_index]))];
+			sensor_poll_bus_entry *entry =
+				&bus_entry[group->entry_start + group->stat.sensor_count++];
+			entry->table_index = table_index;
+			entry->sensor_index = sensor_index;
+		}
+	}
+
+	return true;
+}
+
+static void sensor_poll_bus_sweep_group(sensor_poll_bus_group *group)
+{
+	uint16_t last_table_index = UINT16_MAX;
+	bool is_table_accessible = false;
+
+	for (uint16_t index = 0; index < group->stat.sensor_count; ++index) {
+		if (get_sensor_poll_enable_flag() == false) {
+			return;
+		}
+
+		sensor_poll_bus_entry *entry = &bus_entry[group->entry_start + index];
+		sensor_monitor_table_info *table_info = &sensor_monitor_table[entry->table_index];
+
+		if (entry->table_index != last_table_index) {
+			last_table_index = entry->table_index;
+			is_table_accessible = true;
+			if (table_info->access_checker != NULL) {
+				is_table_accessible =
+					table_info->access_checker(table_info->access_checker_arg);
+			}
+		}
+
+		if ((is_table_accessible == false) || (table_info->monitor_sensor_cfg == NULL) ||
+		    (entry->sensor_index >= table_info->cfg_count)) {
+			continue;
+		}
+
+		sensor_poll_monitor_sensor(entry->table_index,
+					   &table_info->monitor_sensor_cfg[entry->sensor_index],
+					   true);
+	}
+}
+
+static void sensor_poll_bus_worker_handler(void *arug0, void *arug1, void *arug2)
+{
+	uint8_t worker_index = POINTER_TO_UINT(arug0);
+	sensor_poll_bus_worker *worker = &bus_worker[worker_index];
+
+	while (1) {
+		k_sem_take(&worker->start_sem, K_FOREVER);
+
+		for (uint16_t group_index = worker_index; group_index < bus_group_count;
+		     group_index += bus_worker_count) {
+			sensor_poll_bus_group *group = &bus_group[group_index];
+			int64_t start_time = k_uptime_get();
+
+			sensor_poll_bus_sweep_group(group);
+
+			group->stat.last_sweep_ms = k_uptime_get() - start_time;
+			group->stat.max_sweep_ms =
+				MAX(group->stat.max_sweep_ms, group->stat.last_sweep_ms);
+			group->stat.sweep_count++;
+			k_yield();
+		}
+
+		k_sem_give(&sweep_done_sem);
+	}
+}
+
+void sensor_poll_bus_handler(void *arug0, void *arug1, void *arug2)
+{
+	int sensor_poll_interval_ms = 0;
+	char worker_name[MAX_SENSOR_NAME_LENGTH];
+
+	k_msleep(1000); // delay 1 second to wait for drivers ready before start sensor polling
+
+	pal_set_sensor_poll_interval(&sensor_poll_interval_ms);
+
+	if (sensor_poll_bus_build() == false) {
+		LOG_ERR("Fail to group sensors by bus, use sweep mode");
+		sensor_poll_handler(arug0, arug1, arug2);
+		return;
+	}
+
+	k_sem_init(&sweep_done_sem, 0, bus_worker_count);
+	for (uint8_t index = 0; index < bus_worker_count; ++index) {
+		k_sem_init(&bus_worker[index].start_sem, 0, 1);
+		k_thread_create(&bus_worker[index].thread, sensor_poll_bus_stacks[index],
+				K_THREAD_STACK_SIZEOF(sensor_poll_bus_stacks[index]),
+				sensor_poll_bus_worker_handler, UINT_TO_POINTER(index), NULL, NULL,
+				CONFIG_MAIN_THREAD_PRIORITY, 0, K_NO_WAIT);
+		snprintf(worker_name, sizeof(worker_name), "sensor_poll_bus_%d", index);
+		k_thread_name_set(&bus_worker[index].thread, worker_name);
+	}
+
+	LOG_INF("Poll %d sensor groups with %d workers", bus_group_count, bus_worker_count);
+
+	while (1) {
+		int64_t start_time = k_uptime_get();
+
+		for (uint8_t index = 0; index < bus_worker_count; ++index) {
+			k_sem_give(&bus_worker[index].start_sem);
+		}
+		for (uint8_t index = 0; index < bus_worker_count; ++index) {
+			k_sem_take(&sweep_done_sem, K_FOREVER);
+		}
+
+		last_full_sweep_ms = k_uptime_get() - start_time;
+		max_full_sweep_ms = MAX(max_full_sweep_ms, last_full_sweep_ms);
+
+		set_sensor_ready_flag(true);
+		plat_sensor_poll_post();
+		k_msleep(sensor_poll_interval_ms);
+	}
+}
+
+uint16_t sensor_poll_bus_get_group_count()
+{
+	return bus_group_count;
+}
+
+bool sensor_poll_bus_get_group_stat(uint16_t group_index, sensor_poll_bus_stat *stat)
+{
+	CHECK_NULL_ARG_WITH_RETURN(stat, false);
+
+	if (group_index >= bus_group_count) {
+		return false;
+	}
+
+	memcpy(stat, &bus_group[group_index].stat, sizeof(sensor_poll_bus_stat));
+	return true;
+}
+
+void sensor_poll_bus_get_full_sweep_time(uint32_t *last_sweep_ms, uint32_t *max_sweep_ms)
+{
+	CHECK_NULL_ARG(last_sweep_ms);
+	CHECK_NULL_ARG(max_sweep_ms);
+
+	*last_sweep_ms = last_full_sweep_ms;
+	*max_sweep_ms = max_full_sweep_ms;
+}
+
+#endif
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SENSOR_POLL_BUS_H
+#define SENSOR_POLL_BUS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "plat_def.h"
+#include "sensor.h"
+
+#ifdef ENABLE_SENSOR_POLL_BUS_WORKER
+
+#ifndef SENSOR_POLL_BUS_WORKER_MAX
+#define SENSOR_POLL_BUS_WORKER_MAX 4
+#endif
+
+/* Group key of monitor tables which have pre/post monitor hooks */
+#define SENSOR_POLL_BUS_TABLE_GROUP BIT(15)
+/* Group key of sensors which are not read over a plain I2C port (ADC, PECI, fan, tach, IPMB,
+ * MCTP, APML mailbox, I3C and platform defined sensors), all of them are polled in order */
+#define SENSOR_POLL_BUS_SHARED_GROUP BIT(14)
+
+typedef struct _sensor_poll_bus_stat {
+	/* port number, SENSOR_POLL_BUS_SHARED_GROUP or SENSOR_POLL_BUS_TABLE_GROUP | table index */
+	uint16_t group_key;
+	uint8_t worker_index;
+	uint16_t sensor_count;
+	uint32_t sweep_count;
+	uint32_t last_sweep_ms;
+	uint32_t max_sweep_ms;
+} sensor_poll_bus_stat;
+
+bool pal_is_sensor_polled_by_bus(sensor_cfg *cfg);
+void sensor_poll_bus_handler(void *arug0, void *arug1, void *arug2);
+uint16_t sensor_poll_bus_get_group_count();
+bool sensor_poll_bus_get_group_stat(uint16_t group_index, sensor_poll_bus_stat *stat);
+void sensor_poll_bus_get_full_sweep_time(uint32_t *last_sweep_ms, uint32_t *max_sweep_ms);
+
+#endif
+
+#endif
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sensor_poll_sched.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <logging/log.h>
+#include "sensor.h"
+#include "libutil.h"
+
+LOG_MODULE_REGISTER(sensor_poll_sched);
+
+typedef struct _sensor_poll_sched_entry {
+	int64_t due_time_ms;
+	uint8_t sensor_index;
+	bool is_polled;
+	sensor_poll_sched_stat stat;
+} sensor_poll_sched_entry;
+
+static sensor_poll_sched_entry *sched_entry = NULL;
+/* Min-heap of entry index ordered by due time */
+static uint16_t *sched_heap = NULL;
+static uint16_t sched_entry_count = 0;
+
+static bool is_entry_earlier(uint16_t entry_a, uint16_t entry_b)
+{
+	if (sched_entry[entry_a].due_time_ms != sched_entry[entry_b].due_time_ms) {
+		return (sched_entry[entry_a].due_time_ms < sched_entry[entry_b].due_time_ms);
+	}
+
+	/* Keep monitor table order for sensors due at the same time */
+	return (entry_a < entry_b);
+}
+
+static void sched_heap_sift_down(uint16_t pos)
+{
+	while (1) {
+		uint32_t earliest = pos;
+		uint32_t left = (2 * pos) + 1;
+		uint32_t right = left + 1;
+
+		if ((left < sched_entry_count) &&
+		    is_entry_earlier(sched_heap[left], sched_heap[earliest])) {
+			earliest = left;
+		}
+		if ((right < sched_entry_count) &&
+		    is_entry_earlier(sched_heap[right], sched_heap[earliest])) {
+			earliest = right;
+		}
+		if (earliest == pos) {
+			return;
+		}
+
+		uint16_t tmp = sched_heap[pos];
+		sched_heap[pos] = sched_heap[earliest];
+		sched_heap[earliest] = tmp;
+		pos = earliest;
+	}
+}
+
+static uint32_t get_sensor_poll_period_ms(sensor_cfg *cfg, int default_period_ms)
+{
+	uint32_t period_ms = default_period_ms;
+
+	if (cfg->poll_period_ms != 0) {
+		period_ms = cfg->poll_period_ms;
+	} else if (cfg->poll_time > POLL_TIME_DEFAULT) {
+		period_ms = cfg->poll_time * 1000;
+	}
+
+	return MAX(period_ms, SENSOR_POLL_SCHED_MIN_PERIOD_MS);
+}
+
+static bool sensor_poll_sched_build(int default_period_ms, int64_t start_time_ms)
+{
+	uint16_t table_index = 0;
+	uint16_t entry_index = 0;
+	uint32_t total_count = 0;
+
+	for (table_index = 0; table_index < sensor_monitor_count; ++table_index) {
+		if (sensor_monitor_table[table_index].monitor_sensor_cfg != NULL) {
+			total_count += sensor_monitor_table[table_index].cfg_count;
+		}
+	}
+
+	if ((total_count == 0) || (total_count > UINT16_MAX)) {
+		LOG_ERR("Invalid sensor count to schedule: %d", total_count);
+		return false;
+	}
+
+	sched_entry = (sensor_poll_sched_entry *)malloc(total_count *
+							sizeof(sensor_poll_sched_entry));
+	sched_heap = (uint16_t *)malloc(total_count * sizeof(uint16_t));
+	if ((sched_entry == NULL) || (sched_heap == NULL)) {
+		LOG_ERR("Fail to allocate memory to sensor poll schedule");
+		SAFE_FREE(sched_entry);
+		SAFE_FREE(sched_heap);
+		return false;
+	}
+	memset(sched_entry, 0, total_count * sizeof(sensor_poll_sched_entry));
+
+	for (table_index = 0; table_index < sensor_monitor_count; ++table_index) {
+		sensor_cfg *cfg_table = sensor_monitor_table[table_index].monitor_sensor_cfg;
+		if (cfg_table == NULL) {
+			continue;
+		}
+
+		for (uint8_t sensor_index = 0;
+		     sensor_index < sensor_monitor_table[table_index].cfg_count; ++sensor_index) {
+			sensor_poll_sched_entry *entry = &sched_entry[entry_index];
+			entry->due_time_ms = start_time_ms;
+			entry->sensor_index = sensor_index;
+			entry->stat.table_index = table_index;
+			entry->stat.sensor_num = cfg_table[sensor_index].num;
+			entry->stat.period_ms = get_sensor_poll_period_ms(&cfg_table[sensor_index],
+									  default_period_ms);
+
+			/* All entries are due at start time, so table order is a valid heap */
+			sched_heap[entry_index] = entry_index;
+			entry_index++;
+		}
+	}
+
+	sched_entry_count = entry_index;
+	return true;
+}
+
+static void sensor_poll_sched_run_entry(sensor_poll_sched_entry *entry)
+{
+	sensor_monitor_table_info *table_info = &sensor_monitor_table[entry->stat.table_index];
+
+	if (get_sensor_poll_enable_flag() == false) {
+		return;
+	}
+
+	if (table_info->access_checker != NULL) {
+		if (table_info->access_checker(table_info->access_checker_arg) != true) {
+			return;
+		}
+	}
+
+	if ((table_info->monitor_sensor_cfg == NULL) ||
+	    (entry->sensor_index >= table_info->cfg_count)) {
+		return;
+	}
+
+	sensor_poll_monitor_sensor(entry->stat.table_index,
+				   &table_info->monitor_sensor_cfg[entry->sensor_index], false);
+}
+
+void sensor_poll_sched_handler(void *arug0, void *arug1, void *arug2)
+{
+	int sensor_poll_interval_ms = 0;
+	uint16_t unpolled_count = 0;
+
+	k_msleep(1000); // delay 1 second to wait for drivers ready before start sensor polling
+
+	pal_set_sensor_poll_interval(&sensor_poll_interval_ms);
+
+	int64_t now_ms = k_uptime_get();
+	if (sensor_poll_sched_build(sensor_poll_interval_ms, now_ms) == false) {
+		LOG_ERR("Fail to build sensor poll schedule, use sweep mode");
+		sensor_poll_handler(arug0, arug1, arug2);
+		return;
+	}
+
+	unpolled_count = sched_entry_count;
+	/* Sweep mode sleeps between passes, here an interval of 0 would post on every loop */
+	sensor_poll_interval_ms = MAX(sensor_poll_interval_ms, SENSOR_POLL_SCHED_MIN_PERIOD_MS);
+	int64_t next_post_time_ms = now_ms + sensor_poll_interval_ms;
+
+	while (1) {
+		uint16_t entry_index = sched_heap[0];
+		sensor_poll_sched_entry *entry = &sched_entry[entry_index];
+
+		now_ms = k_uptime_get();
+		if (entry->due_time_ms > now_ms) {
+			int64_t wake_time_ms = MIN(entry->due_time_ms, next_post_time_ms);
+			if (wake_time_ms > now_ms) {
+				k_msleep(wake_time_ms - now_ms);
+				continue;
+			}
+		} else {
+			uint32_t jitter_ms = now_ms - entry->due_time_ms;
+			entry->stat.poll_count++;
+			entry->stat.total_jitter_ms += jitter_ms;
+			entry->stat.max_jitter_ms = MAX(entry->stat.max_jitter_ms, jitter_ms);
+
+			sensor_poll_sched_run_entry(entry);
+
+			now_ms = k_uptime_get();
+			entry->due_time_ms += entry->stat.period_ms;
+			if (entry->due_time_ms <= now_ms) {
+				/* Deadline missed, skip the lost periods instead of polling back to back */
+				entry->stat.overrun_count++;
+				entry->due_time_ms = now_ms + entry->stat.period_ms;
+			}
+			sched_heap_sift_down(0);
+
+			if (entry->is_polled == false) {
+				entry->is_polled = true;
+				if (--unpolled_count == 0) {
+					set_sensor_ready_flag(true);
+				}
+			}
+		}
+
+		if (now_ms >= next_post_time_ms) {
+			plat_sensor_poll_post();
+			next_post_time_ms += sensor_poll_interval_ms;
+			if (next_post_time_ms <= now_ms) {
+				next_post_time_ms = now_ms + sensor_poll_interval_ms;
+			}
+		}
+
+		k_yield();
+	}
+}
+
+uint16_t sensor_poll_sched_get_entry_count()
+{
+	return sched_entry_count;
+}
+
+bool sensor_poll_sched_get_entry_stat(uint16_t entry_index, sensor_poll_sched_stat *stat)
+{
+	CHECK_NULL_ARG_WITH_RETURN(stat, false);
+
+	if (entry_index >= sched_entry_count) {
+		return false;
+	}
+
+	memcpy(stat, &sched_entry[entry_index].stat, sizeof(sensor_poll_sched_stat));
+	return true;
+}
+
+void sensor_poll_sched_reset_stat()
+{
+	for (uint16_t index = 0; index < sched_entry_count; ++index) {
+		sched_entry[index].stat.poll_count = 0;
+		sched_entry[index].stat.overrun_count = 0;
+		sched_entry[index].stat.max_jitter_ms = 0;
+		sched_entry[index].stat.total_jitter_ms = 0;
+	}
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SENSOR_POLL_SCHED_H
+#define SENSOR_POLL_SCHED_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Lower bound of sensor poll period to keep the poll thread from spinning */
+#define SENSOR_POLL_SCHED_MIN_PERIOD_MS 10
+
+typedef struct _sensor_poll_sched_stat {
+	uint16_t table_index;
+	uint8_t sensor_num;
+	uint32_t period_ms;
+	uint32_t poll_count;
+	uint32_t overrun_count;
+	uint32_t max_jitter_ms;
+	uint32_t total_jitter_ms;
+} sensor_poll_sched_stat;
+
+void sensor_poll_sched_handler(void *arug0, void *arug1, void *arug2);
+uint16_t sensor_poll_sched_get_entry_count();
+bool sensor_poll_sched_get_entry_stat(uint16_t entry_index, sensor_poll_sched_stat *stat);
+void sensor_poll_sched_reset_stat();
+
+#endif
@@ -18,7 +18,9 @@
 #include <devicetree.h>
 #include <device.h>
 #include <stdio.h>
+#include <string.h>
 #include "libutil.h"
+#include "util_spi.h"
 #include <logging/log.h>
 
 LOG_MODULE_REGISTER(flash_shell);
@@ -111,6 +113,27 @@ exit:
 	return;
 }
 
+void cmd_flash_update_stat(const struct shell *shell, size_t argc, char **argv)
+{
+	if ((argc > 2) || ((argc == 2) && strcmp(argv[1], "reset"))) {
+		shell_warn(shell, "Help: platform flash update_stat [reset]");
+		return;
+	}
+
+	if (argc == 2) {
+		reset_fw_update_diff_stat();
+		shell_print(shell, "Differential update statistics reset");
+		return;
+	}
+
+	fw_update_diff_stat stat = { 0 };
+	get_fw_update_diff_stat(&stat);
+
+	shell_print(shell, "skipped sectors : %u", stat.skipped_sector_count);
+	shell_print(shell, "written sectors : %u", stat.written_sector_count);
+	shell_print(shell, "erased blocks   : %u", stat.erased_block_count);
+}
+
 /* Flash sub command */
 void device_spi_name_get(size_t idx, struct shell_static_entry *entry)
 {
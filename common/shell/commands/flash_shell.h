@@ -27,6 +27,7 @@
 
 void cmd_flash_re_init(const struct shell *shell, size_t argc, char **argv);
 void cmd_flash_sfdp_read(const struct shell *shell, size_t argc, char **argv);
+void cmd_flash_update_stat(const struct shell *shell, size_t argc, char **argv);
 void device_spi_name_get(size_t idx, struct shell_static_entry *entry);
 
 SHELL_DYNAMIC_CMD_CREATE(spi_device_name, device_spi_name_get);
@@ -36,6 +37,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_flash_cmds,
 					 cmd_flash_re_init),
 			       SHELL_CMD(sfpd_read, &spi_device_name, "SFPD read",
 					 cmd_flash_sfdp_read),
+			       SHELL_CMD(update_stat, NULL, "Differential update statistics",
+					 cmd_flash_update_stat),
 			       SHELL_SUBCMD_SET_END);
 
 #endif
@@ -21,6 +21,10 @@
 #include "ipmi.h"
 #include "ipmb.h"
 
+#ifdef CONFIG_IPMI_KCS_ASPEED
+#include "kcs.h"
+#endif
+
 void cmd_ipmi_raw(const struct shell *shell, size_t argc, char **argv)
 {
 	if (argc < 3) {
@@ -119,3 +123,81 @@ void cmd_ipmi_list(const struct shell *shell, size_t argc, char **argv)
 		shell,
 		"------------------------------------------------------------------------------");
 }
+
+void cmd_ipmi_latency(const struct shell *shell, size_t argc, char **argv)
+{
+	if ((argc > 2) || ((argc == 2) && strcmp(argv[1], "reset"))) {
+		shell_warn(shell, "Help: platform ipmi latency [reset]");
+		return;
+	}
+
+	if (argc == 2) {
+		ipmi_reset_latency_stat();
+		shell_print(shell, "Latency statistics cleared");
+		return;
+	}
+
+	ipmi_latency_stat stat[IPMI_LATENCY_CMD_NUM];
+	uint32_t untracked_count = 0;
+	uint8_t num = ipmi_get_latency_stat(stat, ARRAY_SIZE(stat), &untracked_count);
+
+	shell_print(shell, "bucket i: handled under 4^i ms, last bucket: the rest");
+	shell_print(shell, "%-6s %-4s %-4s %-6s %-4s %-8s %-8s buckets", "netfn", "cmd", "path",
+		    "count", "tmo", "avg_us", "max_us");
+	for (uint8_t i = 0; i < num; i++) {
+		char bucket_str[IPMI_LATENCY_BUCKET_NUM * 11 + 1] = { 0 };
+		int offset = 0;
+		for (uint8_t j = 0; j < IPMI_LATENCY_BUCKET_NUM; j++) {
+			offset += snprintf(bucket_str + offset, sizeof(bucket_str) - offset, "%u ",
+					   stat[i].bucket[j]);
+		}
+
+		shell_print(shell, "0x%-4x 0x%-2x %-4s %-6u %-4u %-8u %-8u %s", stat[i].netfn,
+			    stat[i].cmd, stat[i].is_slow ? "slow" : "fast", stat[i].count,
+			    stat[i].timeout_count,
+			    (uint32_t)(stat[i].count ? (stat[i].total_us / stat[i].count) : 0),
+			    stat[i].max_us, bucket_str);
+	}
+
+	if (untracked_count) {
+		shell_print(shell, "%u commands not tracked, table full", untracked_count);
+	}
+}
+
+void cmd_ipmi_kcs_latency(const struct shell *shell, size_t argc, char **argv)
+{
+#ifdef CONFIG_IPMI_KCS_ASPEED
+	if (argc > 2) {
+		shell_warn(shell, "Help: platform ipmi kcs_latency [on|off|reset]");
+		return;
+	}
+
+	if (argc == 2) {
+		if (!strcmp(argv[1], "on")) {
+			kcs_set_latency_mode(true);
+		} else if (!strcmp(argv[1], "off")) {
+			kcs_set_latency_mode(false);
+		} else if (!strcmp(argv[1], "reset")) {
+			kcs_reset_latency_stat();
+		} else {
+			shell_warn(shell, "Help: platform ipmi kcs_latency [on|off|reset]");
+			return;
+		}
+	}
+
+	kcs_latency_stat stat[KCS_LATENCY_CMD_NUM];
+	uint8_t num = kcs_get_latency_stat(stat, ARRAY_SIZE(stat));
+
+	shell_print(shell, "latency mode %s", kcs_get_latency_mode() ? "on" : "off");
+	shell_print(shell, "%-6s %-4s %-6s %-8s %-8s %-8s", "netfn", "cmd", "count", "min_us",
+		    "avg_us", "max_us");
+	for (uint8_t i = 0; i < num; i++) {
+		shell_print(shell, "0x%-4x 0x%-2x %-6u %-8u %-8u %-8u", stat[i].netfn, stat[i].cmd,
+			    stat[i].count, stat[i].min_us,
+			    (uint32_t)(stat[i].count ? (stat[i].total_us / stat[i].count) : 0),
+			    stat[i].max_us);
+	}
+#else
+	shell_warn(shell, "KCS is not supported on this platform");
+#endif
+}
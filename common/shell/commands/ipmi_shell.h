@@ -22,9 +22,14 @@
 
 void cmd_ipmi_list(const struct shell *shell, size_t argc, char **argv);
 void cmd_ipmi_raw(const struct shell *shell, size_t argc, char **argv);
+void cmd_ipmi_latency(const struct shell *shell, size_t argc, char **argv);
+void cmd_ipmi_kcs_latency(const struct shell *shell, size_t argc, char **argv);
 
 SHELL_STATIC_SUBCMD_SET_CREATE(
 	sub_ipmi_cmds, SHELL_CMD(scan, NULL, "Scanning all supported commands", cmd_ipmi_list),
-	SHELL_CMD(raw, NULL, "Send raw command", cmd_ipmi_raw), SHELL_SUBCMD_SET_END);
+	SHELL_CMD(raw, NULL, "Send raw command", cmd_ipmi_raw),
+	SHELL_CMD(latency, NULL, "Command handling latency histogram", cmd_ipmi_latency),
+	SHELL_CMD(kcs_latency, NULL, "Host KCS request-to-response latency", cmd_ipmi_kcs_latency),
+	SHELL_SUBCMD_SET_END);
 
 #endif
@@ -17,8 +17,14 @@
 #include "pldm.h"
 #include "pldm_shell.h"
 #include "libutil.h"
+#include "pldm_base.h"
 #include <stdlib.h>
 #include <string.h>
+#include <zephyr.h>
+#include "plat_def.h"
+
+#define PLDM_BENCH_DEFAULT_COUNT 100
+#define PLDM_LOOPBACK_BENCH_TIMEOUT_MS 1000
 
 /*
  * Command Functions
@@ -80,3 +86,229 @@ void cmd_pldm_send_req(const struct shell *shell, size_t argc, char **argv)
 exit:
 	SAFE_FREE(pmsg.buf);
 }
+
+void cmd_pldm_bench(const struct shell *shell, size_t argc, char **argv)
+{
+	if ((argc < 2) || (argc > 4)) {
+		shell_warn(shell, "Help: platform pldm bench <mctp_dest_eid> [count] [event|poll]");
+		return;
+	}
+
+	uint8_t mctp_dest_eid = strtol(argv[1], NULL, 16);
+	uint32_t count = (argc > 2) ? strtoul(argv[2], NULL, 10) : PLDM_BENCH_DEFAULT_COUNT;
+	if (count == 0) {
+		shell_error(shell, "Count should be more than 0");
+		return;
+	}
+
+	pldm_msg pmsg = { 0 };
+	mctp *mctp_inst = NULL;
+	if (get_mctp_info_by_eid(mctp_dest_eid, &mctp_inst, &pmsg.ext_params) == false) {
+		shell_error(shell, "Failed to get mctp info by eid 0x%x", mctp_dest_eid);
+		return;
+	}
+
+	MCTP_RX_MODE origin_mode = mctp_inst->rx_mode;
+	if (argc > 3) {
+		if (!strcmp(argv[3], "poll")) {
+			mctp_set_rx_mode(mctp_inst, MCTP_RX_MODE_POLL);
+		} else if (!strcmp(argv[3], "event")) {
+			mctp_set_rx_mode(mctp_inst, MCTP_RX_MODE_EVENT);
+		} else {
+			shell_error(shell, "Unknown rx mode %s", argv[3]);
+			return;
+		}
+	}
+
+	/* GetTID has no request data and a 2 bytes response, so the time is mostly transport */
+	uint8_t resp_buf[PLDM_MAX_DATA_SIZE] = { 0 };
+	uint32_t fail_count = 0, min_us = UINT32_MAX, max_us = 0;
+	uint64_t total_us = 0;
+	uint32_t start_packet_count = mctp_inst->rx_packet_count;
+	int64_t start_ms = k_uptime_get();
+
+	for (uint32_t i = 0; i < count; i++) {
+		pmsg.hdr.msg_type = MCTP_MSG_TYPE_PLDM;
+		pmsg.hdr.pldm_type = PLDM_TYPE_BASE;
+		pmsg.hdr.cmd = PLDM_BASE_CMD_CODE_GETTID;
+		pmsg.hdr.rq = PLDM_REQUEST;
+		pmsg.buf = NULL;
+		pmsg.len = 0;
+
+		uint32_t start_cycle = k_cycle_get_32();
+		uint16_t resp_len = mctp_pldm_read(mctp_inst, &pmsg, resp_buf, sizeof(resp_buf));
+		uint32_t elapsed_us = k_cyc_to_us_floor32(k_cycle_get_32() - start_cycle);
+
+		if ((resp_len == 0) || (resp_buf[0] != PLDM_SUCCESS)) {
+			fail_count++;
+			continue;
+		}
+
+		total_us += elapsed_us;
+		min_us = MIN(min_us, elapsed_us);
+		max_us = MAX(max_us, elapsed_us);
+	}
+
+	int64_t elapsed_ms = k_uptime_get() - start_ms;
+	uint32_t packet_count = mctp_inst->rx_packet_count - start_packet_count;
+	const char *mode_name = (mctp_inst->rx_mode == MCTP_RX_MODE_POLL) ? "poll" : "event";
+	mctp_set_rx_mode(mctp_inst, origin_mode);
+
+	shell_print(shell, "eid 0x%x, rx mode %s, %u requests, %u failed, %lld ms", mctp_dest_eid,
+		    mode_name, count, fail_count, elapsed_ms);
+	if (fail_count == count) {
+		return;
+	}
+
+	shell_print(shell, "round trip us: min %u, avg %u, max %u", min_us,
+		    (uint32_t)(total_us / (count - fail_count)), max_us);
+	if (elapsed_ms > 0) {
+		shell_print(shell, "requests/s: %u, rx packets/s: %u",
+			    (uint32_t)((count - fail_count) * 1000 / elapsed_ms),
+			    (uint32_t)(packet_count * 1000 / elapsed_ms));
+	}
+}
+
+void cmd_mctp_assembly_stat(const struct shell *shell, size_t argc, char **argv)
+{
+	mctp_assembly_stat stat;
+	mctp_get_assembly_stat(&stat);
+
+	shell_print(shell, "reassembly buffers: %u in use of %u", stat.in_use_count,
+		    MCTP_ASSEMBLY_BUF_NUM);
+	shell_print(shell, "alloc: %u, slab exhausted: %u, timeout: %u", stat.alloc_count,
+		    stat.slab_exhausted_count, stat.timeout_count);
+	shell_print(shell, "out of sequence: %u, overflow: %u", stat.out_of_seq_count,
+		    stat.overflow_count);
+}
+
+#ifdef ENABLE_MCTP_LOOPBACK
+static uint8_t loopback_msg_recv(void *mctp_p, uint8_t *buf, uint32_t len,
+				 mctp_ext_params ext_params)
+{
+	CHECK_NULL_ARG_WITH_RETURN(mctp_p, MCTP_ERROR);
+	CHECK_NULL_ARG_WITH_RETURN(buf, MCTP_ERROR);
+
+	uint8_t msg_type = (buf[0] & MCTP_MSG_TYPE_MASK) >> MCTP_MSG_TYPE_SHIFT;
+	if (msg_type != MCTP_MSG_TYPE_PLDM) {
+		return MCTP_ERROR;
+	}
+
+	mctp_pldm_cmd_handler(mctp_p, buf, len, ext_params);
+	return MCTP_SUCCESS;
+}
+
+static void make_gettid_req(pldm_msg *pmsg)
+{
+	memset(pmsg, 0, sizeof(*pmsg));
+	pmsg->ext_params.type = MCTP_MEDIUM_TYPE_LOOPBACK;
+	pmsg->ext_params.ep = MCTP_NULL_EID;
+	pmsg->hdr.msg_type = MCTP_MSG_TYPE_PLDM;
+	pmsg->hdr.pldm_type = PLDM_TYPE_BASE;
+	pmsg->hdr.cmd = PLDM_BASE_CMD_CODE_GETTID;
+	pmsg->hdr.rq = PLDM_REQUEST;
+	pmsg->timeout_ms = PLDM_LOOPBACK_BENCH_TIMEOUT_MS;
+}
+
+static void print_bench_result(const struct shell *shell, const char *name, uint32_t count,
+			       uint32_t fail_count, int64_t elapsed_ms)
+{
+	shell_print(shell, "%s: %u requests, %u failed, %lld ms, %u requests/s", name, count,
+		    fail_count, elapsed_ms,
+		    (uint32_t)(elapsed_ms ? ((count - fail_count) * 1000 / elapsed_ms) : 0));
+}
+
+/* Only one loopback bench can run at a time, the contexts are too big for the shell stack */
+static pldm_async_req bench_reqs[PLDM_ASYNC_MAX_INFLIGHT];
+static uint8_t bench_resp_buf[PLDM_ASYNC_MAX_INFLIGHT][8];
+
+void cmd_pldm_loopback_bench(const struct shell *shell, size_t argc, char **argv)
+{
+	if (argc > 3) {
+		shell_warn(shell, "Help: platform pldm loopback_bench [count] [depth]");
+		return;
+	}
+
+	uint32_t count = (argc > 1) ? strtoul(argv[1], NULL, 10) : PLDM_BENCH_DEFAULT_COUNT;
+	uint32_t depth = (argc > 2) ? strtoul(argv[2], NULL, 10) : PLDM_ASYNC_MAX_INFLIGHT;
+	if ((count == 0) || (depth == 0) || (depth > PLDM_ASYNC_MAX_INFLIGHT)) {
+		shell_error(shell, "Count should be more than 0, depth should be 1 ~ %d",
+			    PLDM_ASYNC_MAX_INFLIGHT);
+		return;
+	}
+
+	mctp *mctp_inst = mctp_init();
+	if (!mctp_inst) {
+		shell_error(shell, "Failed to init mctp instance");
+		return;
+	}
+
+	mctp_medium_conf conf;
+	memset(&conf, 0, sizeof(conf));
+	if ((mctp_set_medium_configure(mctp_inst, MCTP_MEDIUM_TYPE_LOOPBACK, conf) !=
+	     MCTP_SUCCESS) ||
+	    (mctp_reg_msg_rx_func(mctp_inst, loopback_msg_recv) != MCTP_SUCCESS) ||
+	    (mctp_start(mctp_inst) != MCTP_SUCCESS)) {
+		shell_error(shell, "Failed to start loopback mctp instance");
+		mctp_deinit(mctp_inst);
+		return;
+	}
+
+	pldm_msg pmsg;
+	uint8_t resp_buf[8];
+	uint32_t fail_count = 0;
+
+	/* stop-and-wait, one request on the wire at a time */
+	int64_t start_ms = k_uptime_get();
+	for (uint32_t i = 0; i < count; i++) {
+		make_gettid_req(&pmsg);
+		uint16_t resp_len = mctp_pldm_read(mctp_inst, &pmsg, resp_buf, sizeof(resp_buf));
+		if ((resp_len == 0) || (resp_buf[0] != PLDM_SUCCESS)) {
+			fail_count++;
+		}
+	}
+	print_bench_result(shell, "sync", count, fail_count, k_uptime_get() - start_ms);
+
+	/* pipelined, keep depth requests in flight and reuse each context once it completes */
+	bool in_flight[PLDM_ASYNC_MAX_INFLIGHT] = { 0 };
+	fail_count = 0;
+	start_ms = k_uptime_get();
+	for (uint32_t i = 0; i < (count + depth); i++) {
+		uint32_t slot = i % depth;
+		pldm_async_req *req = &bench_reqs[slot];
+
+		if (in_flight[slot]) {
+			/* always completes, the pldm timeout monitor reports lost responses */
+			if ((pldm_async_wait(req, K_FOREVER) != PLDM_ASYNC_DONE) ||
+			    (req->return_len == 0) || (bench_resp_buf[slot][0] != PLDM_SUCCESS)) {
+				fail_count++;
+			}
+			in_flight[slot] = false;
+		}
+
+		if (i >= count) {
+			continue;
+		}
+
+		memset(req, 0, sizeof(*req));
+		req->rbuf = bench_resp_buf[slot];
+		req->rbuf_len = sizeof(bench_resp_buf[slot]);
+		make_gettid_req(&pmsg);
+		if (mctp_pldm_send_async(mctp_inst, &pmsg, req, PLDM_LOOPBACK_BENCH_TIMEOUT_MS) !=
+		    PLDM_SUCCESS) {
+			fail_count++;
+			continue;
+		}
+		in_flight[slot] = true;
+	}
+	print_bench_result(shell, "pipelined", count, fail_count, k_uptime_get() - start_ms);
+	shell_print(shell, "depth %u, rx packets %u", depth, mctp_inst->rx_packet_count);
+
+	mctp_deinit(mctp_inst);
+}
+#else
+void cmd_pldm_loopback_bench(const struct shell *shell, size_t argc, char **argv)
+{
+	shell_warn(shell, "MCTP loopback medium is not enabled, define ENABLE_MCTP_LOOPBACK");
+}
+#endif
@@ -20,10 +20,19 @@
 #include <shell/shell.h>
 
 void cmd_pldm_send_req(const struct shell *shell, size_t argc, char **argv);
+void cmd_pldm_bench(const struct shell *shell, size_t argc, char **argv);
+void cmd_mctp_assembly_stat(const struct shell *shell, size_t argc, char **argv);
+void cmd_pldm_loopback_bench(const struct shell *shell, size_t argc, char **argv);
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_pldm_cmds,
 			       SHELL_CMD(sendreq, NULL, "Send out PLDM request.",
 					 cmd_pldm_send_req),
+			       SHELL_CMD(bench, NULL, "PLDM round trip benchmark.", cmd_pldm_bench),
+			       SHELL_CMD(loopback_bench, NULL,
+					 "PLDM sync vs pipelined throughput over MCTP loopback.",
+					 cmd_pldm_loopback_bench),
+			       SHELL_CMD(mctp_stat, NULL, "MCTP reassembly buffer statistics.",
+					 cmd_mctp_assembly_stat),
 			       SHELL_SUBCMD_SET_END);
 
 #endif
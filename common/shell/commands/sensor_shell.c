@@ -18,6 +18,8 @@
 #include "sensor.h"
 #include "libutil.h"
 #include "sensor_shell.h"
+#include "sensor_poll_sched.h"
+#include "sensor_poll_bus.h"
 #include <stdlib.h>
 #include <string.h>
 #include <logging/log.h>
@@ -633,3 +635,228 @@ void cmd_control_sensor_polling(const struct shell *shell, size_t argc, char **a
 		    ((operation == DISABLE_SENSOR_POLLING) ? "disable" : "enable"));
 	return;
 }
+
+void cmd_sensor_lookup_benchmark(const struct shell *shell, size_t argc, char **argv)
+{
+	if (shell == NULL) {
+		return;
+	}
+
+	if ((argc != 2) && (argc != 3)) {
+		shell_warn(shell,
+			   "Help: platform sensor lookup_benchmark <table_index> <loop(optional)>");
+		return;
+	}
+
+	uint8_t table_idx = strtol(argv[1], NULL, 16);
+	uint32_t loop = (argc == 3) ? strtol(argv[2], NULL, 10) : 100;
+
+	if ((table_idx >= sensor_monitor_count) ||
+	    (sensor_monitor_table[table_idx].monitor_sensor_cfg == NULL) ||
+	    (sensor_monitor_table[table_idx].cfg_count == 0) || (loop == 0)) {
+		shell_warn(shell, "[%s]: table idx: 0x%x is invalid or empty", __func__, table_idx);
+		return;
+	}
+
+	sensor_cfg *cfg_table = sensor_monitor_table[table_idx].monitor_sensor_cfg;
+	uint8_t cfg_count = sensor_monitor_table[table_idx].cfg_count;
+	uint32_t linear_cycles = 0, index_cycles = 0, start = 0;
+	uint32_t lookup_count = loop * cfg_count;
+	uint8_t mismatch_count = 0;
+
+	for (uint32_t i = 0; i < loop; ++i) {
+		start = k_cycle_get_32();
+		for (uint8_t sensor_idx = 0; sensor_idx < cfg_count; ++sensor_idx) {
+			find_sensor_cfg_via_sensor_num_linear(cfg_table, cfg_count,
+							      cfg_table[sensor_idx].num);
+		}
+		linear_cycles += k_cycle_get_32() - start;
+
+		start = k_cycle_get_32();
+		for (uint8_t sensor_idx = 0; sensor_idx < cfg_count; ++sensor_idx) {
+			find_sensor_cfg_via_sensor_num(cfg_table, cfg_count,
+						       cfg_table[sensor_idx].num);
+		}
+		index_cycles += k_cycle_get_32() - start;
+	}
+
+	for (uint8_t sensor_idx = 0; sensor_idx < cfg_count; ++sensor_idx) {
+		uint8_t sensor_num = cfg_table[sensor_idx].num;
+		if (find_sensor_cfg_via_sensor_num(cfg_table, cfg_count, sensor_num) !=
+		    find_sensor_cfg_via_sensor_num_linear(cfg_table, cfg_count, sensor_num)) {
+			mismatch_count++;
+		}
+	}
+
+	shell_print(shell, "Table idx: 0x%x | sensor count: %d | lookup count: %d", table_idx,
+		    cfg_count, lookup_count);
+	shell_print(shell, "linear search: %d cycles total, %d cycles per lookup", linear_cycles,
+		    linear_cycles / lookup_count);
+	shell_print(shell, "index lookup : %d cycles total, %d cycles per lookup", index_cycles,
+		    index_cycles / lookup_count);
+	shell_print(shell, "result mismatch: %d", mismatch_count);
+}
+
+void cmd_sensor_poll_sched_stat(const struct shell *shell, size_t argc, char **argv)
+{
+	if (shell == NULL) {
+		return;
+	}
+
+	if ((argc != 1) && (argc != 2)) {
+		shell_warn(shell, "Help: platform sensor poll_sched_stat <reset(optional)>");
+		return;
+	}
+
+	if (pal_get_sensor_poll_mode() != SENSOR_POLL_MODE_DEADLINE) {
+		shell_warn(shell, "Sensor poll deadline mode is not enabled on this platform");
+		return;
+	}
+
+	if (argc == 2) {
+		if (strcmp(argv[1], "reset") != 0) {
+			shell_warn(shell,
+				   "Help: platform sensor poll_sched_stat <reset(optional)>");
+			return;
+		}
+
+		sensor_poll_sched_reset_stat();
+		shell_print(shell, "Sensor poll scheduler statistics reset");
+		return;
+	}
+
+	uint16_t entry_count = sensor_poll_sched_get_entry_count();
+	uint32_t total_poll = 0, total_overrun = 0, max_jitter = 0;
+	sensor_poll_sched_stat stat;
+
+	shell_print(shell, "table | sensor | period(ms) |   polls | overruns | jitter avg/max(ms)");
+	for (uint16_t index = 0; index < entry_count; ++index) {
+		if (sensor_poll_sched_get_entry_stat(index, &stat) == false) {
+			continue;
+		}
+
+		uint32_t avg_jitter =
+			(stat.poll_count == 0) ? 0 : (stat.total_jitter_ms / stat.poll_count);
+		shell_print(shell, " 0x%-2x |  0x%-2x  | %10d | %7d | %8d | %d/%d",
+			    stat.table_index, stat.sensor_num, stat.period_ms, stat.poll_count,
+			    stat.overrun_count, avg_jitter, stat.max_jitter_ms);
+
+		total_poll += stat.poll_count;
+		total_overrun += stat.overrun_count;
+		max_jitter = MAX(max_jitter, stat.max_jitter_ms);
+	}
+
+	shell_print(shell, "Total sensors: %d | polls: %d | overruns: %d | max jitter: %d ms",
+		    entry_count, total_poll, total_overrun, max_jitter);
+}
+
+void cmd_sensor_poll_bus_stat(const struct shell *shell, size_t argc, char **argv)
+{
+	if (shell == NULL) {
+		return;
+	}
+
+#ifdef ENABLE_SENSOR_POLL_BUS_WORKER
+	if (pal_get_sensor_poll_mode() != SENSOR_POLL_MODE_PER_BUS) {
+		shell_warn(shell, "Sensor poll per-bus mode is not enabled on this platform");
+		return;
+	}
+
+	uint16_t group_count = sensor_poll_bus_get_group_count();
+	uint32_t last_sweep_ms = 0, max_sweep_ms = 0;
+	sensor_poll_bus_stat stat;
+
+	shell_print(shell, "group        | worker | sensors | sweeps | sweep last/max(ms)");
+	for (uint16_t index = 0; index < group_count; ++index) {
+		if (sensor_poll_bus_get_group_stat(index, &stat) == false) {
+			continue;
+		}
+
+		if (stat.group_key & SENSOR_POLL_BUS_TABLE_GROUP) {
+			shell_print(shell, "table   0x%-2x | %6d | %7d | %6d | %d/%d",
+				    stat.group_key & ~SENSOR_POLL_BUS_TABLE_GROUP,
+				    stat.worker_index, stat.sensor_count, stat.sweep_count,
+				    stat.last_sweep_ms, stat.max_sweep_ms);
+		} else if (stat.group_key == SENSOR_POLL_BUS_SHARED_GROUP) {
+			shell_print(shell, "shared       | %6d | %7d | %6d | %d/%d",
+				    stat.worker_index, stat.sensor_count, stat.sweep_count,
+				    stat.last_sweep_ms, stat.max_sweep_ms);
+		} else {
+			shell_print(shell, "port    0x%-2x | %6d | %7d | %6d | %d/%d",
+				    stat.group_key, stat.worker_index, stat.sensor_count,
+				    stat.sweep_count, stat.last_sweep_ms, stat.max_sweep_ms);
+		}
+	}
+
+	sensor_poll_bus_get_full_sweep_time(&last_sweep_ms, &max_sweep_ms);
+	shell_print(shell, "Full sweep last/max: %d/%d ms", last_sweep_ms, max_sweep_ms);
+#else
+	shell_warn(shell, "Sensor poll bus worker is not enabled on this platform");
+#endif
+}
+
+void cmd_sensor_pldm_reading_benchmark(const struct shell *shell, size_t argc, char **argv)
+{
+	if (shell == NULL) {
+		return;
+	}
+
+#ifdef ENABLE_PLDM_SENSOR
+	if ((argc != 1) && (argc != 2)) {
+		shell_warn(shell, "Help: platform sensor pldm_reading_benchmark <loop(optional)>");
+		return;
+	}
+
+	uint32_t loop = (argc == 2) ? strtol(argv[1], NULL, 10) : 100;
+	if (loop == 0) {
+		shell_warn(shell, "[%s]: loop count should not be 0", __func__);
+		return;
+	}
+
+	uint32_t encoded_cycles = 0, convert_cycles = 0, start = 0;
+	uint32_t sensor_count = 0, mismatch_count = 0;
+	uint8_t sensor_data_size = 0, sensor_operational_state = 0;
+	int reading = 0;
+
+	/* Same sensor ID range as the BMC GetSensorReading handler accepts */
+	for (uint16_t sensor_id = 0; sensor_id <= PLDM_MONITOR_SENSOR_SUPPORT_MAX; ++sensor_id) {
+		const pldm_sensor_info *info = pldm_sensor_find_via_sensor_id(sensor_id);
+		if ((info == NULL) || (info->pdr_numeric_sensor.resolution == 0)) {
+			continue;
+		}
+
+		sensor_count++;
+		for (uint32_t i = 0; i < loop; ++i) {
+			start = k_cycle_get_32();
+			pldm_sensor_get_encoded_reading(sensor_id, &reading, &sensor_data_size,
+							&sensor_operational_state);
+			encoded_cycles += k_cycle_get_32() - start;
+
+			start = k_cycle_get_32();
+			pldm_sensor_encode_reading(info, info->pldm_sensor_cfg.cache);
+			convert_cycles += k_cycle_get_32() - start;
+		}
+
+		pldm_sensor_get_encoded_reading(sensor_id, &reading, &sensor_data_size,
+						&sensor_operational_state);
+		if (reading != pldm_sensor_encode_reading(info, info->pldm_sensor_cfg.cache)) {
+			mismatch_count++;
+		}
+	}
+
+	if (sensor_count == 0) {
+		shell_warn(shell, "No PLDM sensor is loaded");
+		return;
+	}
+
+	uint32_t request_count = loop * sensor_count;
+	shell_print(shell, "sensor count: %d | request count: %d", sensor_count, request_count);
+	shell_print(shell, "pre-encoded reading: %d cycles total, %d cycles per request",
+		    encoded_cycles, encoded_cycles / request_count);
+	shell_print(shell, "convert on request : %d cycles total, %d cycles per request",
+		    convert_cycles, convert_cycles / request_count);
+	shell_print(shell, "result mismatch: %d", mismatch_count);
+#else
+	shell_warn(shell, "PLDM sensor is not enabled on this platform");
+#endif
+}
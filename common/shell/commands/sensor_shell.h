@@ -30,6 +30,10 @@ void cmd_sensor_cfg_list_all_sensor(const struct shell *shell, size_t argc, char
 void cmd_sensor_cfg_get_table_all_sensor(const struct shell *shell, size_t argc, char **argv);
 void cmd_sensor_cfg_get_table_single_sensor(const struct shell *shell, size_t argc, char **argv);
 void cmd_control_sensor_polling(const struct shell *shell, size_t argc, char **argv);
+void cmd_sensor_lookup_benchmark(const struct shell *shell, size_t argc, char **argv);
+void cmd_sensor_poll_sched_stat(const struct shell *shell, size_t argc, char **argv);
+void cmd_sensor_poll_bus_stat(const struct shell *shell, size_t argc, char **argv);
+void cmd_sensor_pldm_reading_benchmark(const struct shell *shell, size_t argc, char **argv);
 
 SHELL_STATIC_SUBCMD_SET_CREATE(
 	sub_sensor_cmds,
@@ -41,6 +45,14 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 		  cmd_sensor_cfg_get_table_single_sensor),
 	SHELL_CMD(control_sensor_polling, NULL, "Enable/Disable sensor polling",
 		  cmd_control_sensor_polling),
+	SHELL_CMD(lookup_benchmark, NULL, "Compare sensor config lookup cycles",
+		  cmd_sensor_lookup_benchmark),
+	SHELL_CMD(poll_sched_stat, NULL, "Show/Reset deadline poll scheduler statistics",
+		  cmd_sensor_poll_sched_stat),
+	SHELL_CMD(poll_bus_stat, NULL, "Show per-bus sensor poll sweep time",
+		  cmd_sensor_poll_bus_stat),
+	SHELL_CMD(pldm_reading_benchmark, NULL, "Show PLDM sensor reading cycles per request",
+		  cmd_sensor_pldm_reading_benchmark),
 	SHELL_SUBCMD_SET_END);
 
 #endif
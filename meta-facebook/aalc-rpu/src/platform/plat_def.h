@@ -34,4 +34,8 @@
 #define ENABLE_BMR4922302_803
 #define ENABLE_TMP421
 
+#define ENABLE_EEPROM_JOURNAL
+// error log records are coalesced briefly, shutdown_save_uptime_action() flushes the rest
+#define EEPROM_JOURNAL_FLUSH_DELAY_MS 20
+
 #endif
@@ -162,6 +162,9 @@ void aalc_leak_behavior(uint8_t sensor_num)
 
 void shutdown_save_uptime_action()
 {
+	// the error logs still pending in RAM go first, they matter more than the uptime
+	flush_eeprom_log();
+
 	// get total uptime
 	uint8_t pre_time[EEPROM_UPTIME_SIZE] = { 0 };
 	if (!plat_eeprom_read(EEPROM_UPTIME_OFFSET, pre_time, EEPROM_UPTIME_SIZE))
@@ -36,6 +36,9 @@ LOG_MODULE_REGISTER(plat_log);
 	(LOG_MAX_NUM * sizeof(modbus_err_log_mapping)) // 30 logs(1 log = 20 bytes)
 
 static modbus_err_log_mapping err_log_data[LOG_MAX_NUM];
+/* EEPROM copy of err_log_data, record updates are written back a page at a time */
+static uint8_t err_log_eeprom_image[AALC_FRU_LOG_SIZE];
+static EEPROM_JOURNAL err_log_journal;
 
 const err_sensor_mapping sensor_err_codes[] = {
 	{ LEAK_CHASSIS_0, SENSOR_NUM_IT_LEAK_0_GPIO },
@@ -146,13 +149,15 @@ void modbus_clear_log()
 {
 	memset(err_log_data, 0xFF, sizeof(err_log_data));
 
-	for (uint8_t i = 0; i < LOG_MAX_NUM; i++) {
-		if (!plat_eeprom_write(AALC_FRU_LOG_START + sizeof(modbus_err_log_mapping) * i,
-				       (uint8_t *)err_log_data, sizeof(modbus_err_log_mapping))) {
-			LOG_ERR("Clear EEPROM Log failed");
-		}
-		k_msleep(10); // the eeprom max write time is 10 ms
-	}
+	if (!eeprom_journal_write(&err_log_journal, 0, (uint8_t *)err_log_data,
+				  sizeof(err_log_data)))
+		LOG_ERR("Clear EEPROM Log failed");
+}
+
+void flush_eeprom_log(void)
+{
+	if (!eeprom_journal_flush(&err_log_journal))
+		LOG_ERR("Flush EEPROM Log failed");
 }
 
 uint32_t get_uptime_secs(void)
@@ -213,22 +218,26 @@ void error_log_event(uint8_t sensor_num, bool val_normal)
 	err_log_data[fru_count].volt =
 		get_sensor_reading_to_modbus_val(SENSOR_NUM_BPB_HSC_P48V_VIN_VOLT_V, -1, 1);
 
-	if (!plat_eeprom_write((AALC_FRU_LOG_START + fru_count * sizeof(modbus_err_log_mapping)),
-			       (uint8_t *)&err_log_data[fru_count], sizeof(modbus_err_log_mapping)))
+	if (!eeprom_journal_write(&err_log_journal, fru_count * sizeof(modbus_err_log_mapping),
+				  (uint8_t *)&err_log_data[fru_count],
+				  sizeof(modbus_err_log_mapping)))
 		LOG_ERR("Write Log failed with Error code: %02x", err_code);
-	else
-		k_msleep(5); // wait 5ms write eeprom
 }
 
 void init_load_eeprom_log(void)
 {
-	// read/write data length has to be less EEPROM_WRITE_SIZE(32)
 	memset(err_log_data, 0xFF, sizeof(err_log_data));
-	uint16_t log_len = sizeof(modbus_err_log_mapping);
-	for (uint8_t i = 0; i < LOG_MAX_NUM; i++) {
-		if (!plat_eeprom_read(AALC_FRU_LOG_START + i * log_len, (uint8_t *)&err_log_data[i],
-				      log_len)) {
-			LOG_ERR("READ Event %d failed from EEPROM", i + 1);
-		}
+	memset(err_log_eeprom_image, 0xFF, sizeof(err_log_eeprom_image));
+
+	uint8_t fru_index = 0;
+	if (!find_FRU_ID(MB_FRU_ID, &fru_index)) {
+		LOG_ERR("find_FRU_ID fail when load eeprom log");
+		return;
 	}
+
+	if (!eeprom_journal_init(&err_log_journal, &fru_config[fru_index], AALC_FRU_LOG_START,
+				 AALC_FRU_LOG_SIZE, err_log_eeprom_image))
+		LOG_ERR("READ Event failed from EEPROM");
+
+	memcpy(err_log_data, err_log_eeprom_image, sizeof(err_log_data));
 }
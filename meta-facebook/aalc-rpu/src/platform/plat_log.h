@@ -23,6 +23,7 @@ void log_transfer_to_modbus_data(uint16_t *modbus_data, uint8_t cmd_size, uint16
 void error_log_event(uint8_t sensor_num, bool val_normal);
 void init_load_eeprom_log(void);
 void modbus_clear_log();
+void flush_eeprom_log(void);
 
 typedef struct _modbus_err_log_mapping {
 	uint16_t index;
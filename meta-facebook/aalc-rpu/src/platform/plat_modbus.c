@@ -84,39 +84,49 @@ modbus_server modbus_server_config[] = {
 
 	actual_val =  raw_val * m * (10 ^ r)
 */
-uint8_t modbus_get_senser_reading(modbus_command_mapping *cmd)
+static uint8_t modbus_sensor_scaled_val(const modbus_command_mapping *cmd, uint16_t *data)
 {
-	CHECK_NULL_ARG_WITH_RETURN(cmd, MODBUS_EXC_ILLEGAL_DATA_VAL);
-
-	float val = 0;
-	uint8_t status = get_sensor_reading_to_real_val(cmd->arg0, &val);
+	int reading = 0;
+	uint8_t status = get_sensor_reading(sensor_config, sensor_config_count, cmd->arg0,
+					    &reading, GET_FROM_CACHE);
 
 	/* bic update workaround */
 	if (cmd->addr == MODBUS_BPB_RPU_COOLANT_FLOW_RATE_LPM_ADDR &&
 	    status == SENSOR_UNSPECIFIED_ERROR) {
-		cmd->data[0] = 0xFFFF; // error
+		*data = 0xFFFF; // error
 		return MODBUS_EXC_NONE;
 	}
 
-	if (status == SENSOR_READ_4BYTE_ACUR_SUCCESS) {
-		float r = pow_of_10(cmd->arg2);
-		int16_t byte_val = 0;
-		// capacity scale kW to W
-		if (cmd->addr == MODBUS_AALC_COOLING_CAPACITY_W_ADDR) {
-			int32_t scaled_val = (int32_t)(val * 1000 / cmd->arg1 / r);
-			byte_val = scaled_val & 0xFFFF;
-		} else if (cmd->addr == MODBUS_AALC_COOLING_CAPACITY_W_EXT_ADDR) {
-			int32_t scaled_val = (int32_t)(val * 1000 / cmd->arg1 / r);
-			byte_val = (scaled_val >> 16) & 0xFFFF;
-		} else {
-			byte_val = val / cmd->arg1 / r; // scale
-		}
+	if (status != SENSOR_READ_4BYTE_ACUR_SUCCESS || cmd->arg1 == 0)
+		return MODBUS_EXC_SERVER_DEVICE_FAILURE;
 
-		memcpy(cmd->data, &byte_val, sizeof(uint16_t) * cmd->cmd_size);
-		return MODBUS_EXC_NONE;
-	}
+	/* scale in integer from the 0.001 unit reading, raw_val = actual_val / m / (10 ^ r) */
+	const sensor_val *sval = (sensor_val *)&reading;
+	int64_t val = (int64_t)sval->integer * 1000 + sval->fraction;
+	int64_t div = 1000 * cmd->arg1;
+	for (int8_t r = (int8_t)cmd->arg2; r < 0; r++)
+		val *= 10;
+	for (int8_t r = (int8_t)cmd->arg2; r > 0; r--)
+		div *= 10;
+
+	// capacity scale kW to W
+	if (cmd->addr == MODBUS_AALC_COOLING_CAPACITY_W_ADDR ||
+	    cmd->addr == MODBUS_AALC_COOLING_CAPACITY_W_EXT_ADDR)
+		val *= 1000;
+
+	int32_t scaled_val = (int32_t)(val / div);
+	*data = (cmd->addr == MODBUS_AALC_COOLING_CAPACITY_W_EXT_ADDR) ?
+			(scaled_val >> 16) & 0xFFFF :
+			scaled_val & 0xFFFF;
 
-	return MODBUS_EXC_SERVER_DEVICE_FAILURE;
+	return MODBUS_EXC_NONE;
+}
+
+uint8_t modbus_get_senser_reading(modbus_command_mapping *cmd)
+{
+	CHECK_NULL_ARG_WITH_RETURN(cmd, MODBUS_EXC_ILLEGAL_DATA_VAL);
+
+	return modbus_sensor_scaled_val(cmd, cmd->data);
 }
 
 uint8_t modbus_read_fruid_data(modbus_command_mapping *cmd)
@@ -1654,8 +1664,80 @@ modbus_command_mapping modbus_command_table[] = {
 	{ MODBUS_DISABLE_ABR_ADDR, modbus_set_abr, NULL, 0, 0, 0, 1 },
 };
 
+/* modbus_command_table indexes sorted by addr, built by init_modbus_command_table() */
+static uint16_t modbus_cmd_sorted_idx[ARRAY_SIZE(modbus_command_table)];
+static bool is_modbus_cmd_index_ready = false;
+
+/*
+	scaled sensor register image, refreshed once per sensor polling pass
+	bit[15:0]: register value, bit[23:16]: modbus exception code
+*/
+static uint32_t modbus_sensor_image[ARRAY_SIZE(modbus_command_table)];
+static bool is_modbus_sensor_image_ready = false;
+
+#define MODBUS_SENSOR_IMAGE_ENTRY(exc, val) (((uint32_t)(exc) << 16) | (val))
+#define MODBUS_SENSOR_IMAGE_EXC(entry) (((entry) >> 16) & 0xFF)
+#define MODBUS_SENSOR_IMAGE_VAL(entry) ((entry)&0xFFFF)
+
+static void build_modbus_command_index(void)
+{
+	is_modbus_cmd_index_ready = false;
+
+	// insertion sort, the table is mostly in address order already
+	for (uint16_t i = 0; i < ARRAY_SIZE(modbus_command_table); i++) {
+		uint16_t j = i;
+		for (; j > 0; j--) {
+			uint16_t prev = modbus_cmd_sorted_idx[j - 1];
+			if (modbus_command_table[prev].addr <= modbus_command_table[i].addr)
+				break;
+			modbus_cmd_sorted_idx[j] = prev;
+		}
+		modbus_cmd_sorted_idx[j] = i;
+	}
+
+	for (uint16_t i = 1; i < ARRAY_SIZE(modbus_command_table); i++) {
+		const modbus_command_mapping *prev =
+			&modbus_command_table[modbus_cmd_sorted_idx[i - 1]];
+		const modbus_command_mapping *cur = &modbus_command_table[modbus_cmd_sorted_idx[i]];
+		if (prev->addr + prev->cmd_size > cur->addr) {
+			LOG_ERR("modbus command 0x%x overlaps 0x%x, use linear lookup", cur->addr,
+				prev->addr);
+			return;
+		}
+	}
+
+	is_modbus_cmd_index_ready = true;
+}
+
+/* position in modbus_cmd_sorted_idx of the command covering addr, -1 if not found */
+static int find_modbus_command_pos(uint16_t addr)
+{
+	int low = 0;
+	int high = ARRAY_SIZE(modbus_command_table) - 1;
+
+	while (low <= high) {
+		int mid = (low + high) / 2;
+		const modbus_command_mapping *cmd =
+			&modbus_command_table[modbus_cmd_sorted_idx[mid]];
+
+		if (addr < cmd->addr)
+			high = mid - 1;
+		else if (addr >= cmd->addr + cmd->cmd_size)
+			low = mid + 1;
+		else
+			return mid;
+	}
+
+	return -1;
+}
+
 modbus_command_mapping *ptr_to_modbus_table(uint16_t addr)
 {
+	if (is_modbus_cmd_index_ready) {
+		int pos = find_modbus_command_pos(addr);
+		return (pos < 0) ? NULL : &modbus_command_table[modbus_cmd_sorted_idx[pos]];
+	}
+
 	for (uint16_t i = 0; i < ARRAY_SIZE(modbus_command_table); i++) {
 		if ((addr >= modbus_command_table[i].addr) &&
 		    (addr < (modbus_command_table[i].addr + modbus_command_table[i].cmd_size)))
@@ -1665,6 +1747,42 @@ modbus_command_mapping *ptr_to_modbus_table(uint16_t addr)
 	return NULL;
 }
 
+/* called by the sensor poller after each pass, converts every sensor register once */
+void update_modbus_sensor_image(void)
+{
+	if (!is_modbus_cmd_index_ready)
+		return;
+
+	for (uint16_t i = 0; i < ARRAY_SIZE(modbus_command_table); i++) {
+		const modbus_command_mapping *cmd = &modbus_command_table[i];
+		if (cmd->rd_fn != modbus_get_senser_reading || cmd->cmd_size != 1)
+			continue;
+
+		uint16_t val = 0;
+		uint8_t exc = modbus_sensor_scaled_val(cmd, &val);
+		modbus_sensor_image[i] = MODBUS_SENSOR_IMAGE_ENTRY(exc, val);
+	}
+
+	is_modbus_sensor_image_ready = true;
+}
+
+/* serve a sensor register from the image, false if the command isn't covered by it */
+static bool read_modbus_sensor_image(const modbus_command_mapping *cmd, uint16_t *reg,
+				     int *exc)
+{
+	if (!is_modbus_sensor_image_ready || !get_sensor_poll_enable_flag())
+		return false;
+
+	if (cmd->rd_fn != modbus_get_senser_reading || cmd->cmd_size != 1)
+		return false;
+
+	uint32_t entry = modbus_sensor_image[cmd - modbus_command_table];
+	*exc = MODBUS_SENSOR_IMAGE_EXC(entry);
+	*reg = (*exc == MODBUS_EXC_NONE) ? MODBUS_SENSOR_IMAGE_VAL(entry) : 0;
+
+	return true;
+}
+
 static void free_modbus_command_table_memory(void)
 {
 	for (uint16_t i = 0; i < ARRAY_SIZE(modbus_command_table); i++)
@@ -1686,6 +1804,8 @@ void init_modbus_command_table(void)
 		}
 	}
 
+	build_modbus_command_index();
+
 	return;
 
 init_fail:
@@ -1797,12 +1917,35 @@ static int holding_reg_multi_rd(char *iface_name, uint16_t addr, uint16_t *reg,
 
 	uint16_t remaining_regs = num_regs;
 	uint16_t reg_offset = 0;
+	int pos = -1;
 
 	while (remaining_regs > 0) {
-		modbus_command_mapping *ptr = ptr_to_modbus_table(addr);
+		modbus_command_mapping *ptr = NULL;
 		uint16_t read_count = 1;
 
-		if (!ptr) {
+		/* consecutive registers are usually the next entry of the sorted index */
+		if (is_modbus_cmd_index_ready) {
+			if (pos >= 0 && pos + 1 < ARRAY_SIZE(modbus_command_table) &&
+			    modbus_command_table[modbus_cmd_sorted_idx[pos + 1]].addr == addr)
+				pos++;
+			else
+				pos = find_modbus_command_pos(addr);
+
+			if (pos >= 0)
+				ptr = &modbus_command_table[modbus_cmd_sorted_idx[pos]];
+		} else {
+			ptr = ptr_to_modbus_table(addr);
+		}
+
+		int image_ret = MODBUS_EXC_NONE;
+		if (ptr && read_modbus_sensor_image(ptr, &reg[reg_offset], &image_ret)) {
+			if (image_ret != MODBUS_EXC_NONE) {
+				LOG_ERR("modbus read function 0x%x failed, ret = %d!\n", addr,
+					image_ret);
+				memset(&reg[reg_offset], 0, sizeof(uint16_t) * read_count);
+				return image_ret;
+			}
+		} else if (!ptr) {
 			LOG_ERR("modbus read command 0x%x not found!\n", addr);
 			reg[reg_offset] = 0;
 		} else if (!ptr->rd_fn) {
@@ -422,5 +422,6 @@ enum read_fru_data_type {
 #define MODBUS_DISABLE_ABR_ADDR 0xDFFF
 
 modbus_command_mapping *ptr_to_modbus_table(uint16_t addr);
+void update_modbus_sensor_image(void);
 
 #endif
@@ -32,6 +32,7 @@
 #include "plat_status.h"
 #include "adm1272.h"
 #include "plat_class.h"
+#include "plat_modbus.h"
 
 #define THRESHOLD_POLL_STACK_SIZE 2048
 #define FAN_PUMP_PWRGD_STACK_SIZE 2048
@@ -1273,6 +1274,8 @@ void check_bpb_hsc_status(void)
 
 void plat_sensor_poll_post()
 {
+	update_modbus_sensor_image();
+
 	int64_t current_time = k_uptime_get();
 	// if current time less than 20s, do not poll threshold
 	if (current_time < 48000)
@@ -37,6 +37,7 @@
 #include "plat_pldm_sensor.h"
 #include "plat_class.h"
 #include "pmbus.h"
+#include "util_pmbus.h"
 #include "plat_i2c_target.h"
 #include "pldm_sensor.h"
 #include "bmr313.h"
@@ -546,6 +547,11 @@ bool pre_vr_read(sensor_cfg *cfg, void *args)
 		}
 	}
 
+	/* the read plan of the VR switches pages itself, once per page in a sweep */
+	if (pmbus_read_plan_is_sensor_planned(cfg)) {
+		return true;
+	}
+
 	/* set page */
 	msg.bus = cfg->port;
 	msg.target_addr = cfg->target_addr;
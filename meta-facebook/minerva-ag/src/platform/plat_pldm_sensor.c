@@ -30,6 +30,8 @@
 #include "emc1413.h"
 #include "plat_event.h"
 #include "hal_i2c.h"
+#include "util_pmbus.h"
+#include "mp2971.h"
 
 LOG_MODULE_REGISTER(plat_pldm_sensor);
 
@@ -9193,6 +9195,121 @@ uint32_t plat_get_pdr_size(uint8_t pdr_type)
 	return total_size;
 }
 
+/* Up to 4 readings and 2 configuration registers on each of the 2 VR pages */
+#define PLAT_VR_READ_PLAN_ITEM_MAX 12
+
+static pmbus_read_plan vr_read_plan[PMBUS_READ_PLAN_MAX];
+static pmbus_read_plan_item vr_read_plan_items[PMBUS_READ_PLAN_MAX][PLAT_VR_READ_PLAN_ITEM_MAX];
+static uint8_t vr_read_plan_count = 0;
+static bool is_vr_read_plan_init_done = false;
+K_MUTEX_DEFINE(vr_read_plan_mutex);
+
+static bool is_vr_read_plan_sensor(sensor_cfg *cfg)
+{
+	return ((cfg->pre_sensor_read_hook == pre_vr_read) && (cfg->pre_sensor_read_args != NULL) &&
+		((cfg->type == sensor_dev_mp2971) || (cfg->type == sensor_dev_isl69259)));
+}
+
+static pmbus_read_plan *get_vr_read_plan(sensor_cfg *cfg)
+{
+	vr_pre_proc_arg *pre_proc_args = (vr_pre_proc_arg *)cfg->pre_sensor_read_args;
+
+	for (uint8_t i = 0; i < vr_read_plan_count; i++) {
+		if ((vr_read_plan[i].bus == cfg->port) &&
+		    (vr_read_plan[i].addr == cfg->target_addr)) {
+			return &vr_read_plan[i];
+		}
+	}
+
+	if (vr_read_plan_count >= PMBUS_READ_PLAN_MAX) {
+		return NULL;
+	}
+
+	pmbus_read_plan *plan = &vr_read_plan[vr_read_plan_count];
+	memset(plan, 0, sizeof(pmbus_read_plan));
+	plan->bus = cfg->port;
+	plan->addr = cfg->target_addr;
+	plan->mutex = pre_proc_args->mutex;
+	/* Every other VR page user sets the page before its access */
+	plan->restore_page = false;
+	plan->items = vr_read_plan_items[vr_read_plan_count];
+	vr_read_plan_count++;
+
+	return plan;
+}
+
+static bool is_vr_read_plan_page_added(pmbus_read_plan *plan, uint8_t page)
+{
+	for (uint8_t i = 0; i < plan->item_count; i++) {
+		if (plan->items[i].page == page) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void vr_read_plan_add_sensor(sensor_cfg *cfg)
+{
+	uint8_t page = ((vr_pre_proc_arg *)cfg->pre_sensor_read_args)->vr_page;
+	pmbus_read_plan *plan = get_vr_read_plan(cfg);
+	if (plan == NULL) {
+		return;
+	}
+
+	if ((cfg->type == sensor_dev_mp2971) && !is_vr_read_plan_page_added(plan, page)) {
+		plan->item_count += mp2971_add_read_plan_items(
+			cfg, page, &plan->items[plan->item_count],
+			PLAT_VR_READ_PLAN_ITEM_MAX - plan->item_count - 1);
+		if (!is_vr_read_plan_page_added(plan, page)) {
+			/* No room for the resolution, keep the direct reads of this sensor */
+			return;
+		}
+	}
+
+	if (plan->item_count >= PLAT_VR_READ_PLAN_ITEM_MAX) {
+		return;
+	}
+
+	plan->items[plan->item_count++] = (pmbus_read_plan_item){
+		.sensor_num = cfg->num, .page = page, .command = cfg->offset, .len = 2
+	};
+}
+
+/* Build one read plan per MPS/RNS VR once the VR sensor tables have their final devices */
+static void plat_vr_read_plan_init()
+{
+	const uint8_t vr_thread_id[] = { VR_SENSOR_THREAD_ID, VR_SENSOR_P3V3_THREAD_ID,
+					 VR_SENSOR_P0V85_PVDD_THREAD_ID };
+	pldm_sensor_info *vr_table[] = { plat_pldm_sensor_vr_table, plat_pldm_sensor_vr_3v3_table,
+					 plat_pldm_sensor_vr_0v85_pvdd_table };
+
+	k_mutex_lock(&vr_read_plan_mutex, K_FOREVER);
+	if (is_vr_read_plan_init_done) {
+		k_mutex_unlock(&vr_read_plan_mutex);
+		return;
+	}
+
+	for (uint8_t i = 0; i < ARRAY_SIZE(vr_thread_id); i++) {
+		int count = plat_pldm_sensor_get_sensor_count(vr_thread_id[i]);
+		for (int index = 0; index < count; index++) {
+			sensor_cfg *cfg = &vr_table[i][index].pldm_sensor_cfg;
+			if (is_vr_read_plan_sensor(cfg)) {
+				vr_read_plan_add_sensor(cfg);
+			}
+		}
+	}
+
+	for (uint8_t i = 0; i < vr_read_plan_count; i++) {
+		if (pmbus_read_plan_register(&vr_read_plan[i]) != 0) {
+			LOG_ERR("Failed to register read plan of VR 0x%x", vr_read_plan[i].addr);
+		}
+	}
+
+	is_vr_read_plan_init_done = true;
+	k_mutex_unlock(&vr_read_plan_mutex);
+}
+
 pldm_sensor_thread *plat_pldm_sensor_load_thread()
 {
 	return pal_pldm_sensor_thread;
@@ -9210,16 +9327,19 @@ pldm_sensor_info *plat_pldm_sensor_load(int thread_id)
 		plat_pldm_sensor_change_vr_dev();
 		plat_pldm_sensor_change_vr_addr();
 		plat_pldm_sensor_change_vr_init_args();
+		plat_vr_read_plan_init();
 		return plat_pldm_sensor_vr_table;
 	case VR_SENSOR_P3V3_THREAD_ID:
 		plat_pldm_sensor_change_vr_dev();
 		plat_pldm_sensor_change_vr_addr();
 		plat_pldm_sensor_change_vr_init_args();
+		plat_vr_read_plan_init();
 		return plat_pldm_sensor_vr_3v3_table;
 	case VR_SENSOR_P0V85_PVDD_THREAD_ID:
 		plat_pldm_sensor_change_vr_dev();
 		plat_pldm_sensor_change_vr_addr();
 		plat_pldm_sensor_change_vr_init_args();
+		plat_vr_read_plan_init();
 		return plat_pldm_sensor_vr_0v85_pvdd_table;
 	case TEMP_SENSOR_THREAD_ID:
 		plat_pldm_sensor_change_temp_dev();
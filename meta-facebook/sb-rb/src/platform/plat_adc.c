@@ -39,6 +39,10 @@ LOG_MODULE_REGISTER(plat_adc);
 
 #define ADC_SPI_FREQ 6000000
 
+#define ADC_SAMPLE_PERIOD_US 1000
+#define ADC_VR_VOLT_REFRESH_SAMPLES 10
+#define ADC_SAMPLE_STAT_WINDOW_MS 1000
+
 K_THREAD_STACK_DEFINE(adc_rainbow_thread_stack, ADC_STACK_SIZE);
 struct k_thread adc_rainbow_poll_thread;
 static uint8_t is_adc_init = false;
@@ -58,6 +62,8 @@ static uint8_t adc_good_status[2] = { 0xFF, 0xFF };
 static uint8_t final_ucr_status = 0;
 static float inst_medha0 = 0;
 static float inst_medha1 = 0;
+static uint16_t vr_voltage_packed[ADC_RB_IDX_MAX];
+static float adc_amps_per_lsb = 0;
 
 typedef struct {
 	uint16_t avg_times; // 20ms at a time
@@ -68,7 +74,7 @@ typedef struct {
 	uint16_t ucr; // pwr
 	uint16_t vr_voltage_buf[ADC_AVERGE_TIMES_MAX]; //ex. 0.8523 will save as 0.85 and 0.0023
 	float pwr_avg_val;
-	float vr_sum;
+	uint32_t vr_sum_e4; // sum of vr_voltage_buf in 0.1 mV
 	bool ucr_status; // over current
 } adc_info_t;
 
@@ -81,6 +87,51 @@ adc_info_t adc_info[ADC_IDX_MAX] = { { .avg_times = 20, .ucr = 1600 },
 
 static const struct device *spi_dev;
 
+/* SPI setup and prepared sample transfer of one MEDHA ADC, bound once and reused */
+typedef struct {
+	const char *cs_gpio_name;
+	uint8_t cs_gpio_pin;
+	uint8_t cnv_pin;
+	struct spi_cs_control cs_ctrl;
+	struct spi_config spi_cfg;
+	uint8_t tx_buf[3];
+	uint8_t rx_buf[3];
+	struct spi_buf tx;
+	struct spi_buf rx;
+	struct spi_buf_set tx_set;
+	struct spi_buf_set rx_set;
+} adc_spi_channel_t;
+
+static adc_spi_channel_t adc_spi_channel[ADC_RB_IDX_MAX] = {
+	// SPI_ADC_CS0_N: GPIO73
+	[ADC_RB_IDX_MEDHA0] = { .cs_gpio_name = "GPIO_7", .cs_gpio_pin = 3, .cnv_pin = MEDHA0_CNV },
+	// SPI_ADC_CS1_N: GPIOC1
+	[ADC_RB_IDX_MEDHA1] = { .cs_gpio_name = "GPIO_C", .cs_gpio_pin = 1, .cnv_pin = MEDHA1_CNV },
+};
+
+typedef struct {
+	uint32_t last_cycle;
+	int64_t window_start_ms;
+	uint32_t count;
+	uint32_t period_min_us;
+	uint32_t period_max_us;
+	uint32_t jitter_max_us;
+	uint32_t busy_max_us;
+} adc_sample_window_t;
+
+static adc_sample_window_t adc_sample_window;
+static adc_sample_stat_t adc_sample_stat;
+static struct k_spinlock adc_sample_stat_lock;
+
+K_SEM_DEFINE(adc_sample_sem, 0, 1);
+
+static void adc_sample_timer_handler(struct k_timer *timer)
+{
+	k_sem_give(&adc_sample_sem);
+}
+
+K_TIMER_DEFINE(adc_sample_timer, adc_sample_timer_handler, NULL);
+
 uint8_t get_adc_good_status(uint8_t idx)
 {
 	return adc_good_status[idx];
@@ -97,7 +148,7 @@ void adc_poll_init()
 		adc_info[i].sum = 0;
 		adc_info[i].buf_idx = 0;
 		adc_info[i].avg_val = 0;
-		adc_info[i].vr_sum = 0;
+		adc_info[i].vr_sum_e4 = 0;
 		adc_info[i].pwr_avg_val = 0;
 		memset(adc_info[i].buf, 0, sizeof(uint16_t) * ADC_AVERGE_TIMES_MAX);
 		memset(adc_info[i].vr_voltage_buf, 0, sizeof(uint16_t) * ADC_AVERGE_TIMES_MAX);
@@ -235,42 +286,48 @@ float uint16_voltage_transfer_to_float(uint16_t temp_voltage_value)
 	return restored;
 }
 
-static void update_adc_info(uint16_t raw_data, uint8_t base_idx, float vref)
+/* packed voltage (see float_voltage_transfer_to_uint16) in 0.1 mV */
+static inline uint32_t packed_voltage_to_e4(uint16_t packed)
+{
+	return ((packed >> 8) & 0xFF) * 100 + (packed & 0xFF);
+}
+
+/*
+ * The VR voltage only changes at the sensor polling rate, refresh it from the sensor cache every
+ * ADC_VR_VOLT_REFRESH_SAMPLES ticks instead of for every averaging window on every sample.
+ */
+static void adc_refresh_vr_voltage(void)
+{
+	inst_medha0 = get_cached_sensor_reading_by_sensor_number(
+				SENSOR_NUM_ASIC_P0V85_MEDHA0_VDD_VOLT_V) /
+			1000.0;
+	inst_medha1 = get_cached_sensor_reading_by_sensor_number(
+				SENSOR_NUM_ASIC_P0V85_MEDHA1_VDD_VOLT_V) /
+			1000.0;
+	vr_voltage_packed[ADC_RB_IDX_MEDHA0] = float_voltage_transfer_to_uint16(inst_medha0);
+	vr_voltage_packed[ADC_RB_IDX_MEDHA1] = float_voltage_transfer_to_uint16(inst_medha1);
+}
+
+static void update_adc_info(uint16_t raw_data, uint8_t base_idx)
 {
+	uint16_t voltage_packed = vr_voltage_packed[base_idx];
+	uint32_t voltage_e4 = packed_voltage_to_e4(voltage_packed);
+
 	// LOG_DBG("base_idx: %d", base_idx);
 	for (uint8_t i = base_idx; i < ADC_IDX_MAX; i += 2) {
-		uint16_t m_sample_buffer[BUFFER_SIZE];
-		m_sample_buffer[0] = raw_data;
-		m_sample_buffer[1] = raw_data;
 		adc_info_t *adc = &adc_info[i];
 		// current averge
 		adc->sum -= adc->buf[adc->buf_idx];
-		adc->buf[adc->buf_idx] = ((i == ADC_IDX_MEDHA0_1) || (i == ADC_IDX_MEDHA0_2)) ?
-						 m_sample_buffer[1] :
-						 m_sample_buffer[0];
-		adc->sum += adc->buf[adc->buf_idx];
+		adc->buf[adc->buf_idx] = raw_data;
+		adc->sum += raw_data;
 		adc->avg_val = adc->sum / adc->avg_times;
 		// voltage averge
-		float temp_voltage_value = 0;
-		if (base_idx == ADC_RB_IDX_MEDHA0) {
-			temp_voltage_value = get_cached_sensor_reading_by_sensor_number(
-						     SENSOR_NUM_ASIC_P0V85_MEDHA0_VDD_VOLT_V) /
-					     1000.0;
-			inst_medha0 = temp_voltage_value;
-		} else if (base_idx == ADC_RB_IDX_MEDHA1) {
-			temp_voltage_value = get_cached_sensor_reading_by_sensor_number(
-						     SENSOR_NUM_ASIC_P0V85_MEDHA1_VDD_VOLT_V) /
-					     1000.0;
-			inst_medha1 = temp_voltage_value;
-		}
-		// transfer to uint16_t
-		uint16_t voltage_packed = float_voltage_transfer_to_uint16(temp_voltage_value);
-		adc->vr_sum -= uint16_voltage_transfer_to_float(adc->vr_voltage_buf[adc->buf_idx]);
+		adc->vr_sum_e4 -= packed_voltage_to_e4(adc->vr_voltage_buf[adc->buf_idx]);
 		adc->vr_voltage_buf[adc->buf_idx] = voltage_packed;
-		adc->vr_sum += uint16_voltage_transfer_to_float(adc->vr_voltage_buf[adc->buf_idx]);
+		adc->vr_sum_e4 += voltage_e4;
 		// average pwr = average voltage * average current
-		adc->pwr_avg_val =
-			(adc->vr_sum / adc->avg_times) * adc_raw_v_to_apms(adc->avg_val, vref);
+		adc->pwr_avg_val = ((float)adc->vr_sum_e4 / (adc->avg_times * 10000.0f)) *
+				   (adc->avg_val * adc_amps_per_lsb);
 
 		// decrease buffer idx
 		adc->buf_idx = (adc->buf_idx + 1) % adc->avg_times;
@@ -366,44 +423,50 @@ float get_adc_vr_pwr(uint8_t idx)
 
 float get_vr_vol_sum(uint8_t idx)
 {
-	return adc_info[idx].vr_sum;
+	return adc_info[idx].vr_sum_e4 / 10000.0f;
 }
-int ads7066_read_reg(uint8_t reg, uint8_t idx, uint8_t *out_data)
+static const struct spi_config *adc_spi_get_config(uint8_t idx)
 {
-	spi_dev = device_get_binding("SPIP");
+	if (idx >= ADC_RB_IDX_MAX) {
+		LOG_ERR("Invalid ADC index %d", idx);
+		return NULL;
+	}
+
 	if (!spi_dev) {
-		LOG_ERR("SPI device not find");
+		spi_dev = device_get_binding("SPIP");
+		if (!spi_dev) {
+			LOG_ERR("SPI device not find");
+			return NULL;
+		}
 	}
-	// Set GPIO73 as CS control pin SPI_ADC_CS0_N
-	struct spi_cs_control cs_ctrl = {
-		.gpio_dev = device_get_binding("GPIO_7"),
-		.gpio_pin = 3,
-		.gpio_dt_flags = GPIO_ACTIVE_LOW,
-		.delay = 0, // No delay
-	};
-	switch (idx) {
-	case ADC_RB_IDX_MEDHA0:
-		// do nothing
-		break;
-	case ADC_RB_IDX_MEDHA1:
-		// Set GPIO73 as CS control pin SPI_ADC_CS1_N
-		cs_ctrl.gpio_dev = device_get_binding("GPIO_C");
-		cs_ctrl.gpio_pin = 1;
-		cs_ctrl.gpio_dt_flags = GPIO_ACTIVE_LOW;
-		cs_ctrl.delay = 0; // No delay
-		break;
-	default:
-		LOG_ERR("Invalid ADC index %d", idx);
-		break;
+
+	adc_spi_channel_t *ch = &adc_spi_channel[idx];
+	if (!ch->cs_ctrl.gpio_dev) {
+		ch->cs_ctrl.gpio_dev = device_get_binding(ch->cs_gpio_name);
+		if (!ch->cs_ctrl.gpio_dev) {
+			LOG_ERR("CS gpio %s not find", ch->cs_gpio_name);
+			return NULL;
+		}
+		ch->cs_ctrl.gpio_pin = ch->cs_gpio_pin;
+		ch->cs_ctrl.gpio_dt_flags = GPIO_ACTIVE_LOW;
+		ch->cs_ctrl.delay = 0; // No delay
+
+		ch->spi_cfg.frequency = ADC_SPI_FREQ;
+		ch->spi_cfg.operation =
+			SPI_OP_MODE_MASTER | SPI_TRANSFER_MSB | SPI_WORD_SET(8) | SPI_LINES_SINGLE;
+		ch->spi_cfg.slave = 0;
+		ch->spi_cfg.cs = &ch->cs_ctrl;
 	}
 
-	const struct spi_config spi_cfg = {
-		.frequency = 6000000, // 6MHz
-		.operation =
-			SPI_OP_MODE_MASTER | SPI_TRANSFER_MSB | SPI_WORD_SET(8) | SPI_LINES_SINGLE,
-		.slave = 0,
-		.cs = &cs_ctrl,
-	};
+	return &ch->spi_cfg;
+}
+
+int ads7066_read_reg(uint8_t reg, uint8_t idx, uint8_t *out_data)
+{
+	const struct spi_config *spi_cfg = adc_spi_get_config(idx);
+	if (!spi_cfg) {
+		return -ENODEV;
+	}
 
 	uint8_t tx_buf[3] = { 0x10, reg, 0x00 }; // bit15=1: read
 	uint8_t rx_buf[3] = { 0 };
@@ -413,12 +476,12 @@ int ads7066_read_reg(uint8_t reg, uint8_t idx, uint8_t *out_data)
 	struct spi_buf_set tx_set = { .buffers = &tx, .count = 1 };
 	struct spi_buf_set rx_set = { .buffers = &rx, .count = 1 };
 
-	int ret = spi_write(spi_dev, &spi_cfg, &tx_set);
+	int ret = spi_write(spi_dev, spi_cfg, &tx_set);
 	if (ret < 0) {
 		LOG_ERR("SPI write failed: %d", ret);
 		return ret;
 	}
-	ret = spi_read(spi_dev, &spi_cfg, &rx_set);
+	ret = spi_read(spi_dev, spi_cfg, &rx_set);
 	if (ret < 0) {
 		LOG_ERR("SPI read failed: %d", ret);
 		return ret;
@@ -431,47 +494,17 @@ int ads7066_read_reg(uint8_t reg, uint8_t idx, uint8_t *out_data)
 }
 int ads7066_write_reg(uint8_t reg, uint8_t write_val, uint8_t idx)
 {
-	spi_dev = device_get_binding("SPIP");
-	if (!spi_dev) {
-		LOG_ERR("SPI device not find");
-	}
-	// Set GPIO73 as CS control pin SPI_ADC_CS0_N
-	struct spi_cs_control cs_ctrl = {
-		.gpio_dev = device_get_binding("GPIO_7"),
-		.gpio_pin = 3,
-		.gpio_dt_flags = GPIO_ACTIVE_LOW,
-		.delay = 0, // No delay
-	};
-	switch (idx) {
-	case ADC_RB_IDX_MEDHA0:
-		// do nothing
-		break;
-	case ADC_RB_IDX_MEDHA1:
-		// Set GPIO73 as CS control pin SPI_ADC_CS1_N
-		cs_ctrl.gpio_dev = device_get_binding("GPIO_C");
-		cs_ctrl.gpio_pin = 1;
-		cs_ctrl.gpio_dt_flags = GPIO_ACTIVE_LOW;
-		cs_ctrl.delay = 0; // No delay
-		break;
-	default:
-		LOG_ERR("Invalid ADC index %d", idx);
-		break;
+	const struct spi_config *spi_cfg = adc_spi_get_config(idx);
+	if (!spi_cfg) {
+		return -ENODEV;
 	}
 
-	const struct spi_config spi_cfg = {
-		.frequency = 6000000, // 6MHz
-		.operation =
-			SPI_OP_MODE_MASTER | SPI_TRANSFER_MSB | SPI_WORD_SET(8) | SPI_LINES_SINGLE,
-		.slave = 0,
-		.cs = &cs_ctrl,
-	};
-
 	uint8_t tx_buf[3] = { 0x08, reg, write_val };
 
 	struct spi_buf tx = { .buf = tx_buf, .len = sizeof(tx_buf) };
 	struct spi_buf_set tx_set = { .buffers = &tx, .count = 1 };
 
-	int ret = spi_write(spi_dev, &spi_cfg, &tx_set);
+	int ret = spi_write(spi_dev, spi_cfg, &tx_set);
 	if (ret < 0) {
 		LOG_ERR("SPI write failed: %d", ret);
 		return ret;
@@ -480,117 +513,13 @@ int ads7066_write_reg(uint8_t reg, uint8_t write_val, uint8_t idx)
 	return 0;
 }
 
-static void ads7066_read_voltage(uint8_t idx)
-{
-	spi_dev = device_get_binding("SPIP");
-	if (!spi_dev) {
-		LOG_ERR("SPI device not find");
-		return;
-	}
-	// Set GPIO73 as CS control pin SPI_ADC_CS0_N
-	struct spi_cs_control cs_ctrl = {
-		.gpio_dev = device_get_binding("GPIO_7"),
-		.gpio_pin = 3,
-		.gpio_dt_flags = GPIO_ACTIVE_LOW,
-		.delay = 0, // No delay
-	};
-	switch (idx) {
-	case ADC_RB_IDX_MEDHA0:
-		// do nothing
-		break;
-	case ADC_RB_IDX_MEDHA1:
-		// Set GPIOC1 as CS control pin SPI_ADC_CS1_N
-		cs_ctrl.gpio_dev = device_get_binding("GPIO_C");
-		cs_ctrl.gpio_pin = 1;
-		cs_ctrl.gpio_dt_flags = GPIO_ACTIVE_LOW;
-		cs_ctrl.delay = 0; // No delay
-		break;
-	default:
-		LOG_ERR("Invalid ADC index %d", idx);
-		break;
-	}
-
-	const struct spi_config spi_cfg = {
-		.frequency = 6000000, // 6MHz
-		.operation =
-			SPI_OP_MODE_MASTER | SPI_TRANSFER_MSB | SPI_WORD_SET(8) | SPI_LINES_SINGLE,
-		.slave = 0,
-		.cs = &cs_ctrl,
-	};
-
-	uint8_t tx_buf[3] = { 0x00, 0x00, 0x00 };
-	uint8_t rx_buf[3] = { 0 };
-	uint8_t out_buf[3] = { 0 };
-
-	struct spi_buf tx = { .buf = tx_buf, .len = sizeof(tx_buf) };
-	struct spi_buf rx = { .buf = rx_buf, .len = sizeof(rx_buf) };
-	struct spi_buf_set tx_set = { .buffers = &tx, .count = 1 };
-	struct spi_buf_set rx_set = { .buffers = &rx, .count = 1 };
-
-	memset(rx_buf, 0, 3);
-	int ret = spi_transceive(spi_dev, &spi_cfg, &tx_set, &rx_set);
-	if (ret < 0) {
-		LOG_ERR("SPI failed: %d", ret);
-		return;
-	}
-
-	memcpy(out_buf, rx_buf, 3);
-
-	LOG_HEXDUMP_DBG(out_buf, 3, "ads7066_read_voltage_value");
-	uint16_t raw_value = out_buf[0] << 8 | out_buf[1];
-	if (idx == ADC_RB_IDX_MEDHA0) {
-		ads7066_val_0 = ((float)raw_value / 65536) * ads7066_vref;
-		ads7066_raw_0 = raw_value;
-		update_adc_info(raw_value, ADC_RB_IDX_MEDHA0, ads7066_vref);
-	} else if (idx == ADC_RB_IDX_MEDHA1) {
-		ads7066_val_1 = ((float)raw_value / 65536) * ads7066_vref;
-		ads7066_raw_1 = raw_value;
-		update_adc_info(raw_value, ADC_RB_IDX_MEDHA1, ads7066_vref);
-	}
-
-	return;
-}
 int ad4058_read_reg(uint8_t reg, uint8_t idx, uint8_t *out_data)
 {
-	spi_dev = device_get_binding("SPIP");
-	if (!spi_dev) {
-		LOG_ERR("SPI device not find");
-	}
-
-	uint8_t cnv_pin = 0;
-	// Set GPIO73 as CS control pin SPI_ADC_CS0_N
-	struct spi_cs_control cs_ctrl = {
-		.gpio_dev = device_get_binding("GPIO_7"),
-		.gpio_pin = 3,
-		.gpio_dt_flags = GPIO_ACTIVE_LOW,
-		.delay = 0, // No delay
-	};
-	switch (idx) {
-	case ADC_RB_IDX_MEDHA0:
-		// do nothing
-		cnv_pin = MEDHA0_CNV;
-		break;
-	case ADC_RB_IDX_MEDHA1:
-		// Set GPIO73 as CS control pin SPI_ADC_CS1_N
-		cs_ctrl.gpio_dev = device_get_binding("GPIO_C");
-		cs_ctrl.gpio_pin = 1;
-		cs_ctrl.gpio_dt_flags = GPIO_ACTIVE_LOW;
-		cs_ctrl.delay = 0; // No delay
-		cnv_pin = MEDHA1_CNV;
-		break;
-	default:
-		LOG_ERR("Invalid ADC index %d", idx);
-		break;
+	const struct spi_config *spi_cfg = adc_spi_get_config(idx);
+	if (!spi_cfg) {
+		return -ENODEV;
 	}
 
-	const struct spi_config spi_cfg = {
-		.frequency = 6000000, // 6MHz
-		.operation =
-			SPI_OP_MODE_MASTER | SPI_TRANSFER_MSB | SPI_WORD_SET(8) | SPI_LINES_SINGLE,
-		.slave = 0,
-		.cs = &cs_ctrl,
-	};
-
 	uint8_t tx_buf[3] = { 0x80, 0x00, 0x00 };
 	uint8_t rx_buf[3] = { 0 };
 
@@ -601,7 +530,7 @@ int ad4058_read_reg(uint8_t reg, uint8_t idx, uint8_t *out_data)
 
 	tx_buf[0] += reg;
 
-	int ret = spi_transceive(spi_dev, &spi_cfg, &tx_set, &rx_set);
+	int ret = spi_transceive(spi_dev, spi_cfg, &tx_set, &rx_set);
 	if (ret < 0) {
 		LOG_ERR("SPI write failed: %d", ret);
 		return ret;
@@ -613,41 +542,11 @@ int ad4058_read_reg(uint8_t reg, uint8_t idx, uint8_t *out_data)
 }
 int ad4058_write_reg(uint8_t reg, uint8_t write_val, uint8_t idx)
 {
-	spi_dev = device_get_binding("SPIP");
-	if (!spi_dev) {
-		LOG_ERR("SPI device not find");
-	}
-	// Set GPIO73 as CS control pin SPI_ADC_CS0_N
-	struct spi_cs_control cs_ctrl = {
-		.gpio_dev = device_get_binding("GPIO_7"),
-		.gpio_pin = 3,
-		.gpio_dt_flags = GPIO_ACTIVE_LOW,
-		.delay = 0, // No delay
-	};
-	switch (idx) {
-	case ADC_RB_IDX_MEDHA0:
-		// do nothing
-		break;
-	case ADC_RB_IDX_MEDHA1:
-		// Set GPIO73 as CS control pin SPI_ADC_CS1_N
-		cs_ctrl.gpio_dev = device_get_binding("GPIO_C");
-		cs_ctrl.gpio_pin = 1;
-		cs_ctrl.gpio_dt_flags = GPIO_ACTIVE_LOW;
-		cs_ctrl.delay = 0; // No delay
-		break;
-	default:
-		LOG_ERR("Invalid ADC index %d", idx);
-		break;
+	const struct spi_config *spi_cfg = adc_spi_get_config(idx);
+	if (!spi_cfg) {
+		return -ENODEV;
 	}
 
-	const struct spi_config spi_cfg = {
-		.frequency = 6000000, // 6MHz
-		.operation =
-			SPI_OP_MODE_MASTER | SPI_TRANSFER_MSB | SPI_WORD_SET(8) | SPI_LINES_SINGLE,
-		.slave = 0,
-		.cs = &cs_ctrl,
-	};
-
 	uint8_t tx_buf[2] = { reg, write_val };
 	uint8_t rx_buf[2] = { 0 };
 
@@ -656,7 +555,7 @@ int ad4058_write_reg(uint8_t reg, uint8_t write_val, uint8_t idx)
 	struct spi_buf_set tx_set = { .buffers = &tx, .count = 1 };
 	struct spi_buf_set rx_set = { .buffers = &rx, .count = 1 };
 
-	int ret = spi_transceive(spi_dev, &spi_cfg, &tx_set, &rx_set);
+	int ret = spi_transceive(spi_dev, spi_cfg, &tx_set, &rx_set);
 	if (ret < 0) {
 		LOG_ERR("SPI write failed: %d", ret);
 		return ret;
@@ -666,91 +565,90 @@ int ad4058_write_reg(uint8_t reg, uint8_t write_val, uint8_t idx)
 	return 0;
 }
 
-static void ad4058_read_voltage(uint8_t idx)
-{
-	spi_dev = device_get_binding("SPIP");
-	if (!spi_dev) {
-		LOG_ERR("SPI device not find");
-	}
-
-	uint8_t cnv_pin = 0;
-	// Set GPIO73 as CS control pin SPI_ADC_CS0_N
-	struct spi_cs_control cs_ctrl = {
-		.gpio_dev = device_get_binding("GPIO_7"),
-		.gpio_pin = 3,
-		.gpio_dt_flags = GPIO_ACTIVE_LOW,
-		.delay = 0, // No delay
-	};
-	switch (idx) {
-	case ADC_RB_IDX_MEDHA0:
-		// do nothing
-		cnv_pin = MEDHA0_CNV;
-		break;
-	case ADC_RB_IDX_MEDHA1:
-		// Set GPIO73 as CS control pin SPI_ADC_CS1_N
-		cs_ctrl.gpio_dev = device_get_binding("GPIO_C");
-		cs_ctrl.gpio_pin = 1;
-		cs_ctrl.gpio_dt_flags = GPIO_ACTIVE_LOW;
-		cs_ctrl.delay = 0; // No delay
-		cnv_pin = MEDHA1_CNV;
-		break;
-	default:
-		LOG_ERR("Invalid ADC index %d", idx);
-		break;
+/*
+ * Build the conversion read of both channels once the ADC type is known, so the sampling tick
+ * only toggles CNV and runs one prepared transfer per channel.
+ */
+static void adc_sample_prepare(uint8_t adc_type)
+{
+	float vref = (adc_type == ADI_AD4058) ? ad4058_vref : ads7066_vref;
+
+	for (uint8_t i = 0; i < ADC_RB_IDX_MAX; i++) {
+		adc_spi_channel_t *ch = &adc_spi_channel[i];
+		adc_spi_get_config(i);
+
+		memset(ch->tx_buf, 0, sizeof(ch->tx_buf));
+		memset(ch->rx_buf, 0, sizeof(ch->rx_buf));
+		ch->tx.buf = ch->tx_buf;
+		ch->tx.len = (adc_type == ADI_AD4058) ? 2 : 3;
+		ch->rx.buf = ch->rx_buf;
+		ch->rx.len = sizeof(ch->rx_buf);
+		ch->tx_set.buffers = &ch->tx;
+		ch->tx_set.count = 1;
+		ch->rx_set.buffers = &ch->rx;
+		ch->rx_set.count = 1;
 	}
 
-	const struct spi_config spi_cfg = {
-		.frequency = 6000000, // 6MHz
-		.operation =
-			SPI_OP_MODE_MASTER | SPI_TRANSFER_MSB | SPI_WORD_SET(8) | SPI_LINES_SINGLE,
-		.slave = 0,
-		.cs = &cs_ctrl,
-	};
+	/* adc_raw_v_to_apms() is linear in the raw value, scale once instead of per sample */
+	adc_amps_per_lsb = adc_raw_v_to_apms(1, vref);
+}
 
-	uint8_t tx_buf[2] = { 0 };
-	uint8_t rx_buf[3] = { 0 };
-	uint8_t out_buf[3] = { 0 };
+static void adc_read_voltage(uint8_t idx)
+{
+	adc_spi_channel_t *ch = &adc_spi_channel[idx];
+	if (!spi_dev || !ch->cs_ctrl.gpio_dev) {
+		return;
+	}
 
-	struct spi_buf tx = { .buf = tx_buf, .len = 2 };
-	struct spi_buf rx = { .buf = rx_buf, .len = 3 };
-	struct spi_buf_set tx_set = { .buffers = &tx, .count = 1 };
-	struct spi_buf_set rx_set = { .buffers = &rx, .count = 1 };
 	// set cnv_pin to low
-	gpio_set(cnv_pin, 0);
+	if (adc_idx_read == ADI_AD4058)
+		gpio_set(ch->cnv_pin, 0);
+
+	int ret = spi_transceive(spi_dev, &ch->spi_cfg, &ch->tx_set, &ch->rx_set);
 
-	memset(rx_buf, 0, 3);
+	// set cnv_pin to high
+	if (adc_idx_read == ADI_AD4058)
+		gpio_set(ch->cnv_pin, 1);
 
-	int ret = spi_transceive(spi_dev, &spi_cfg, &tx_set, &rx_set);
 	if (ret < 0) {
 		LOG_ERR("SPI failed: %d", ret);
 		return;
 	}
 
-	memcpy(out_buf, rx_buf, 3);
-	/*
-	(Read_back 16 bits data / 0xFFFF ) * Vref 
-	example: 0b 62 83
-	get 0xb628
-	0xb628 / 0xffff = (0xb628 / 0xffff) * 3.3
-	*/
-	uint8_t high = (uint8_t)((out_buf[0] << 4) | (out_buf[1] >> 4));
-	uint8_t low = (uint8_t)(((out_buf[1] & 0x0F) << 4) | (out_buf[2] >> 4));
-
-	uint16_t raw_value = (uint16_t)((high << 8) | low);
-	if (idx == ADC_RB_IDX_MEDHA0) {
-		ad4058_val_0 = (float)raw_value / 65536 * ad4058_vref;
-		ad4058_raw_0 = raw_value;
-		update_adc_info(raw_value, ADC_RB_IDX_MEDHA0, ad4058_vref);
-	} else if (idx == ADC_RB_IDX_MEDHA1) {
-		ad4058_val_1 = (float)raw_value / 65536 * ad4058_vref;
-		ad4058_raw_1 = raw_value;
-		update_adc_info(raw_value, ADC_RB_IDX_MEDHA1, ad4058_vref);
-	}
+	uint8_t *out_buf = ch->rx_buf;
+	uint16_t raw_value = 0;
+	if (adc_idx_read == ADI_AD4058) {
+		/*
+		(Read_back 16 bits data / 0xFFFF ) * Vref 
+		example: 0b 62 83
+		get 0xb628
+		0xb628 / 0xffff = (0xb628 / 0xffff) * 3.3
+		*/
+		uint8_t high = (uint8_t)((out_buf[0] << 4) | (out_buf[1] >> 4));
+		uint8_t low = (uint8_t)(((out_buf[1] & 0x0F) << 4) | (out_buf[2] >> 4));
+		raw_value = (uint16_t)((high << 8) | low);
+
+		if (idx == ADC_RB_IDX_MEDHA0) {
+			ad4058_val_0 = (float)raw_value / 65536 * ad4058_vref;
+			ad4058_raw_0 = raw_value;
+		} else {
+			ad4058_val_1 = (float)raw_value / 65536 * ad4058_vref;
+			ad4058_raw_1 = raw_value;
+		}
+	} else {
+		LOG_HEXDUMP_DBG(out_buf, 3, "ads7066_read_voltage_value");
+		raw_value = out_buf[0] << 8 | out_buf[1];
 
-	// set cnv_pin to high
-	gpio_set(cnv_pin, 1);
+		if (idx == ADC_RB_IDX_MEDHA0) {
+			ads7066_val_0 = ((float)raw_value / 65536) * ads7066_vref;
+			ads7066_raw_0 = raw_value;
+		} else {
+			ads7066_val_1 = ((float)raw_value / 65536) * ads7066_vref;
+			ads7066_raw_1 = raw_value;
+		}
+	}
 
-	return;
+	update_adc_info(raw_value, idx);
 }
 
 void ads7066_mode_init()
@@ -803,14 +701,78 @@ void ad4058_mode_init()
 	LOG_INF("ad4058 mode init done");
 }
 
+static void adc_sample_stat_reset(void)
+{
+	memset(&adc_sample_window, 0, sizeof(adc_sample_window));
+	adc_sample_window.window_start_ms = k_uptime_get();
+	adc_sample_window.period_min_us = UINT32_MAX;
+}
+
+static void adc_sample_stat_update(uint32_t start_cycle, uint32_t end_cycle)
+{
+	adc_sample_window_t *win = &adc_sample_window;
+
+	if (win->last_cycle) {
+		uint32_t period_us = k_cyc_to_us_floor32(start_cycle - win->last_cycle);
+		win->period_min_us = MIN(win->period_min_us, period_us);
+		win->period_max_us = MAX(win->period_max_us, period_us);
+		uint32_t jitter_us = (period_us > ADC_SAMPLE_PERIOD_US) ?
+					     (period_us - ADC_SAMPLE_PERIOD_US) :
+					     (ADC_SAMPLE_PERIOD_US - period_us);
+		win->jitter_max_us = MAX(win->jitter_max_us, jitter_us);
+	}
+	win->last_cycle = start_cycle;
+	win->count++;
+
+	uint32_t busy_us = k_cyc_to_us_floor32(end_cycle - start_cycle);
+	win->busy_max_us = MAX(win->busy_max_us, busy_us);
+
+	int64_t elapsed_ms = k_uptime_get() - win->window_start_ms;
+	if (elapsed_ms < ADC_SAMPLE_STAT_WINDOW_MS) {
+		return;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&adc_sample_stat_lock);
+	adc_sample_stat.samples_per_sec = (uint32_t)((win->count * 1000LL) / elapsed_ms);
+	adc_sample_stat.period_min_us = (win->period_min_us == UINT32_MAX) ? 0 : win->period_min_us;
+	adc_sample_stat.period_max_us = win->period_max_us;
+	adc_sample_stat.jitter_us = win->jitter_max_us;
+	adc_sample_stat.busy_max_us = win->busy_max_us;
+	k_spin_unlock(&adc_sample_stat_lock, key);
+
+	win->window_start_ms += elapsed_ms;
+	win->count = 0;
+	win->period_min_us = UINT32_MAX;
+	win->period_max_us = 0;
+	win->jitter_max_us = 0;
+	win->busy_max_us = 0;
+}
+
+void get_adc_sample_stat(adc_sample_stat_t *stat)
+{
+	CHECK_NULL_ARG(stat);
+
+	k_spinlock_key_t key = k_spin_lock(&adc_sample_stat_lock);
+	*stat = adc_sample_stat;
+	k_spin_unlock(&adc_sample_stat_lock, key);
+}
+
 void adc_rainbow_polling_handler(void *p1, void *p2, void *p3)
 {
+	uint32_t sample_count = 0;
+
+	adc_sample_stat_reset();
 	while (1) {
+		/* paced by adc_sample_timer, one sample of each MEDHA per ADC_SAMPLE_PERIOD_US */
+		k_sem_take(&adc_sample_sem, K_FOREVER);
+
 		if (!is_mb_dc_on()) {
 			gpio_set(MEDHA0_CNV, 0);
 			gpio_set(MEDHA1_CNV, 0);
 			gpio_set(SPI_ADC_CS1_N, 0);
 			k_msleep(1000);
+			k_sem_reset(&adc_sample_sem);
+			adc_sample_stat_reset();
 			continue;
 		}
 
@@ -824,31 +786,32 @@ void adc_rainbow_polling_handler(void *p1, void *p2, void *p3)
 			else
 				LOG_ERR("Invalid ADC index %d", adc_idx_read);
 
+			adc_sample_prepare(adc_idx_read);
+			adc_refresh_vr_voltage();
 			is_adc_init = true;
+			k_sem_reset(&adc_sample_sem);
+			adc_sample_stat_reset();
+			continue;
 		}
 
+		uint32_t start_cycle = k_cycle_get_32();
+
 		if (get_power_capping_source() == CAPPING_SOURCE_ADC) {
-			if (adc_poll_flag) {
-				switch (adc_idx_read) {
-				case ADI_AD4058:
-					ad4058_read_voltage(ADC_RB_IDX_MEDHA0);
-					ad4058_read_voltage(ADC_RB_IDX_MEDHA1);
-					break;
-				case TIC_ADS7066:
-					ads7066_read_voltage(ADC_RB_IDX_MEDHA0);
-					ads7066_read_voltage(ADC_RB_IDX_MEDHA1);
-					break;
-				default:
-					// LOG_DBG("Invalid ADC index %d", adc_idx_read);
-					break;
+			if (adc_poll_flag &&
+			    (adc_idx_read == ADI_AD4058 || adc_idx_read == TIC_ADS7066)) {
+				if (++sample_count >= ADC_VR_VOLT_REFRESH_SAMPLES) {
+					sample_count = 0;
+					adc_refresh_vr_voltage();
 				}
+				adc_read_voltage(ADC_RB_IDX_MEDHA0);
+				adc_read_voltage(ADC_RB_IDX_MEDHA1);
 			}
 		} else if (get_power_capping_source() == CAPPING_SOURCE_VR) {
 			update_vr_base_power_info();
 		}
 
 		plat_power_capping_give_sem();
-		k_msleep(0);
+		adc_sample_stat_update(start_cycle, k_cycle_get_32());
 	}
 }
 
@@ -860,6 +823,9 @@ void plat_adc_rainbow_init(void)
 
 	k_thread_name_set(&adc_rainbow_poll_thread, "platform adc(rainbow) read");
 
+	k_timer_start(&adc_sample_timer, K_USEC(ADC_SAMPLE_PERIOD_US),
+		      K_USEC(ADC_SAMPLE_PERIOD_US));
+
 	LOG_INF("ADC(rainbow) polling thread started...\n");
 }
 
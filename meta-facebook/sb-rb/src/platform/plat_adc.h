@@ -34,6 +34,15 @@ enum {
 #define ADI_AD4058 0x0
 #define TIC_ADS7066 0x1
 
+/* sampling loop statistics of the last completed one second window */
+typedef struct {
+	uint32_t samples_per_sec;
+	uint32_t period_min_us;
+	uint32_t period_max_us;
+	uint32_t jitter_us; // max deviation from the nominal sample period
+	uint32_t busy_max_us; // max time spent in one sample tick
+} adc_sample_stat_t;
+
 uint8_t get_adc_good_status(uint8_t idx);
 uint8_t get_final_ucr_status();
 void adc_poll_init();
@@ -64,3 +73,4 @@ int ad4058_write_reg(uint8_t reg, uint8_t write_val, uint8_t idx);
 uint16_t *get_vr_buf(uint16_t idx);
 void read_adc_info();
 void set_is_adc_init(uint8_t value);
+void get_adc_sample_stat(adc_sample_stat_t *stat);
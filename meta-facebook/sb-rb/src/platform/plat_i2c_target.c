@@ -41,6 +41,7 @@
 #include "plat_fru.h"
 #include "plat_power_capping.h"
 #include "plat_adc.h"
+#include "util_telemetry.h"
 
 LOG_MODULE_REGISTER(plat_i2c_target);
 
@@ -124,9 +125,10 @@ uint8_t get_vr_rail_by_control_vol_reg(uint8_t control_vol_reg)
 	return VR_RAIL_E_MAX;
 }
 plat_sensor_init_data *sensor_init_data_table[DATA_TABLE_LENGTH_2] = { NULL };
-plat_sensor_reading *sensor_reading_table[DATA_TABLE_LENGTH_4] = { NULL };
-plat_inventory_ids *inventory_ids_table[DATA_TABLE_LENGTH_1] = { NULL };
-plat_strap_capability *strap_capability_table[DATA_TABLE_LENGTH_1] = { NULL };
+/* tables read by the BMC while being refreshed, published as double-buffered snapshots */
+telemetry_table sensor_reading_table[DATA_TABLE_LENGTH_4];
+telemetry_table inventory_ids_table[DATA_TABLE_LENGTH_1];
+telemetry_table strap_capability_table[DATA_TABLE_LENGTH_1];
 plat_fru_data *fru_board_data_table[DATA_TABLE_LENGTH_13] = { NULL };
 plat_fru_data *fru_product_data_table[DATA_TABLE_LENGTH_7] = { NULL };
 plat_i2c_bridge_command_status *i2c_bridge_command_status_table[DATA_TABLE_LENGTH_1] = { NULL };
@@ -269,8 +271,12 @@ bool initialize_sensor_reading(telemetry_info *telemetry_info, uint8_t *buffer_s
 			  0;
 
 	size_t table_size = sizeof(plat_sensor_reading) + num_idx * sizeof(sensor_entry);
+	telemetry_table *table = &sensor_reading_table[table_index];
+	if (!telemetry_table_init(table, table_size))
+		return false;
+
 	plat_sensor_reading *sensor_data =
-		allocate_table((void **)&sensor_reading_table[table_index], table_size);
+		(plat_sensor_reading *)telemetry_table_write_begin(table);
 	if (!sensor_data)
 		return false;
 
@@ -284,9 +290,11 @@ bool initialize_sensor_reading(telemetry_info *telemetry_info, uint8_t *buffer_s
 			i; // sensor_index_offset range: 0~49
 		sensor_data->sensor_entries[i].sensor_value = 0x00000000;
 	}
+	LOG_HEXDUMP_DBG(sensor_data, table_size, "sensor_data");
+	telemetry_table_write_end(table);
+	telemetry_table_publish(table);
 
 	*buffer_size = (uint8_t)table_size;
-	LOG_HEXDUMP_DBG(sensor_data, table_size, "sensor_data");
 	return true;
 }
 
@@ -350,7 +358,8 @@ void update_sensor_reading_by_sensor_number(uint8_t sensor_number)
 	uint8_t sensor_index_offset = sensor_number - 1;
 	uint8_t table_index = sensor_index_offset / SENSOR_READING_PDR_INDEX_MAX;
 	uint8_t sensor_index = sensor_index_offset % SENSOR_READING_PDR_INDEX_MAX;
-	plat_sensor_reading *sensor_data = sensor_reading_table[table_index];
+	if (table_index >= DATA_TABLE_LENGTH_4)
+		return;
 
 	uint8_t status = SENSOR_UNAVAILABLE;
 	int reading = 0;
@@ -359,8 +368,16 @@ void update_sensor_reading_by_sensor_number(uint8_t sensor_number)
 	status = pldm_sensor_get_reading_from_cache(sensor_number, &reading,
 						    &sensor_operational_state);
 
+	/* visible to the BMC after the next publish in plat_pldm_sensor_poll_post() */
+	telemetry_table *table = &sensor_reading_table[table_index];
+	plat_sensor_reading *sensor_data =
+		(plat_sensor_reading *)telemetry_table_write_begin(table);
+	if (!sensor_data)
+		return;
+
 	sensor_data->sensor_entries[sensor_index].sensor_value =
 		(status == SENSOR_READ_SUCCESS) ? reading : 0xFFFFFFFF;
+	telemetry_table_write_end(table);
 }
 
 int get_cached_sensor_reading_by_sensor_number(uint8_t sensor_number)
@@ -368,8 +385,20 @@ int get_cached_sensor_reading_by_sensor_number(uint8_t sensor_number)
 	uint8_t sensor_index_offset = sensor_number - 1;
 	uint8_t table_index = sensor_index_offset / SENSOR_READING_PDR_INDEX_MAX;
 	uint8_t sensor_index = sensor_index_offset % SENSOR_READING_PDR_INDEX_MAX;
-	plat_sensor_reading *sensor_data = sensor_reading_table[table_index];
-	return sensor_data->sensor_entries[sensor_index].sensor_value;
+	if (table_index >= DATA_TABLE_LENGTH_4)
+		return 0;
+
+	/* reached from the I2C target callback, so only read the published snapshot */
+	uint32_t sensor_value = 0;
+	uint16_t offset = offsetof(plat_sensor_reading, sensor_entries) +
+			  sensor_index * sizeof(sensor_entry) +
+			  offsetof(sensor_entry, sensor_value);
+	if (telemetry_table_read(&sensor_reading_table[table_index], offset,
+				 (uint8_t *)&sensor_value, sizeof(sensor_value),
+				 NULL) != sizeof(sensor_value))
+		return 0;
+
+	return sensor_value;
 }
 
 bool initialize_inventory_ids(telemetry_info *telemetry_info, uint8_t *buffer_size)
@@ -381,9 +410,8 @@ bool initialize_inventory_ids(telemetry_info *telemetry_info, uint8_t *buffer_si
 		return false;
 
 	size_t table_size = sizeof(plat_inventory_ids);
-	plat_inventory_ids *sensor_data =
-		allocate_table((void **)&inventory_ids_table[table_index], table_size);
-	if (!sensor_data)
+	telemetry_table *table = &inventory_ids_table[table_index];
+	if (!telemetry_table_init(table, table_size))
 		return false;
 
 	uint8_t data[4] = { 0 };
@@ -398,9 +426,15 @@ bool initialize_inventory_ids(telemetry_info *telemetry_info, uint8_t *buffer_si
 	bic_version =
 		(BIC_FW_YEAR_MSB << 24) | (BIC_FW_YEAR_LSB << 16) | (BIC_FW_WEEK << 8) | BIC_FW_VER;
 
+	plat_inventory_ids *sensor_data = (plat_inventory_ids *)telemetry_table_write_begin(table);
+	if (!sensor_data)
+		return false;
+
 	sensor_data->carrier_board_id = board_id;
 	sensor_data->bic_fw_version = bic_version;
 	sensor_data->cpld_fw_version = cpld_version;
+	telemetry_table_write_end(table);
+	telemetry_table_publish(table);
 
 	*buffer_size = (uint8_t)table_size;
 	return true;
@@ -416,8 +450,12 @@ bool initialize_strap_capability(telemetry_info *telemetry_info, uint8_t *buffer
 	int num_idx = get_strap_index_max();
 
 	size_t table_size = sizeof(plat_strap_capability) + num_idx * sizeof(strap_entry);
+	telemetry_table *table = &strap_capability_table[table_index];
+	if (!telemetry_table_init(table, table_size))
+		return false;
+
 	plat_strap_capability *sensor_data =
-		allocate_table((void **)&strap_capability_table[table_index], table_size);
+		(plat_strap_capability *)telemetry_table_write_begin(table);
 	if (!sensor_data)
 		return false;
 
@@ -436,17 +474,20 @@ bool initialize_strap_capability(telemetry_info *telemetry_info, uint8_t *buffer
 		}
 		sensor_data->strap_set_format[i].strap_set_value = drive_level;
 	}
+	telemetry_table_write_end(table);
+	telemetry_table_publish(table);
 
 	*buffer_size = (uint8_t)table_size;
 	return true;
 }
 void update_strap_capability_table()
 {
-	if (!strap_capability_table[0])
+	telemetry_table *table = &strap_capability_table[0];
+	plat_strap_capability *sensor_data =
+		(plat_strap_capability *)telemetry_table_write_begin(table);
+	if (!sensor_data)
 		return;
 
-	plat_strap_capability *sensor_data = strap_capability_table[0];
-
 	for (int i = 0; i < get_strap_index_max(); i++) {
 		int drive_level = 0;
 		if (!get_bootstrap_change_drive_level(i, &drive_level)) {
@@ -459,10 +500,16 @@ void update_strap_capability_table()
 		}
 		sensor_data->strap_set_format[i].strap_set_value = drive_level;
 	}
+	telemetry_table_write_end(table);
+	telemetry_table_publish(table);
 }
 void plat_pldm_sensor_poll_post()
 {
 	update_strap_capability_table();
+
+	/* publish the readings of this polling pass as one snapshot per register */
+	for (int i = 0; i < DATA_TABLE_LENGTH_4; i++)
+		telemetry_table_publish(&sensor_reading_table[i]);
 }
 void set_sensor_polling_handler(struct k_work *work_item)
 {
@@ -723,6 +770,9 @@ telemetry_info telemetry_info_table[] = {
 	{ VR_POWER_READING_REG },
 };
 
+/* telemetry_info_table index + 1 of each register offset, 0 if the offset has no entry */
+static uint8_t telemetry_reg_index[UINT8_MAX + 1];
+
 static bool command_reply_data_handle(void *arg)
 {
 	struct i2c_target_data *data = (struct i2c_target_data *)arg;
@@ -730,11 +780,9 @@ static bool command_reply_data_handle(void *arg)
 		if (data->wr_buffer_idx == 1) {
 			uint8_t reg_offset = data->target_wr_msg.msg[0];
 			size_t struct_size = 0;
-			for (int i = 0; i < ARRAY_SIZE(telemetry_info_table); i++) {
-				if (telemetry_info_table[i].telemetry_offset == reg_offset) {
-					struct_size = telemetry_info_table[i].data_size;
-					break;
-				}
+			uint8_t info_index = telemetry_reg_index[reg_offset];
+			if (info_index) {
+				struct_size = telemetry_info_table[info_index - 1].data_size;
 			}
 			// Make sure the target buffer is not exceeded when reading
 			if (struct_size > sizeof(data->target_rd_msg.msg)) {
@@ -755,26 +803,24 @@ static bool command_reply_data_handle(void *arg)
 			case SENSOR_READING_1_REG:
 			case SENSOR_READING_2_REG:
 			case SENSOR_READING_3_REG: {
-				data->target_rd_msg.msg_length = struct_size;
-				memcpy(data->target_rd_msg.msg,
-				       sensor_reading_table[reg_offset - SENSOR_READING_0_REG],
-				       struct_size);
+				data->target_rd_msg.msg_length = telemetry_table_read(
+					&sensor_reading_table[reg_offset - SENSOR_READING_0_REG], 0,
+					data->target_rd_msg.msg, struct_size, NULL);
 				LOG_HEXDUMP_DBG(data->target_rd_msg.msg,
 						data->target_rd_msg.msg_length, "sensor reading");
 			} break;
 			case INVENTORY_IDS_REG: {
-				data->target_rd_msg.msg_length = struct_size;
-				memcpy(data->target_rd_msg.msg,
-				       inventory_ids_table[reg_offset - INVENTORY_IDS_REG],
-				       struct_size);
+				data->target_rd_msg.msg_length = telemetry_table_read(
+					&inventory_ids_table[reg_offset - INVENTORY_IDS_REG], 0,
+					data->target_rd_msg.msg, struct_size, NULL);
 				LOG_HEXDUMP_DBG(data->target_rd_msg.msg,
 						data->target_rd_msg.msg_length, "inventory ids");
 			} break;
 			case STRAP_CAPABILTITY_REG: {
-				data->target_rd_msg.msg_length = struct_size;
-				memcpy(data->target_rd_msg.msg,
-				       strap_capability_table[reg_offset - STRAP_CAPABILTITY_REG],
-				       struct_size);
+				telemetry_table *table =
+					&strap_capability_table[reg_offset - STRAP_CAPABILTITY_REG];
+				data->target_rd_msg.msg_length = telemetry_table_read(
+					table, 0, data->target_rd_msg.msg, struct_size, NULL);
 				LOG_HEXDUMP_DBG(data->target_rd_msg.msg,
 						data->target_rd_msg.msg_length, "strap capability");
 			} break;
@@ -1372,6 +1418,10 @@ void plat_master_write_thread_init()
 void plat_telemetry_table_init(void)
 {
 	uint8_t buffer_size = 0;
+	for (int i = 0; i < ARRAY_SIZE(telemetry_info_table); i++) {
+		telemetry_reg_index[telemetry_info_table[i].telemetry_offset] = i + 1;
+	}
+
 	for (int i = 0; i < ARRAY_SIZE(telemetry_info_table); i++) {
 		if (telemetry_info_table[i].telemetry_table_init) {
 			bool success = telemetry_info_table[i].telemetry_table_init(
@@ -294,6 +294,17 @@ void cmd_adc_get_good_status(const struct shell *shell, size_t argc, char **argv
 		   get_adc_good_status(ADC_RB_IDX_MEDHA1));
 }
 
+void cmd_adc_get_sample_stat(const struct shell *shell, size_t argc, char **argv)
+{
+	adc_sample_stat_t stat = { 0 };
+	get_adc_sample_stat(&stat);
+
+	shell_info(shell, "samples/s: %d", stat.samples_per_sec);
+	shell_info(shell, "period min/max: %d/%d us", stat.period_min_us, stat.period_max_us);
+	shell_info(shell, "jitter: %d us", stat.jitter_us);
+	shell_info(shell, "busy max: %d us", stat.busy_max_us);
+}
+
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_adc_poll_cmds,
 			       SHELL_CMD(get, NULL, "adc polling get", cmd_adc_poll_get),
 			       SHELL_CMD(set, NULL, "adc polling set", cmd_adc_poll_set),
@@ -316,6 +327,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 	SHELL_CMD(buf_raw, NULL, "get adc buf raw data", cmd_adc_get_buf_raw),
 	SHELL_CMD(buf, NULL, "get adc buf", cmd_adc_get_buf),
 	SHELL_CMD(get_good_status, NULL, "get adc good status", cmd_adc_get_good_status),
+	SHELL_CMD(sample_stat, NULL, "get adc sampling rate and jitter", cmd_adc_get_sample_stat),
 	SHELL_CMD(ucr, &sub_adc_ucr_cmds, "adc ucr cmds", NULL), SHELL_SUBCMD_SET_END);
 
 /* Root of command test */
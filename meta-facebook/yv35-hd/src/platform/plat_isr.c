@@ -469,6 +469,7 @@ static void send_apml_alert(struct k_work *work)
 void ISR_APML_ALERT()
 {
 	uint8_t ras_status;
+	apml_alert_notify();
 	if (apml_read_byte(APML_BUS, SB_RMI_ADDR, SBRMI_RAS_STATUS, &ras_status)) {
 		LOG_ERR("Failed to read RAS status.");
 		return;
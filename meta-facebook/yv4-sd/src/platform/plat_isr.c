@@ -855,6 +855,7 @@ K_WORK_DELAYABLE_DEFINE(APML_ALERT_work, APML_ALERT_handler);
 void ISR_APML_ALERT()
 {
 	hw_event_register[11]++;
+	apml_alert_notify();
 	LOG_INF("APML_ALERT detected");
 	k_work_schedule_for_queue(&plat_work_q, &APML_ALERT_work, K_NO_WAIT);
 }